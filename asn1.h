@@ -49,6 +49,7 @@ extern "C" {
 #define asn1_der_decode_bitstring_last nettle_asn1_der_decode_bitstring_last
 #define asn1_der_get_uint32 nettle_asn1_der_get_uint32
 #define asn1_der_get_bignum nettle_asn1_der_get_bignum
+#define asn1_der_get_limbs nettle_asn1_der_get_limbs
 
 
 /* enum asn1_type keeps the class number and the constructive in bits
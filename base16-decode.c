@@ -112,18 +112,40 @@ base16_decode_update(struct base16_decode_ctx *ctx,
   size_t i;
 
   for (i = done = 0; i<src_length; i++)
-    switch(base16_decode_single(ctx, dst + done, src[i]))
-      {
-      case -1:
-	return 0;
-      case 1:
-	done++;
-	/* Fall through */
-      case 0:
-	break;
-      default:
-	abort();
-      }
+    {
+      if (!ctx->bits)
+	{
+	  /* Fast path, for pairs of hex digits. White space and
+	     errors are left to base16_decode_single. */
+	  for (; i + 2 <= src_length; i += 2, done++)
+	    {
+	      unsigned char c0 = src[i];
+	      unsigned char c1 = src[i+1];
+	      int hi, lo;
+	      if ((c0 | c1) >= 0x80)
+		break;
+	      hi = hex_decode_table[c0];
+	      lo = hex_decode_table[c1];
+	      if ((hi | lo) < 0)
+		break;
+	      dst[done] = (hi << 4) | lo;
+	    }
+	  if (i == src_length)
+	    break;
+	}
+      switch(base16_decode_single(ctx, dst + done, src[i]))
+	{
+	case -1:
+	  return 0;
+	case 1:
+	  done++;
+	  /* Fall through */
+	case 0:
+	  break;
+	default:
+	  abort();
+	}
+    }
   
   assert(done <= BASE16_DECODE_LENGTH(src_length));
 
@@ -37,6 +37,8 @@
 
 #include "base16.h"
 
+#include "macros.h"
+
 
 static const uint8_t
 hex_digits[16] = "0123456789abcdef";
@@ -52,14 +54,32 @@ base16_encode_single(char *dst,
   dst[1] = DIGIT(src);
 }
 
+/* Encodes four octets at a time. The nibbles are spread out to one
+   per octet of a 64-bit word, and converted to digits in parallel,
+   adding 'a' - '0' - 10 to the digits that are 10 or larger. */
+#define SPREAD_NIBBLES(x) do {						\
+    (x) = (((x) & 0xffff0000) << 16) | ((x) & 0xffff);			\
+    (x) = (((x) & 0x0000ff000000ff00ULL) << 8)				\
+      | ((x) & 0x000000ff000000ffULL);					\
+    (x) = (((x) & 0x00f000f000f000f0ULL) << 4)				\
+      | ((x) & 0x000f000f000f000fULL);					\
+  } while (0)
+
+#define ONES 0x0101010101010101ULL
+
 /* Always stores BASE16_ENCODE_LENGTH(length) digits in dst. */
 void
 base16_encode_update(char *dst,
 		     size_t length,
 		     const uint8_t *src)
 {
-  size_t i;
-  
-  for (i = 0; i<length; i++, dst += 2)
-    base16_encode_single(dst, src[i]);
+  for (; length >= 4; length -= 4, src += 4, dst += 8)
+    {
+      uint64_t x = READ_UINT32 (src);
+      SPREAD_NIBBLES (x);
+      x += '0' * ONES + ((((x + 6 * ONES) >> 4) & ONES) * ('a' - '0' - 10));
+      WRITE_UINT64 (dst, x);
+    }
+  for (; length > 0; length--, dst += 2)
+    base16_encode_single(dst, *src++);
 }
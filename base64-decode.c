@@ -124,22 +124,46 @@ base64_decode_update(struct base64_decode_ctx *ctx,
 		     size_t src_length,
 		     const char *src)
 {
+  const signed char *table = ctx->table;
   size_t done;
   size_t i;
 
   for (i = 0, done = 0; i<src_length; i++)
-    switch(base64_decode_single(ctx, dst + done, src[i]))
-      {
-      case -1:
-	return 0;
-      case 1:
-	done++;
-	/* Fall through */
-      case 0:
-	break;
-      default:
-	abort();
-      }
+    {
+      if (ctx->bits == 0 && !ctx->padding)
+	{
+	  /* Fast path, for groups of four alphabet characters at a
+	     group boundary. Anything else, including white space
+	     and padding, is left to base64_decode_single. */
+	  for (; i + 4 <= src_length; i += 4, done += 3)
+	    {
+	      int a = table[(uint8_t) src[i]];
+	      int b = table[(uint8_t) src[i+1]];
+	      int c = table[(uint8_t) src[i+2]];
+	      int d = table[(uint8_t) src[i+3]];
+	      if ((a | b | c | d) < 0)
+		break;
+
+	      dst[done] = (a << 2) | (b >> 4);
+	      dst[done+1] = (b << 4) | (c >> 2);
+	      dst[done+2] = (c << 6) | d;
+	    }
+	  if (i == src_length)
+	    break;
+	}
+      switch(base64_decode_single(ctx, dst + done, src[i]))
+	{
+	case -1:
+	  return 0;
+	case 1:
+	  done++;
+	  /* Fall through */
+	case 0:
+	  break;
+	default:
+	  abort();
+	}
+    }
   
   assert(done <= BASE64_DECODE_LENGTH(src_length));
 
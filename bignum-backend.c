@@ -0,0 +1,536 @@
+/* bignum-backend.c
+
+   Limb arithmetic backends for the public-key functions.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "bignum-backend.h"
+
+#include "ecc-internal.h"
+#include "gmp-glue.h"
+#include "hogweed-internal.h"
+
+#if NETTLE_USE_MINI_GMP
+/* Window size for the exponentiation, depending on the exponent
+   size. Using a single bit for small exponents such as the RSA
+   public exponent avoids a useless table setup. */
+#define POWM_WINDOW_SIZE(enb)				\
+  ((enb) > 768 ? 5 : (enb) > 160 ? 4 : (enb) > 24 ? 3 : 1)
+
+/* The basecase functions of mini-gmp form double-limb products out
+   of four half-limb products. When the compiler has a double-limb
+   type, the Montgomery backend uses its own basecase functions
+   instead, which are several times faster, and also free of
+   branches. */
+#if GMP_NUMB_BITS == 64 && defined(__SIZEOF_INT128__)
+typedef unsigned __int128 dlimb_t;
+#define HAVE_DLIMB 1
+#elif GMP_NUMB_BITS == 32
+typedef uint64_t dlimb_t;
+#define HAVE_DLIMB 1
+#else
+#define HAVE_DLIMB 0
+#endif
+
+#if HAVE_DLIMB
+static mp_limb_t
+montgomery_mul_1 (mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n,
+		  mp_limb_t v)
+{
+  mp_limb_t cy = 0;
+  mp_size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      dlimb_t t = (dlimb_t) ap[i] * v + cy;
+      rp[i] = (mp_limb_t) t;
+      cy = (mp_limb_t) (t >> GMP_NUMB_BITS);
+    }
+  return cy;
+}
+
+static mp_limb_t
+montgomery_addmul_1 (mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n,
+		     mp_limb_t v)
+{
+  mp_limb_t cy = 0;
+  mp_size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      dlimb_t t = (dlimb_t) ap[i] * v + rp[i] + cy;
+      rp[i] = (mp_limb_t) t;
+      cy = (mp_limb_t) (t >> GMP_NUMB_BITS);
+    }
+  return cy;
+}
+
+static void
+montgomery_mul (mp_limb_t *rp,
+		const mp_limb_t *ap, mp_size_t an,
+		const mp_limb_t *bp, mp_size_t bn)
+{
+  mp_size_t i;
+
+  assert (an >= bn && bn > 0);
+
+  rp[an] = montgomery_mul_1 (rp, ap, an, bp[0]);
+  for (i = 1; i < bn; i++)
+    rp[an + i] = montgomery_addmul_1 (rp + i, ap, an, bp[i]);
+}
+
+/* Computes the off-diagonal products once, doubles them, and adds
+   in the squares. */
+static void
+montgomery_sqr (mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n)
+{
+  mp_limb_t cy;
+  mp_size_t i;
+
+  rp[0] = 0;
+  rp[n] = montgomery_mul_1 (rp + 1, ap + 1, n - 1, ap[0]);
+  for (i = 1; i < n - 1; i++)
+    rp[n + i] = montgomery_addmul_1 (rp + 2*i + 1, ap + i + 1, n - i - 1,
+				     ap[i]);
+  rp[2*n - 1] = 0;
+
+  mpn_lshift (rp, rp, 2*n, 1);
+
+  for (i = 0, cy = 0; i < n; i++)
+    {
+      dlimb_t p = (dlimb_t) ap[i] * ap[i];
+      dlimb_t t = (dlimb_t) rp[2*i] + (mp_limb_t) p + cy;
+      rp[2*i] = (mp_limb_t) t;
+      t = (dlimb_t) rp[2*i + 1] + (mp_limb_t) (p >> GMP_NUMB_BITS)
+	+ (mp_limb_t) (t >> GMP_NUMB_BITS);
+      rp[2*i + 1] = (mp_limb_t) t;
+      cy = (mp_limb_t) (t >> GMP_NUMB_BITS);
+    }
+  assert (cy == 0);
+}
+/* Like cnd_add_n and cnd_sub_n, which with mini-gmp fall back to
+   addmul_1 and submul_1. */
+static mp_limb_t
+montgomery_cnd_add_n (mp_limb_t cnd, mp_limb_t *rp, const mp_limb_t *ap,
+		      mp_size_t n)
+{
+  mp_limb_t mask = - (mp_limb_t) (cnd != 0);
+  mp_limb_t cy = 0;
+  mp_size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      dlimb_t t = (dlimb_t) rp[i] + (ap[i] & mask) + cy;
+      rp[i] = (mp_limb_t) t;
+      cy = (mp_limb_t) (t >> GMP_NUMB_BITS);
+    }
+  return cy;
+}
+
+static mp_limb_t
+montgomery_cnd_sub_n (mp_limb_t cnd, mp_limb_t *rp, const mp_limb_t *ap,
+		      mp_size_t n)
+{
+  mp_limb_t mask = - (mp_limb_t) (cnd != 0);
+  mp_limb_t bw = 0;
+  mp_size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      dlimb_t t = (dlimb_t) rp[i] - (ap[i] & mask) - bw;
+      rp[i] = (mp_limb_t) t;
+      bw = (mp_limb_t) (t >> (2*GMP_NUMB_BITS - 1));
+    }
+  return bw;
+}
+#else /* !HAVE_DLIMB */
+static void
+bignum_mul (mp_limb_t *rp,
+	    const mp_limb_t *ap, mp_size_t an,
+	    const mp_limb_t *bp, mp_size_t bn)
+{
+  mpn_mul (rp, ap, an, bp, bn);
+}
+
+static void
+bignum_sqr (mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n)
+{
+  mpn_sqr (rp, ap, n);
+}
+
+#define montgomery_addmul_1 mpn_addmul_1
+#define montgomery_cnd_add_n cnd_add_n
+#define montgomery_cnd_sub_n cnd_sub_n
+#define montgomery_mul bignum_mul
+#define montgomery_sqr bignum_sqr
+#endif /* !HAVE_DLIMB */
+
+/* Computes -1/m0 mod B, for odd m0, by Newton iteration. The initial
+   value is correct to three bits, since m0^2 = 1 (mod 8). */
+static mp_limb_t
+montgomery_minv (mp_limb_t m0)
+{
+  mp_limb_t inv = m0;
+  unsigned bits;
+
+  assert (m0 & 1);
+  for (bits = 3; bits < GMP_NUMB_BITS; bits *= 2)
+    inv = 2*inv - inv*inv*m0;
+
+  return -inv;
+}
+
+/* The carry out of each addmul_1 is stored in the limb it just
+   cleared, and all of them are added in at the end, like GMP's
+   mpn_redc_1. The result is then less than 2m, and the final
+   subtraction is done unconditionally. Allows rp == up + n. */
+static void
+montgomery_redc (mp_limb_t *rp, mp_limb_t *up,
+		 const mp_limb_t *mp, mp_size_t n, mp_limb_t minv)
+{
+  mp_limb_t cy;
+  mp_size_t i;
+
+  for (i = 0; i < n; i++)
+    up[i] = montgomery_addmul_1 (up + i, mp, n, up[i] * minv);
+
+  cy = mpn_add_n (rp, up + n, up, n);
+  cy |= 1 - mpn_sub_n (up, rp, mp, n);
+  cnd_copy (cy, rp, up, n);
+}
+
+/* Computes {rp, n} = B^{2n} mod m, using 2n limbs of scratch at tp.
+   Starting from the largest power of two less than m, doubling gets
+   to 2^{n (GMP_NUMB_BITS + 1)} mod m. A Montgomery squaring maps
+   2^{n GMP_NUMB_BITS + c} to 2^{n GMP_NUMB_BITS + 2c}, so it takes
+   log2(GMP_NUMB_BITS) squarings to go from c = n to c = n
+   GMP_NUMB_BITS. This is much cheaper than 2 n GMP_NUMB_BITS
+   doublings. */
+static void
+montgomery_r2 (mp_limb_t *rp, const mp_limb_t *mp, mp_size_t n,
+	       mp_limb_t minv, mp_limb_t *tp)
+{
+  mp_bitcnt_t bits;
+  mp_bitcnt_t i;
+  mp_limb_t top;
+
+  for (bits = (n - 1) * GMP_NUMB_BITS, top = mp[n-1]; top > 0; top >>= 1)
+    bits++;
+
+  mpn_zero (rp, n);
+  rp[(bits - 1) / GMP_NUMB_BITS] = (mp_limb_t) 1 << ((bits - 1) % GMP_NUMB_BITS);
+
+  for (i = bits - 1; i < (mp_bitcnt_t) n * (GMP_NUMB_BITS + 1); i++)
+    {
+      mp_limb_t cy = mpn_lshift (rp, rp, n, 1);
+      cy |= 1 - mpn_sub_n (tp, rp, mp, n);
+      cnd_copy (cy, rp, tp, n);
+    }
+  for (i = 1; i < GMP_NUMB_BITS; i *= 2)
+    {
+      montgomery_sqr (tp, rp, n);
+      montgomery_redc (rp, tp, mp, n, minv);
+    }
+}
+
+/* Extracts the k bits of the exponent starting at bit position pos. */
+static unsigned
+getbits (const mp_limb_t *ep, mp_bitcnt_t pos, unsigned k)
+{
+  mp_size_t i = pos / GMP_NUMB_BITS;
+  unsigned shift = pos % GMP_NUMB_BITS;
+  mp_limb_t bits = ep[i] >> shift;
+
+  if (shift + k > GMP_NUMB_BITS)
+    bits |= ep[i+1] << (GMP_NUMB_BITS - shift);
+
+  return bits & ((1U << k) - 1);
+}
+
+static mp_size_t
+montgomery_sec_powm_itch (mp_size_t bn UNUSED, mp_bitcnt_t enb,
+			  mp_size_t n)
+{
+  /* Table of 2^k entries, one selected entry, and a product. */
+  return ((1 << POWM_WINDOW_SIZE (enb)) + 3) * n;
+}
+
+/* Fixed-window exponentiation, with the table entries b^i R mod m in
+   Montgomery representation, R = B^n. The windows are read at fixed
+   positions and the table entries selected with sec_tabselect, so
+   the memory access pattern depends on the sizes only. */
+static void
+montgomery_sec_powm (mp_limb_t *rp,
+		     const mp_limb_t *bp, mp_size_t bn,
+		     const mp_limb_t *ep, mp_bitcnt_t enb,
+		     const mp_limb_t *mp, mp_size_t n,
+		     mp_limb_t *scratch)
+{
+  unsigned k = POWM_WINDOW_SIZE (enb);
+  unsigned tn = 1U << k;
+  mp_limb_t *tab = scratch;
+  mp_limb_t *sp = scratch + tn * n;
+  mp_limb_t *tp = sp + n;
+  mp_limb_t minv;
+  unsigned i;
+
+  assert (mp[0] & 1);
+  assert (bn > 0 && bn <= n);
+  assert (enb > 0);
+
+  minv = montgomery_minv (mp[0]);
+  montgomery_r2 (sp, mp, n, minv, tp);
+
+  /* tab[0] = R, tab[1] = b R (mod m). */
+  mpn_copyi (tp, sp, n);
+  mpn_zero (tp + n, n);
+  montgomery_redc (tab, tp, mp, n, minv);
+
+  montgomery_mul (tp, sp, n, bp, bn);
+  if (bn < n)
+    mpn_zero (tp + n + bn, n - bn);
+  montgomery_redc (tab + n, tp, mp, n, minv);
+
+  for (i = 2; i < tn; i++)
+    {
+      montgomery_mul (tp, tab + (i-1) * n, n, tab + n, n);
+      montgomery_redc (tab + i * n, tp, mp, n, minv);
+    }
+
+  /* The leading window may be shorter, the rest are aligned at
+     multiples of k. */
+  i = enb % k;
+  if (i == 0)
+    i = k;
+  enb -= i;
+  sec_tabselect (rp, n, tab, tn, getbits (ep, enb, i));
+
+  while (enb > 0)
+    {
+      for (i = 0; i < k; i++)
+	{
+	  montgomery_sqr (tp, rp, n);
+	  montgomery_redc (rp, tp, mp, n, minv);
+	}
+      enb -= k;
+      sec_tabselect (sp, n, tab, tn, getbits (ep, enb, k));
+      montgomery_mul (tp, rp, n, sp, n);
+      montgomery_redc (rp, tp, mp, n, minv);
+    }
+
+  /* Convert back from Montgomery representation. */
+  mpn_copyi (tp, rp, n);
+  mpn_zero (tp + n, n);
+  montgomery_redc (rp, tp, mp, n, minv);
+}
+
+static void
+cnd_neg (int cnd, mp_limb_t *rp, const mp_limb_t *ap, mp_size_t n)
+{
+  mp_limb_t cy = (cnd != 0);
+  mp_limb_t mask = -cy;
+  mp_size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      mp_limb_t r = (ap[i] ^ mask) + cy;
+      cy = r < cy;
+      rp[i] = r;
+    }
+}
+
+static mp_size_t
+montgomery_sec_invert_itch (mp_size_t n)
+{
+  return 3*n;
+}
+
+/* The binary algorithm of ecc_mod_inv, see there for the details,
+   except that it runs for the given number of iterations and checks
+   the gcd at the end. */
+static int
+montgomery_sec_invert (mp_limb_t *vp, mp_limb_t *ap,
+		       const mp_limb_t *mp, mp_size_t n,
+		       mp_bitcnt_t bit_size, mp_limb_t *scratch)
+{
+#define bp scratch
+#define up (scratch + n)
+#define mp1h (scratch + 2*n)
+
+  mp_limb_t d;
+  mp_size_t i;
+
+  assert (mp[0] & 1);
+
+  up[0] = 1;
+  mpn_zero (up + 1, n - 1);
+  mpn_copyi (bp, mp, n);
+  mpn_zero (vp, n);
+
+  /* (m+1)/2 */
+  mpn_rshift (mp1h, mp, n, 1);
+  mpn_add_1 (mp1h, mp1h, n, 1);
+
+  while (bit_size-- > 0)
+    {
+      mp_limb_t odd, swap, cy;
+
+      odd = ap[0] & 1;
+
+      swap = montgomery_cnd_sub_n (odd, ap, bp, n);
+      montgomery_cnd_add_n (swap, bp, ap, n);
+      cnd_neg (swap, ap, ap, n);
+
+      cnd_swap (swap, up, vp, n);
+      cy = montgomery_cnd_sub_n (odd, up, vp, n);
+      cy -= montgomery_cnd_add_n (cy, up, mp, n);
+      assert (cy == 0);
+
+      cy = mpn_rshift (ap, ap, n, 1);
+      assert (cy == 0);
+      cy = mpn_rshift (up, up, n, 1);
+      cy = montgomery_cnd_add_n (cy, up, mp1h, n);
+      assert (cy == 0);
+    }
+
+  /* Now b = gcd(a, m). */
+  for (i = 1, d = bp[0] ^ 1; i < n; i++)
+    d |= bp[i];
+
+  return d == 0;
+
+#undef bp
+#undef up
+#undef mp1h
+}
+
+const struct bignum_backend _bignum_backend_montgomery =
+  {
+    "montgomery",
+    montgomery_sec_powm_itch,
+    montgomery_sec_powm,
+    montgomery_sec_invert_itch,
+    montgomery_sec_invert,
+  };
+
+#else /* !NETTLE_USE_MINI_GMP */
+const struct bignum_backend _bignum_backend_gmp =
+  {
+    "gmp",
+    mpn_sec_powm_itch,
+    mpn_sec_powm,
+    mpn_sec_invert_itch,
+    mpn_sec_invert,
+  };
+#endif /* !NETTLE_USE_MINI_GMP */
+
+/* Like mpz_powm_sec, using the backend. Like mpz_powm_sec, requires
+   e > 0 and an odd m > 1. */
+void
+_nettle_bignum_sec_powm (mpz_t r, const mpz_t b, const mpz_t e,
+			 const mpz_t m)
+{
+  const struct bignum_backend *backend = BIGNUM_BACKEND;
+  mp_size_t mn;
+  mp_bitcnt_t ebn;
+  mp_limb_t *bp;
+  TMP_GMP_DECL (scratch, mp_limb_t);
+
+  assert (mpz_sgn (e) > 0);
+  assert (mpz_odd_p (m) && mpz_cmp_ui (m, 1) > 0);
+
+  mn = mpz_size (m);
+  ebn = mpz_sizeinbase (e, 2);
+
+  TMP_GMP_ALLOC (scratch, 2*mn + backend->sec_powm_itch (mn, ebn, mn));
+  bp = scratch + mn;
+
+  if (mpz_sgn (b) < 0 || mpz_cmp (b, m) >= 0)
+    {
+      mpz_t t;
+      mpz_init (t);
+      mpz_fdiv_r (t, b, m);
+      mpz_limbs_copy (bp, t, mn);
+      mpz_clear (t);
+    }
+  else
+    mpz_limbs_copy (bp, b, mn);
+
+  backend->sec_powm (scratch, bp, mn, mpz_limbs_read (e), ebn,
+		     mpz_limbs_read (m), mn, scratch + 2*mn);
+  mpz_set_n (r, scratch, mn);
+
+  TMP_GMP_FREE (scratch);
+}
+
+/* Like mpz_invert, using the backend's side-channel silent
+   inversion for odd moduli. */
+int
+_nettle_bignum_sec_invert (mpz_t r, const mpz_t a, const mpz_t m)
+{
+  const struct bignum_backend *backend = BIGNUM_BACKEND;
+  mp_size_t mn;
+  mp_limb_t *ap;
+  int res;
+  TMP_GMP_DECL (scratch, mp_limb_t);
+
+  if (mpz_even_p (m) || mpz_cmp_ui (m, 1) <= 0)
+    return mpz_invert (r, a, m);
+
+  mn = mpz_size (m);
+
+  TMP_GMP_ALLOC (scratch, 2*mn + backend->sec_invert_itch (mn));
+  ap = scratch + mn;
+
+  if (mpz_sgn (a) < 0 || mpz_cmp (a, m) >= 0)
+    {
+      mpz_t t;
+      mpz_init (t);
+      mpz_fdiv_r (t, a, m);
+      mpz_limbs_copy (ap, t, mn);
+      mpz_clear (t);
+    }
+  else
+    mpz_limbs_copy (ap, a, mn);
+
+  res = backend->sec_invert (scratch, ap, mpz_limbs_read (m), mn,
+			     2 * mn * GMP_NUMB_BITS, scratch + 2*mn);
+  if (res)
+    mpz_set_n (r, scratch, mn);
+
+  TMP_GMP_FREE (scratch);
+  return res;
+}
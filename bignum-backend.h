@@ -0,0 +1,90 @@
+/* bignum-backend.h
+
+   Limb arithmetic backends for the public-key functions. Internal,
+   and selected when Nettle is built.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+ 
+#ifndef NETTLE_BIGNUM_BACKEND_H_INCLUDED
+#define NETTLE_BIGNUM_BACKEND_H_INCLUDED
+
+#include "bignum.h"
+
+/* Name mangling */
+#define _bignum_backend_montgomery _nettle_bignum_backend_montgomery
+#define _bignum_backend_gmp _nettle_bignum_backend_gmp
+
+/* Same interface as mpn_sec_powm: {rp, n} = {bp, bn}^{ep, enb bits}
+   mod {mp, n}, with an odd modulus, bn <= n and enb > 0. */
+typedef mp_size_t
+bignum_sec_powm_itch_func(mp_size_t bn, mp_bitcnt_t enb, mp_size_t n);
+typedef void
+bignum_sec_powm_func(mp_limb_t *rp,
+		     const mp_limb_t *bp, mp_size_t bn,
+		     const mp_limb_t *ep, mp_bitcnt_t enb,
+		     const mp_limb_t *mp, mp_size_t n,
+		     mp_limb_t *scratch);
+
+/* Same interface as mpn_sec_invert: {rp, n} = {ap, n}^{-1} mod {mp,
+   n}, with an odd modulus. The input {ap, n} is clobbered, and
+   bit_size must be at least the sum of the bit sizes of a and m.
+   Returns 1 on success, 0 if a is not invertible. */
+typedef mp_size_t
+bignum_sec_invert_itch_func(mp_size_t n);
+typedef int
+bignum_sec_invert_func(mp_limb_t *rp, mp_limb_t *ap,
+		       const mp_limb_t *mp, mp_size_t n,
+		       mp_bitcnt_t bit_size, mp_limb_t *scratch);
+
+struct bignum_backend
+{
+  const char *name;
+
+  bignum_sec_powm_itch_func *sec_powm_itch;
+  bignum_sec_powm_func *sec_powm;
+
+  bignum_sec_invert_itch_func *sec_invert_itch;
+  bignum_sec_invert_func *sec_invert;
+};
+
+/* The backend is fixed at build time, so that scratch sizes computed
+   with it always match the functions using the scratch. With GMP, its
+   side-channel silent functions are used. With mini-gmp, which has no
+   such functions, a portable backend doing fixed-window Montgomery
+   exponentiation and constant-time binary inversion. */
+#if NETTLE_USE_MINI_GMP
+extern const struct bignum_backend _bignum_backend_montgomery;
+#define BIGNUM_BACKEND (&_bignum_backend_montgomery)
+#else
+extern const struct bignum_backend _bignum_backend_gmp;
+#define BIGNUM_BACKEND (&_bignum_backend_gmp)
+#endif
+
+#endif /* NETTLE_BIGNUM_BACKEND_H_INCLUDED */
@@ -126,6 +126,15 @@ int
 nettle_asn1_der_get_bignum(struct asn1_der_iterator *iterator,
 			   mpz_t x, unsigned max_bits);
 
+/* Stores a non-negative integer in the limb array RP, of size RN,
+ * with no memory allocation. The number of limbs used, with the most
+ * significant one non-zero, is returned in *SIZE. Returns 1 on
+ * success, 0 for negative or too large numbers. */
+int
+nettle_asn1_der_get_limbs(struct asn1_der_iterator *iterator,
+			  mp_size_t *size, mp_limb_t *rp, mp_size_t rn,
+			  unsigned max_bits);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,50 @@
+/* blake2-internal.h
+
+   The BLAKE2 compression functions.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_BLAKE2_INTERNAL_H_INCLUDED
+#define NETTLE_BLAKE2_INTERNAL_H_INCLUDED
+
+#include "nettle-types.h"
+
+/* Compresses one block into STATE. T is the number of octets
+   compressed so far including this block, and F is all ones for the
+   final block, otherwise zero. */
+void
+_nettle_blake2b_compress(uint64_t *state, const uint8_t *block,
+			 uint64_t t_low, uint64_t t_high, uint64_t f);
+
+void
+_nettle_blake2s_compress(uint32_t *state, const uint8_t *block,
+			 uint64_t t, uint32_t f);
+
+#endif /* NETTLE_BLAKE2_INTERNAL_H_INCLUDED */
@@ -0,0 +1,149 @@
+/* blake2.h
+
+   The BLAKE2b and BLAKE2s hash functions, RFC 7693.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_BLAKE2_H_INCLUDED
+#define NETTLE_BLAKE2_H_INCLUDED
+
+#include "nettle-types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Name mangling */
+#define blake2b_init nettle_blake2b_init
+#define blake2b_init_key nettle_blake2b_init_key
+#define blake2b_update nettle_blake2b_update
+#define blake2b_digest nettle_blake2b_digest
+#define blake2b_512_init nettle_blake2b_512_init
+#define blake2s_init nettle_blake2s_init
+#define blake2s_init_key nettle_blake2s_init_key
+#define blake2s_update nettle_blake2s_update
+#define blake2s_digest nettle_blake2s_digest
+#define blake2s_256_init nettle_blake2s_256_init
+
+/* BLAKE2b, with 64-bit words. The digest size and the key size can be
+   anything up to the maxima below. */
+#define BLAKE2B_DIGEST_SIZE 64
+#define BLAKE2B_BLOCK_SIZE 128
+#define BLAKE2B_KEY_SIZE 64
+
+struct blake2b_ctx
+{
+  uint64_t state[8];
+  /* Number of octets compressed so far */
+  uint64_t count_low, count_high;
+  /* Parameters, remembered for the reset done by blake2b_digest. */
+  unsigned digest_size;
+  unsigned key_length;
+  uint8_t key[BLAKE2B_KEY_SIZE];
+  /* The final block must be compressed with a flag set, so a full
+     block is kept here until more input arrives. */
+  unsigned index;
+  uint8_t block[BLAKE2B_BLOCK_SIZE];
+};
+
+void
+blake2b_init(struct blake2b_ctx *ctx, unsigned digest_size);
+
+void
+blake2b_init_key(struct blake2b_ctx *ctx, unsigned digest_size,
+		 size_t key_length, const uint8_t *key);
+
+void
+blake2b_update(struct blake2b_ctx *ctx,
+	       size_t length, const uint8_t *data);
+
+/* Length must be at most the digest size set at initialization. */
+void
+blake2b_digest(struct blake2b_ctx *ctx,
+	       size_t length, uint8_t *digest);
+
+/* BLAKE2s, with 32-bit words. */
+#define BLAKE2S_DIGEST_SIZE 32
+#define BLAKE2S_BLOCK_SIZE 64
+#define BLAKE2S_KEY_SIZE 32
+
+struct blake2s_ctx
+{
+  uint32_t state[8];
+  uint64_t count;
+  unsigned digest_size;
+  unsigned key_length;
+  uint8_t key[BLAKE2S_KEY_SIZE];
+  unsigned index;
+  uint8_t block[BLAKE2S_BLOCK_SIZE];
+};
+
+void
+blake2s_init(struct blake2s_ctx *ctx, unsigned digest_size);
+
+void
+blake2s_init_key(struct blake2s_ctx *ctx, unsigned digest_size,
+		 size_t key_length, const uint8_t *key);
+
+void
+blake2s_update(struct blake2s_ctx *ctx,
+	       size_t length, const uint8_t *data);
+
+void
+blake2s_digest(struct blake2s_ctx *ctx,
+	       size_t length, uint8_t *digest);
+
+/* The unkeyed variants with the maximum digest size, as used for
+   nettle_blake2b_512 and nettle_blake2s_256. Note that truncating
+   their output is not the same as initializing with a smaller digest
+   size. */
+#define BLAKE2B_512_DIGEST_SIZE 64
+#define BLAKE2B_512_BLOCK_SIZE BLAKE2B_BLOCK_SIZE
+#define blake2b_512_ctx blake2b_ctx
+
+void
+blake2b_512_init(struct blake2b_512_ctx *ctx);
+#define blake2b_512_update nettle_blake2b_update
+#define blake2b_512_digest nettle_blake2b_digest
+
+#define BLAKE2S_256_DIGEST_SIZE 32
+#define BLAKE2S_256_BLOCK_SIZE BLAKE2S_BLOCK_SIZE
+#define blake2s_256_ctx blake2s_ctx
+
+void
+blake2s_256_init(struct blake2s_256_ctx *ctx);
+#define blake2s_256_update nettle_blake2s_update
+#define blake2s_256_digest nettle_blake2s_digest
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETTLE_BLAKE2_H_INCLUDED */
@@ -0,0 +1,157 @@
+/* blake2b.c
+
+   The BLAKE2b hash function, RFC 7693.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "blake2.h"
+#include "blake2-internal.h"
+
+#include "macros.h"
+
+static const uint64_t iv[8] =
+  {
+    0x6A09E667F3BCC908ULL, 0xBB67AE8584CAA73BULL,
+    0x3C6EF372FE94F82BULL, 0xA54FF53A5F1D36F1ULL,
+    0x510E527FADE682D1ULL, 0x9B05688C2B3E6C1FULL,
+    0x1F83D9ABFB41BD6BULL, 0x5BE0CD19137E2179ULL,
+  };
+
+static void
+blake2b_reset(struct blake2b_ctx *ctx)
+{
+  memcpy (ctx->state, iv, sizeof(iv));
+  /* The parameter block, with fanout and depth 1 and everything
+     else zero. */
+  ctx->state[0] ^= 0x01010000 ^ (ctx->key_length << 8) ^ ctx->digest_size;
+  ctx->count_low = ctx->count_high = 0;
+
+  /* A key is processed as a first block of its own. */
+  if (ctx->key_length > 0)
+    {
+      memcpy (ctx->block, ctx->key, ctx->key_length);
+      memset (ctx->block + ctx->key_length, 0,
+	      BLAKE2B_BLOCK_SIZE - ctx->key_length);
+      ctx->index = BLAKE2B_BLOCK_SIZE;
+    }
+  else
+    ctx->index = 0;
+}
+
+void
+blake2b_init_key(struct blake2b_ctx *ctx, unsigned digest_size,
+		 size_t key_length, const uint8_t *key)
+{
+  assert (digest_size > 0 && digest_size <= BLAKE2B_DIGEST_SIZE);
+  assert (key_length <= BLAKE2B_KEY_SIZE);
+
+  ctx->digest_size = digest_size;
+  ctx->key_length = key_length;
+  if (key_length > 0)
+    memcpy (ctx->key, key, key_length);
+
+  blake2b_reset (ctx);
+}
+
+void
+blake2b_init(struct blake2b_ctx *ctx, unsigned digest_size)
+{
+  blake2b_init_key (ctx, digest_size, 0, NULL);
+}
+
+void
+blake2b_512_init(struct blake2b_ctx *ctx)
+{
+  blake2b_init (ctx, BLAKE2B_DIGEST_SIZE);
+}
+
+#define COMPRESS(ctx, data, f) do {					\
+    (ctx)->count_low += BLAKE2B_BLOCK_SIZE;				\
+    (ctx)->count_high += ((ctx)->count_low < BLAKE2B_BLOCK_SIZE);	\
+    _nettle_blake2b_compress ((ctx)->state, (data),			\
+			      (ctx)->count_low, (ctx)->count_high, (f)); \
+  } while (0)
+
+void
+blake2b_update(struct blake2b_ctx *ctx,
+	       size_t length, const uint8_t *data)
+{
+  if (ctx->index > 0)
+    {
+      unsigned left = BLAKE2B_BLOCK_SIZE - ctx->index;
+      if (length <= left)
+	{
+	  memcpy (ctx->block + ctx->index, data, length);
+	  ctx->index += length;
+	  return;
+	}
+      memcpy (ctx->block + ctx->index, data, left);
+      data += left;
+      length -= left;
+      COMPRESS (ctx, ctx->block, 0);
+    }
+
+  /* Blocks are compressed only when more input follows them. */
+  for (; length > BLAKE2B_BLOCK_SIZE;
+       length -= BLAKE2B_BLOCK_SIZE, data += BLAKE2B_BLOCK_SIZE)
+    COMPRESS (ctx, data, 0);
+
+  memcpy (ctx->block, data, length);
+  ctx->index = length;
+}
+
+void
+blake2b_digest(struct blake2b_ctx *ctx,
+	       size_t length, uint8_t *digest)
+{
+  uint8_t buffer[BLAKE2B_DIGEST_SIZE];
+  unsigned i;
+
+  assert (length <= ctx->digest_size);
+
+  memset (ctx->block + ctx->index, 0, BLAKE2B_BLOCK_SIZE - ctx->index);
+  ctx->count_low += ctx->index;
+  ctx->count_high += (ctx->count_low < ctx->index);
+  _nettle_blake2b_compress (ctx->state, ctx->block,
+			    ctx->count_low, ctx->count_high, ~(uint64_t) 0);
+
+  for (i = 0; i < 8; i++)
+    LE_WRITE_UINT64 (buffer + 8*i, ctx->state[i]);
+  memcpy (digest, buffer, length);
+
+  blake2b_reset (ctx);
+}
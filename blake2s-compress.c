@@ -0,0 +1,106 @@
+/* blake2s-compress.c
+
+   The BLAKE2s compression function.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "blake2.h"
+#include "blake2-internal.h"
+
+#include "macros.h"
+
+static const uint8_t sigma[10][16] =
+  {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 },
+  };
+
+/* Same as the SHA256 initial values. */
+static const uint32_t iv[8] =
+  {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL,
+  };
+
+#define G(a, b, c, d, x, y) do {		\
+    a += b + x; d = ROTL32(16, d ^ a);		\
+    c += d; b = ROTL32(20, b ^ c);		\
+    a += b + y; d = ROTL32(24, d ^ a);		\
+    c += d; b = ROTL32(25, b ^ c);		\
+  } while (0)
+
+void
+_nettle_blake2s_compress(uint32_t *state, const uint8_t *block,
+			 uint64_t t, uint32_t f)
+{
+  uint32_t m[16];
+  uint32_t v[16];
+  unsigned i;
+
+  for (i = 0; i < 16; i++, block += 4)
+    m[i] = LE_READ_UINT32(block);
+
+  for (i = 0; i < 8; i++)
+    {
+      v[i] = state[i];
+      v[i+8] = iv[i];
+    }
+  v[12] ^= (uint32_t) t;
+  v[13] ^= (uint32_t) (t >> 32);
+  v[14] ^= f;
+
+  for (i = 0; i < 10; i++)
+    {
+      const uint8_t *s = sigma[i];
+      G(v[0], v[4], v[ 8], v[12], m[s[ 0]], m[s[ 1]]);
+      G(v[1], v[5], v[ 9], v[13], m[s[ 2]], m[s[ 3]]);
+      G(v[2], v[6], v[10], v[14], m[s[ 4]], m[s[ 5]]);
+      G(v[3], v[7], v[11], v[15], m[s[ 6]], m[s[ 7]]);
+      G(v[0], v[5], v[10], v[15], m[s[ 8]], m[s[ 9]]);
+      G(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+      G(v[2], v[7], v[ 8], v[13], m[s[12]], m[s[13]]);
+      G(v[3], v[4], v[ 9], v[14], m[s[14]], m[s[15]]);
+    }
+
+  for (i = 0; i < 8; i++)
+    state[i] ^= v[i] ^ v[i+8];
+}
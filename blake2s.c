@@ -0,0 +1,148 @@
+/* blake2s.c
+
+   The BLAKE2s hash function, RFC 7693.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "blake2.h"
+#include "blake2-internal.h"
+
+#include "macros.h"
+
+static const uint32_t iv[8] =
+  {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL,
+  };
+
+static void
+blake2s_reset(struct blake2s_ctx *ctx)
+{
+  memcpy (ctx->state, iv, sizeof(iv));
+  ctx->state[0] ^= 0x01010000 ^ (ctx->key_length << 8) ^ ctx->digest_size;
+  ctx->count = 0;
+
+  if (ctx->key_length > 0)
+    {
+      memcpy (ctx->block, ctx->key, ctx->key_length);
+      memset (ctx->block + ctx->key_length, 0,
+	      BLAKE2S_BLOCK_SIZE - ctx->key_length);
+      ctx->index = BLAKE2S_BLOCK_SIZE;
+    }
+  else
+    ctx->index = 0;
+}
+
+void
+blake2s_init_key(struct blake2s_ctx *ctx, unsigned digest_size,
+		 size_t key_length, const uint8_t *key)
+{
+  assert (digest_size > 0 && digest_size <= BLAKE2S_DIGEST_SIZE);
+  assert (key_length <= BLAKE2S_KEY_SIZE);
+
+  ctx->digest_size = digest_size;
+  ctx->key_length = key_length;
+  if (key_length > 0)
+    memcpy (ctx->key, key, key_length);
+
+  blake2s_reset (ctx);
+}
+
+void
+blake2s_init(struct blake2s_ctx *ctx, unsigned digest_size)
+{
+  blake2s_init_key (ctx, digest_size, 0, NULL);
+}
+
+void
+blake2s_256_init(struct blake2s_ctx *ctx)
+{
+  blake2s_init (ctx, BLAKE2S_DIGEST_SIZE);
+}
+
+#define COMPRESS(ctx, data, f) do {					\
+    (ctx)->count += BLAKE2S_BLOCK_SIZE;					\
+    _nettle_blake2s_compress ((ctx)->state, (data), (ctx)->count, (f)); \
+  } while (0)
+
+void
+blake2s_update(struct blake2s_ctx *ctx,
+	       size_t length, const uint8_t *data)
+{
+  if (ctx->index > 0)
+    {
+      unsigned left = BLAKE2S_BLOCK_SIZE - ctx->index;
+      if (length <= left)
+	{
+	  memcpy (ctx->block + ctx->index, data, length);
+	  ctx->index += length;
+	  return;
+	}
+      memcpy (ctx->block + ctx->index, data, left);
+      data += left;
+      length -= left;
+      COMPRESS (ctx, ctx->block, 0);
+    }
+
+  for (; length > BLAKE2S_BLOCK_SIZE;
+       length -= BLAKE2S_BLOCK_SIZE, data += BLAKE2S_BLOCK_SIZE)
+    COMPRESS (ctx, data, 0);
+
+  memcpy (ctx->block, data, length);
+  ctx->index = length;
+}
+
+void
+blake2s_digest(struct blake2s_ctx *ctx,
+	       size_t length, uint8_t *digest)
+{
+  uint8_t buffer[BLAKE2S_DIGEST_SIZE];
+  unsigned i;
+
+  assert (length <= ctx->digest_size);
+
+  memset (ctx->block + ctx->index, 0, BLAKE2S_BLOCK_SIZE - ctx->index);
+  ctx->count += ctx->index;
+  _nettle_blake2s_compress (ctx->state, ctx->block, ctx->count,
+			    ~(uint32_t) 0);
+
+  for (i = 0; i < 8; i++)
+    LE_WRITE_UINT32 (buffer + 4*i, ctx->state[i]);
+  memcpy (digest, buffer, length);
+
+  blake2s_reset (ctx);
+}
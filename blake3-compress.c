@@ -0,0 +1,105 @@
+/* blake3-compress.c
+
+   The BLAKE3 compression function.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "blake3.h"
+#include "blake3-internal.h"
+
+#include "macros.h"
+
+/* The message permutation applied before each round, starting with
+   the identity. */
+static const uint8_t sigma[7][16] =
+  {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    {  2,  6,  3, 10,  7,  0,  4, 13,  1, 11, 12,  5,  9, 14, 15,  8 },
+    {  3,  4, 10, 12, 13,  2,  7, 14,  6,  5,  9,  0, 11, 15,  8,  1 },
+    { 10,  7, 12,  9, 14,  3, 13, 15,  4,  0, 11,  2,  5,  8,  1,  6 },
+    { 12, 13,  9, 11, 15, 10, 14,  8,  7,  2,  5,  3,  0,  1,  6,  4 },
+    {  9, 14, 11,  5,  8, 12, 15,  1, 13,  3,  0, 10,  2,  6,  4,  7 },
+    { 11, 15,  5,  0,  1,  9,  8,  6, 14, 10,  2, 12,  3,  4,  7, 13 },
+  };
+
+/* Same as the BLAKE2s and SHA256 initial values. */
+static const uint32_t iv[4] =
+  {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+  };
+
+/* Same as in BLAKE2s. */
+#define G(a, b, c, d, x, y) do {		\
+    a += b + x; d = ROTL32(16, d ^ a);		\
+    c += d; b = ROTL32(20, b ^ c);		\
+    a += b + y; d = ROTL32(24, d ^ a);		\
+    c += d; b = ROTL32(25, b ^ c);		\
+  } while (0)
+
+void
+_nettle_blake3_compress(uint32_t *out, const uint32_t *cv,
+			const uint32_t *m, uint64_t counter,
+			uint32_t block_length, uint32_t flags)
+{
+  uint32_t v[16];
+  unsigned i;
+
+  for (i = 0; i < 8; i++)
+    v[i] = cv[i];
+  for (i = 0; i < 4; i++)
+    v[i+8] = iv[i];
+  v[12] = (uint32_t) counter;
+  v[13] = (uint32_t) (counter >> 32);
+  v[14] = block_length;
+  v[15] = flags;
+
+  for (i = 0; i < 7; i++)
+    {
+      const uint8_t *s = sigma[i];
+      G(v[0], v[4], v[ 8], v[12], m[s[ 0]], m[s[ 1]]);
+      G(v[1], v[5], v[ 9], v[13], m[s[ 2]], m[s[ 3]]);
+      G(v[2], v[6], v[10], v[14], m[s[ 4]], m[s[ 5]]);
+      G(v[3], v[7], v[11], v[15], m[s[ 6]], m[s[ 7]]);
+      G(v[0], v[5], v[10], v[15], m[s[ 8]], m[s[ 9]]);
+      G(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+      G(v[2], v[7], v[ 8], v[13], m[s[12]], m[s[13]]);
+      G(v[3], v[4], v[ 9], v[14], m[s[14]], m[s[15]]);
+    }
+
+  /* The upper half uses cv, so write it first, in case out == cv. */
+  for (i = 0; i < 8; i++)
+    out[i+8] = v[i+8] ^ cv[i];
+  for (i = 0; i < 8; i++)
+    out[i] = v[i] ^ v[i+8];
+}
@@ -0,0 +1,147 @@
+/* blake3-hash-chunks.c
+
+   Hashing several BLAKE3 chunks in parallel.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "blake3.h"
+#include "blake3-internal.h"
+
+#include "macros.h"
+
+/* For fat builds */
+#if HAVE_NATIVE_blake3_hash_chunks
+void
+_nettle_blake3_hash_chunks_c(uint32_t *cvs, const uint32_t *key,
+			     uint32_t flags, uint64_t counter,
+			     unsigned count, const uint8_t *data);
+#define _nettle_blake3_hash_chunks _nettle_blake3_hash_chunks_c
+#endif
+
+/* Same as in blake3-compress.c. */
+static const uint8_t sigma[7][16] =
+  {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    {  2,  6,  3, 10,  7,  0,  4, 13,  1, 11, 12,  5,  9, 14, 15,  8 },
+    {  3,  4, 10, 12, 13,  2,  7, 14,  6,  5,  9,  0, 11, 15,  8,  1 },
+    { 10,  7, 12,  9, 14,  3, 13, 15,  4,  0, 11,  2,  5,  8,  1,  6 },
+    { 12, 13,  9, 11, 15, 10, 14,  8,  7,  2,  5,  3,  0,  1,  6,  4 },
+    {  9, 14, 11,  5,  8, 12, 15,  1, 13,  3,  0, 10,  2,  6,  4,  7 },
+    { 11, 15,  5,  0,  1,  9,  8,  6, 14, 10,  2, 12,  3,  4,  7, 13 },
+  };
+
+static const uint32_t iv[4] =
+  {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+  };
+
+/* As in sha256-compress-lanes.c, each step is applied to all lanes
+   in an innermost loop with a constant trip count, which compilers
+   turn into vector instructions where available. */
+#define G(a, b, c, d, x, y) do {				\
+    unsigned l_;						\
+    for (l_ = 0; l_ < _BLAKE3_LANES; l_++)			\
+      {								\
+	a[l_] += b[l_] + x[l_]; d[l_] = ROTL32(16, d[l_] ^ a[l_]); \
+	c[l_] += d[l_]; b[l_] = ROTL32(20, b[l_] ^ c[l_]);	\
+	a[l_] += b[l_] + y[l_]; d[l_] = ROTL32(24, d[l_] ^ a[l_]); \
+	c[l_] += d[l_]; b[l_] = ROTL32(25, b[l_] ^ c[l_]);	\
+      }								\
+  } while (0)
+
+void
+_nettle_blake3_hash_chunks(uint32_t *cvs, const uint32_t *key,
+			   uint32_t flags, uint64_t counter,
+			   unsigned count, const uint8_t *data)
+{
+  uint32_t h[8][_BLAKE3_LANES];
+  uint32_t v[16][_BLAKE3_LANES];
+  uint32_t m[16][_BLAKE3_LANES];
+  const uint8_t *p[_BLAKE3_LANES];
+  unsigned b, i, l;
+
+  /* Unused lanes repeat the first chunk, and are discarded. */
+  for (l = 0; l < _BLAKE3_LANES; l++)
+    p[l] = data + (l < count ? l : 0) * BLAKE3_CHUNK_SIZE;
+
+  for (i = 0; i < 8; i++)
+    for (l = 0; l < _BLAKE3_LANES; l++)
+      h[i][l] = key[i];
+
+  for (b = 0; b < BLAKE3_CHUNK_SIZE / BLAKE3_BLOCK_SIZE; b++)
+    {
+      uint32_t f = flags;
+      if (b == 0)
+	f |= _BLAKE3_CHUNK_START;
+      if (b == BLAKE3_CHUNK_SIZE / BLAKE3_BLOCK_SIZE - 1)
+	f |= _BLAKE3_CHUNK_END;
+
+      for (i = 0; i < 16; i++)
+	for (l = 0; l < _BLAKE3_LANES; l++)
+	  m[i][l] = LE_READ_UINT32(p[l] + b * BLAKE3_BLOCK_SIZE + 4*i);
+
+      for (l = 0; l < _BLAKE3_LANES; l++)
+	{
+	  for (i = 0; i < 8; i++)
+	    v[i][l] = h[i][l];
+	  for (i = 0; i < 4; i++)
+	    v[i+8][l] = iv[i];
+	  v[12][l] = (uint32_t) (counter + l);
+	  v[13][l] = (uint32_t) ((counter + l) >> 32);
+	  v[14][l] = BLAKE3_BLOCK_SIZE;
+	  v[15][l] = f;
+	}
+
+      for (i = 0; i < 7; i++)
+	{
+	  const uint8_t *s = sigma[i];
+	  G(v[0], v[4], v[ 8], v[12], m[s[ 0]], m[s[ 1]]);
+	  G(v[1], v[5], v[ 9], v[13], m[s[ 2]], m[s[ 3]]);
+	  G(v[2], v[6], v[10], v[14], m[s[ 4]], m[s[ 5]]);
+	  G(v[3], v[7], v[11], v[15], m[s[ 6]], m[s[ 7]]);
+	  G(v[0], v[5], v[10], v[15], m[s[ 8]], m[s[ 9]]);
+	  G(v[1], v[6], v[11], v[12], m[s[10]], m[s[11]]);
+	  G(v[2], v[7], v[ 8], v[13], m[s[12]], m[s[13]]);
+	  G(v[3], v[4], v[ 9], v[14], m[s[14]], m[s[15]]);
+	}
+
+      for (i = 0; i < 8; i++)
+	for (l = 0; l < _BLAKE3_LANES; l++)
+	  h[i][l] = v[i][l] ^ v[i+8][l];
+    }
+
+  for (l = 0; l < count; l++)
+    for (i = 0; i < 8; i++)
+      cvs[8*l + i] = h[i][l];
+}
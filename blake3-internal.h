@@ -0,0 +1,68 @@
+/* blake3-internal.h
+
+   The BLAKE3 compression function.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_BLAKE3_INTERNAL_H_INCLUDED
+#define NETTLE_BLAKE3_INTERNAL_H_INCLUDED
+
+#include "nettle-types.h"
+
+/* Domain separation flags */
+#define _BLAKE3_CHUNK_START 1
+#define _BLAKE3_CHUNK_END 2
+#define _BLAKE3_PARENT 4
+#define _BLAKE3_ROOT 8
+#define _BLAKE3_KEYED_HASH 16
+#define _BLAKE3_DERIVE_KEY_CONTEXT 32
+#define _BLAKE3_DERIVE_KEY_MATERIAL 64
+
+/* Compresses the 16 message words M with chaining value CV, and
+   writes all 16 words of the resulting state to OUT. The first 8
+   words are the new chaining value. OUT may equal CV. */
+void
+_nettle_blake3_compress(uint32_t *out, const uint32_t *cv,
+			const uint32_t *m, uint64_t counter,
+			uint32_t block_length, uint32_t flags);
+
+/* Maximum number of chunks hashed in parallel by
+   _nettle_blake3_hash_chunks. */
+#define _BLAKE3_LANES 8
+
+/* Hashes COUNT <= _BLAKE3_LANES complete chunks, numbered from
+   COUNTER, none of which is the root. Writes one chaining value of 8
+   words per chunk to CVS. */
+void
+_nettle_blake3_hash_chunks(uint32_t *cvs, const uint32_t *key,
+			   uint32_t flags, uint64_t counter,
+			   unsigned count, const uint8_t *data);
+
+#endif /* NETTLE_BLAKE3_INTERNAL_H_INCLUDED */
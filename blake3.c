@@ -0,0 +1,273 @@
+/* blake3.c
+
+   The BLAKE3 hash function.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "blake3.h"
+#include "blake3-internal.h"
+
+#include "macros.h"
+
+static const uint32_t iv[8] =
+  {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL,
+  };
+
+#define BLOCKS_PER_CHUNK (BLAKE3_CHUNK_SIZE / BLAKE3_BLOCK_SIZE)
+
+static void
+read_block(uint32_t *m, const uint8_t *block)
+{
+  unsigned i;
+  for (i = 0; i < 16; i++, block += 4)
+    m[i] = LE_READ_UINT32(block);
+}
+
+static void
+chunk_start(struct blake3_ctx *ctx, uint64_t counter)
+{
+  memcpy (ctx->chunk_cv, ctx->key, sizeof(ctx->chunk_cv));
+  ctx->chunk_counter = counter;
+  ctx->blocks = 0;
+  ctx->index = 0;
+}
+
+static void
+blake3_reset(struct blake3_ctx *ctx)
+{
+  chunk_start (ctx, 0);
+  ctx->depth = 0;
+}
+
+static void
+blake3_init_flags(struct blake3_ctx *ctx,
+		  const uint32_t *key, uint32_t flags)
+{
+  memcpy (ctx->key, key, sizeof(ctx->key));
+  ctx->flags = flags;
+  blake3_reset (ctx);
+}
+
+void
+blake3_init(struct blake3_ctx *ctx)
+{
+  blake3_init_flags (ctx, iv, 0);
+}
+
+void
+blake3_init_key(struct blake3_ctx *ctx, const uint8_t *key)
+{
+  uint32_t k[8];
+  unsigned i;
+
+  for (i = 0; i < 8; i++, key += 4)
+    k[i] = LE_READ_UINT32(key);
+
+  blake3_init_flags (ctx, k, _BLAKE3_KEYED_HASH);
+}
+
+void
+blake3_init_derive_key(struct blake3_ctx *ctx,
+		       size_t length, const uint8_t *context)
+{
+  uint8_t key[BLAKE3_KEY_SIZE];
+
+  blake3_init_flags (ctx, iv, _BLAKE3_DERIVE_KEY_CONTEXT);
+  blake3_update (ctx, length, context);
+  blake3_digest (ctx, sizeof(key), key);
+
+  blake3_init_key (ctx, key);
+  ctx->flags = _BLAKE3_DERIVE_KEY_MATERIAL;
+}
+
+/* Adds the chaining value of a complete chunk, which is not the last
+   one, and merges complete subtrees. The number of trailing zero bits
+   in the new chunk count is the number of merges. */
+static void
+push_chunk(struct blake3_ctx *ctx, const uint32_t *cv, uint64_t chunks)
+{
+  uint32_t m[16];
+  uint32_t out[16];
+
+  memcpy (m + 8, cv, 8 * sizeof(*m));
+  for (; !(chunks & 1); chunks >>= 1)
+    {
+      assert (ctx->depth > 0);
+      memcpy (m, ctx->stack[--ctx->depth], 8 * sizeof(*m));
+      _nettle_blake3_compress (out, ctx->key, m, 0, BLAKE3_BLOCK_SIZE,
+			       ctx->flags | _BLAKE3_PARENT);
+      memcpy (m + 8, out, 8 * sizeof(*m));
+    }
+  assert (ctx->depth < _BLAKE3_MAX_DEPTH);
+  memcpy (ctx->stack[ctx->depth++], m + 8, 8 * sizeof(*m));
+}
+
+/* Compresses a block of the current chunk, which is not the last
+   block of the input. */
+static void
+chunk_compress(struct blake3_ctx *ctx, const uint8_t *block)
+{
+  uint32_t m[16];
+  uint32_t out[16];
+  uint32_t flags = ctx->flags;
+
+  if (ctx->blocks == 0)
+    flags |= _BLAKE3_CHUNK_START;
+  if (ctx->blocks == BLOCKS_PER_CHUNK - 1)
+    flags |= _BLAKE3_CHUNK_END;
+
+  read_block (m, block);
+  _nettle_blake3_compress (out, ctx->chunk_cv, m, ctx->chunk_counter,
+			   BLAKE3_BLOCK_SIZE, flags);
+
+  if (++ctx->blocks == BLOCKS_PER_CHUNK)
+    {
+      push_chunk (ctx, out, ctx->chunk_counter + 1);
+      chunk_start (ctx, ctx->chunk_counter + 1);
+    }
+  else
+    memcpy (ctx->chunk_cv, out, sizeof(ctx->chunk_cv));
+}
+
+void
+blake3_update(struct blake3_ctx *ctx,
+	      size_t length, const uint8_t *data)
+{
+  while (length > 0)
+    {
+      size_t left;
+
+      /* More input follows, so a buffered block is not the last. */
+      if (ctx->index == BLAKE3_BLOCK_SIZE)
+	{
+	  chunk_compress (ctx, ctx->block);
+	  ctx->index = 0;
+	}
+
+      if (ctx->index == 0 && length > BLAKE3_BLOCK_SIZE)
+	{
+	  if (ctx->blocks == 0 && length > BLAKE3_CHUNK_SIZE)
+	    {
+	      uint32_t cvs[_BLAKE3_LANES][8];
+	      size_t count = (length - 1) / BLAKE3_CHUNK_SIZE;
+	      unsigned i;
+
+	      if (count > _BLAKE3_LANES)
+		count = _BLAKE3_LANES;
+
+	      _nettle_blake3_hash_chunks (cvs[0], ctx->key, ctx->flags,
+					  ctx->chunk_counter, count, data);
+	      for (i = 0; i < count; i++)
+		push_chunk (ctx, cvs[i], ctx->chunk_counter + i + 1);
+
+	      chunk_start (ctx, ctx->chunk_counter + count);
+	      data += count * BLAKE3_CHUNK_SIZE;
+	      length -= count * BLAKE3_CHUNK_SIZE;
+	    }
+	  else
+	    {
+	      chunk_compress (ctx, data);
+	      data += BLAKE3_BLOCK_SIZE;
+	      length -= BLAKE3_BLOCK_SIZE;
+	    }
+	  continue;
+	}
+
+      left = BLAKE3_BLOCK_SIZE - ctx->index;
+      if (left > length)
+	left = length;
+      memcpy (ctx->block + ctx->index, data, left);
+      ctx->index += left;
+      data += left;
+      length -= left;
+    }
+}
+
+void
+blake3_digest(struct blake3_ctx *ctx,
+	      size_t length, uint8_t *digest)
+{
+  /* Inputs to the root compression. */
+  uint32_t cv[8];
+  uint32_t m[16];
+  uint64_t counter = ctx->chunk_counter;
+  uint32_t block_length = ctx->index;
+  uint32_t flags = ctx->flags | _BLAKE3_CHUNK_END;
+  uint32_t out[16];
+  uint64_t i;
+  unsigned j;
+
+  if (ctx->blocks == 0)
+    flags |= _BLAKE3_CHUNK_START;
+
+  memset (ctx->block + ctx->index, 0, BLAKE3_BLOCK_SIZE - ctx->index);
+  read_block (m, ctx->block);
+  memcpy (cv, ctx->chunk_cv, sizeof(cv));
+
+  /* The last chunk is merged with the stacked subtrees, smallest
+     first, and the last merge is the root. */
+  while (ctx->depth > 0)
+    {
+      _nettle_blake3_compress (out, cv, m, counter, block_length, flags);
+      memcpy (m, ctx->stack[--ctx->depth], 8 * sizeof(*m));
+      memcpy (m + 8, out, 8 * sizeof(*m));
+      memcpy (cv, ctx->key, sizeof(cv));
+      counter = 0;
+      block_length = BLAKE3_BLOCK_SIZE;
+      flags = ctx->flags | _BLAKE3_PARENT;
+    }
+
+  /* Extended output uses the block counter. */
+  for (i = 0; length > 0; i++)
+    {
+      uint8_t block[BLAKE3_BLOCK_SIZE];
+      size_t n = length < sizeof(block) ? length : sizeof(block);
+
+      _nettle_blake3_compress (out, cv, m, i, block_length,
+			       flags | _BLAKE3_ROOT);
+      for (j = 0; j < 16; j++)
+	LE_WRITE_UINT32 (block + 4*j, out[j]);
+
+      memcpy (digest, block, n);
+      digest += n;
+      length -= n;
+    }
+
+  blake3_reset (ctx);
+}
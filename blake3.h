@@ -0,0 +1,114 @@
+/* blake3.h
+
+   The BLAKE3 hash function.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_BLAKE3_H_INCLUDED
+#define NETTLE_BLAKE3_H_INCLUDED
+
+#include "nettle-types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Name mangling */
+#define blake3_init nettle_blake3_init
+#define blake3_init_key nettle_blake3_init_key
+#define blake3_init_derive_key nettle_blake3_init_derive_key
+#define blake3_update nettle_blake3_update
+#define blake3_digest nettle_blake3_digest
+
+#define BLAKE3_DIGEST_SIZE 32
+#define BLAKE3_BLOCK_SIZE 64
+#define BLAKE3_CHUNK_SIZE 1024
+#define BLAKE3_KEY_SIZE 32
+
+/* Chunks are the leaves of a binary tree. The stack holds one
+   chaining value per level, enough for 2^64 octets of input. */
+#define _BLAKE3_MAX_DEPTH 54
+
+struct blake3_ctx
+{
+  uint32_t key[8];
+  uint32_t flags;
+
+  /* The current chunk */
+  uint32_t chunk_cv[8];
+  uint64_t chunk_counter;
+  unsigned blocks;
+  /* The last block of the input is compressed with different flags,
+     so a full block is kept here until more input arrives. */
+  unsigned index;
+  uint8_t block[BLAKE3_BLOCK_SIZE];
+
+  /* Chaining values of complete subtrees, largest first. */
+  unsigned depth;
+  uint32_t stack[_BLAKE3_MAX_DEPTH][8];
+};
+
+void
+blake3_init(struct blake3_ctx *ctx);
+
+/* Keyed hashing, for use as a MAC or PRF. */
+void
+blake3_init_key(struct blake3_ctx *ctx, const uint8_t *key);
+
+/* Key derivation. The context string should be hardcoded, globally
+   unique, and application specific, and the key material is then
+   passed to blake3_update. */
+void
+blake3_init_derive_key(struct blake3_ctx *ctx,
+		       size_t length, const uint8_t *context);
+
+void
+blake3_update(struct blake3_ctx *ctx,
+	      size_t length, const uint8_t *data);
+
+/* BLAKE3 is an extendable output function, so length may exceed
+   BLAKE3_DIGEST_SIZE. */
+void
+blake3_digest(struct blake3_ctx *ctx,
+	      size_t length, uint8_t *digest);
+
+/* For nettle_blake3_256. */
+#define BLAKE3_256_DIGEST_SIZE BLAKE3_DIGEST_SIZE
+#define BLAKE3_256_BLOCK_SIZE BLAKE3_BLOCK_SIZE
+#define blake3_256_ctx blake3_ctx
+#define blake3_256_init nettle_blake3_init
+#define blake3_256_update nettle_blake3_update
+#define blake3_256_digest nettle_blake3_digest
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETTLE_BLAKE3_H_INCLUDED */
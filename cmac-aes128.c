@@ -58,3 +58,13 @@ cmac_aes128_digest(struct cmac_aes128_ctx *ctx,
 {
   CMAC128_DIGEST(ctx, aes128_encrypt, length, digest);
 }
+
+void
+cmac_aes128_many(const struct cmac_aes128_ctx *ctx, size_t n,
+		const size_t *lengths, const uint8_t * const *messages,
+		size_t length, uint8_t *digests)
+{
+  cmac128_many(&ctx->ctx, &ctx->cipher,
+	       (nettle_cipher_func *) aes128_encrypt,
+	       n, lengths, messages, length, digests);
+}
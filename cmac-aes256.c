@@ -58,3 +58,13 @@ cmac_aes256_digest(struct cmac_aes256_ctx *ctx,
 {
   CMAC128_DIGEST(ctx, aes256_encrypt, length, digest);
 }
+
+void
+cmac_aes256_many(const struct cmac_aes256_ctx *ctx, size_t n,
+		const size_t *lengths, const uint8_t * const *messages,
+		size_t length, uint8_t *digests)
+{
+  cmac128_many(&ctx->ctx, &ctx->cipher,
+	       (nettle_cipher_func *) aes256_encrypt,
+	       n, lengths, messages, length, digests);
+}
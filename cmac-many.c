@@ -0,0 +1,129 @@
+/* cmac-many.c
+
+   CMAC of several independent messages, with interleaved lanes.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "cmac.h"
+
+#include "memxor.h"
+
+/* Processes up to CMAC128_LANES messages. For each step, the next
+   block of all unfinished messages is encrypted with a single call to
+   the cipher. */
+static void
+cmac128_lanes(const struct cmac128_ctx *ctx, const void *cipher,
+	      nettle_cipher_func *encrypt, unsigned m,
+	      const size_t *lengths, const uint8_t * const *messages,
+	      unsigned length, uint8_t *digests)
+{
+  union nettle_block16 X[CMAC128_LANES];
+  union nettle_block16 Y[CMAC128_LANES];
+  size_t blocks[CMAC128_LANES];
+  unsigned lane[CMAC128_LANES];
+  size_t max_blocks;
+  size_t j;
+  unsigned l;
+
+  for (l = 0, max_blocks = 0; l < m; l++)
+    {
+      /* An empty message is one padded block. */
+      blocks[l] = lengths[l] > 0 ? (lengths[l] + 15) / 16 : 1;
+      if (blocks[l] > max_blocks)
+	max_blocks = blocks[l];
+      memset(&X[l], 0, sizeof(X[l]));
+    }
+
+  for (j = 0; j < max_blocks; j++)
+    {
+      unsigned k;
+      for (l = k = 0; l < m; l++)
+	{
+	  const uint8_t *p;
+	  size_t left;
+
+	  if (j >= blocks[l])
+	    continue;
+
+	  p = messages[l] + 16*j;
+	  left = lengths[l] - 16*j;
+	  if (j + 1 < blocks[l])
+	    memxor3(Y[k].b, X[l].b, p, 16);
+	  else if (left == 16)
+	    {
+	      memxor3(Y[k].b, X[l].b, p, 16);
+	      memxor(Y[k].b, ctx->K1.b, 16);
+	    }
+	  else
+	    {
+	      memcpy(Y[k].b, p, left);
+	      Y[k].b[left] = 0x80;
+	      memset(Y[k].b + left + 1, 0, 15 - left);
+	      memxor(Y[k].b, ctx->K2.b, 16);
+	      memxor(Y[k].b, X[l].b, 16);
+	    }
+	  lane[k++] = l;
+	}
+      encrypt(cipher, k * 16, Y[0].b, Y[0].b);
+      for (l = 0; l < k; l++)
+	X[lane[l]] = Y[l];
+    }
+
+  for (l = 0; l < m; l++, digests += length)
+    memcpy(digests, X[l].b, length);
+}
+
+void
+cmac128_many(const struct cmac128_ctx *ctx, const void *cipher,
+	     nettle_cipher_func *encrypt, size_t n,
+	     const size_t *lengths, const uint8_t * const *messages,
+	     unsigned length, uint8_t *digests)
+{
+  assert(length <= 16);
+
+  for (; n >= CMAC128_LANES; n -= CMAC128_LANES)
+    {
+      cmac128_lanes(ctx, cipher, encrypt, CMAC128_LANES,
+		    lengths, messages, length, digests);
+      lengths += CMAC128_LANES;
+      messages += CMAC128_LANES;
+      digests += CMAC128_LANES * length;
+    }
+  if (n > 0)
+    cmac128_lanes(ctx, cipher, encrypt, n,
+		  lengths, messages, length, digests);
+}
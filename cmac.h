@@ -45,15 +45,21 @@ extern "C" {
 
 #define CMAC128_DIGEST_SIZE 16
 
+/* Number of messages processed together by cmac128_many. */
+#define CMAC128_LANES 8
+
 #define cmac128_set_key nettle_cmac128_set_key
 #define cmac128_update nettle_cmac128_update
 #define cmac128_digest nettle_cmac128_digest
+#define cmac128_many nettle_cmac128_many
 #define cmac_aes128_set_key nettle_cmac_aes128_set_key
 #define cmac_aes128_update nettle_cmac_aes128_update
 #define cmac_aes128_digest nettle_cmac_aes128_digest
+#define cmac_aes128_many nettle_cmac_aes128_many
 #define cmac_aes256_set_key nettle_cmac_aes256_set_key
 #define cmac_aes256_update nettle_cmac_aes256_update
 #define cmac_aes256_digest nettle_cmac_aes256_digest
+#define cmac_aes256_many nettle_cmac_aes256_many
 
 struct cmac128_ctx
 {
@@ -82,6 +88,15 @@ cmac128_digest(struct cmac128_ctx *ctx, const void *cipher,
 	       unsigned length,
 	       uint8_t *digest);
 
+/* Computes the CMACs of n independent messages, all with the key of
+   ctx, storing the digests one after another. Only the subkeys of
+   ctx are used, and it is not modified. */
+void
+cmac128_many(const struct cmac128_ctx *ctx, const void *cipher,
+	     nettle_cipher_func *encrypt, size_t n,
+	     const size_t *lengths, const uint8_t * const *messages,
+	     unsigned length, uint8_t *digests);
+
 
 #define CMAC128_CTX(type) \
   { struct cmac128_ctx ctx; type cipher; }
@@ -120,6 +135,11 @@ void
 cmac_aes128_digest(struct cmac_aes128_ctx *ctx,
 		   size_t length, uint8_t *digest);
 
+void
+cmac_aes128_many(const struct cmac_aes128_ctx *ctx, size_t n,
+		const size_t *lengths, const uint8_t * const *messages,
+		size_t length, uint8_t *digests);
+
 struct cmac_aes256_ctx CMAC128_CTX(struct aes256_ctx);
 
 void
@@ -133,6 +153,11 @@ void
 cmac_aes256_digest(struct cmac_aes256_ctx *ctx,
 		   size_t length, uint8_t *digest);
 
+void
+cmac_aes256_many(const struct cmac_aes256_ctx *ctx, size_t n,
+		const size_t *lengths, const uint8_t * const *messages,
+		size_t length, uint8_t *digests);
+
 #ifdef __cplusplus
 }
 #endif
@@ -42,6 +42,7 @@
 
 #include "asn1.h"
 
+#include "gmp-glue.h"
 #include "macros.h"
 
 /* Basic DER syntax: (reference: A Layman's Guide to a Subset of ASN.1, BER, and DER,
@@ -252,9 +253,9 @@ asn1_der_get_uint32(struct asn1_der_iterator *i,
   return 1;
 }
 
-/* NOTE: This is the only function in this file which needs bignums.
-   One could split this file in two, one in libnettle and one in
-   libhogweed. */
+/* NOTE: This and asn1_der_get_limbs are the only functions in this
+   file which need bignums. One could split this file in two, one in
+   libnettle and one in libhogweed. */
 int
 asn1_der_get_bignum(struct asn1_der_iterator *i,
 		    mpz_t x, unsigned max_bits)
@@ -277,3 +278,55 @@ asn1_der_get_bignum(struct asn1_der_iterator *i,
 
   return 1;
 }
+
+/* Like asn1_der_get_bignum, but for non-negative numbers only, and
+   stores the number in RP, without any memory allocation. Fails if
+   it needs more than RN limbs. */
+int
+asn1_der_get_limbs(struct asn1_der_iterator *i,
+		   mp_size_t *size, mp_limb_t *rp, mp_size_t rn,
+		   unsigned max_bits)
+{
+  size_t length = i->length;
+  const uint8_t *data = i->data;
+  mp_size_t n;
+
+  if (length > 1
+      && data[0] == 0 && data[1] < 0x80)
+    /* Non-minimal number of digits */
+    return 0;
+
+  if (length > 0 && data[0] >= 0x80)
+    /* Negative */
+    return 0;
+
+  /* Skip the sign octet */
+  if (length > 0 && data[0] == 0)
+    {
+      length--;
+      data++;
+    }
+
+  if (max_bits && length > 0)
+    {
+      unsigned bits = 8 * (length - 1);
+      uint8_t high;
+
+      if (bits >= max_bits)
+	return 0;
+
+      for (high = data[0]; high; high >>= 1)
+	bits++;
+      if (bits > max_bits)
+	return 0;
+    }
+
+  n = (length + sizeof(mp_limb_t) - 1) / sizeof(mp_limb_t);
+  if (n > rn)
+    return 0;
+
+  mpn_set_base256(rp, n, data, length);
+  *size = n;
+
+  return 1;
+}
@@ -39,6 +39,7 @@
 
 #include "bignum.h"
 #include "asn1.h"
+#include "gmp-glue.h"
 
 #define GET(i, x, l)					\
 (asn1_der_iterator_next((i)) == ASN1_ITERATOR_PRIMITIVE	\
@@ -66,6 +67,34 @@ rsa_public_key_from_der_iterator(struct rsa_public_key *pub,
 	  && rsa_public_key_prepare(pub));
 }
 
+mp_size_t
+rsa_public_key_from_der_limbs(struct rsa_public_key *pub,
+			      unsigned limit,
+			      mp_size_t limbs_size, mp_limb_t *limbs,
+			      struct asn1_der_iterator *i)
+{
+  mp_size_t nn;
+  mp_size_t en;
+
+  /* Same structure as for rsa_public_key_from_der_iterator. */
+  if (!(i->type == ASN1_SEQUENCE
+	&& asn1_der_decode_constructed_last(i) == ASN1_ITERATOR_PRIMITIVE
+	&& i->type == ASN1_INTEGER
+	&& asn1_der_get_limbs(i, &nn, limbs, limbs_size, limit)
+	&& nn > 0
+	&& asn1_der_iterator_next(i) == ASN1_ITERATOR_PRIMITIVE
+	&& i->type == ASN1_INTEGER
+	&& asn1_der_get_limbs(i, &en, limbs + nn, limbs_size - nn, limit)
+	&& en > 0
+	&& asn1_der_iterator_next(i) == ASN1_ITERATOR_END))
+    return 0;
+
+  mpz_roinit_n(pub->n, limbs, nn);
+  mpz_roinit_n(pub->e, limbs + nn, en);
+
+  return rsa_public_key_prepare(pub) ? nn + en : 0;
+}
+
 int
 rsa_private_key_from_der_iterator(struct rsa_public_key *pub,
 				  struct rsa_private_key *priv,
@@ -139,3 +168,54 @@ rsa_keypair_from_der(struct rsa_public_key *pub,
   else
     return rsa_public_key_from_der_iterator(pub, limit, &i);    
 }
+
+int
+rsa_public_keys_from_der(size_t *nkeys, struct rsa_public_key *keys,
+			 mp_size_t *limbs_size, mp_limb_t *limbs,
+			 unsigned limit,
+			 size_t *length, const uint8_t *data)
+{
+  size_t count;
+  size_t done;
+  mp_size_t used;
+  int res = 1;
+
+  for (count = done = used = 0; count < *nkeys && done < *length; count++)
+    {
+      struct asn1_der_iterator i;
+      size_t object_length;
+      mp_size_t n;
+
+      if (asn1_der_iterator_first(&i, *length - done, data + done)
+	  != ASN1_ITERATOR_CONSTRUCTED)
+	{
+	  res = 0;
+	  break;
+	}
+
+      /* Stop before a key which might not fit. */
+      if ((size_t) (*limbs_size - used) < RSA_PUBLIC_KEY_DER_LIMBS(i.length))
+	break;
+
+      /* Restrict the iterator to this object, which is what
+	 rsa_public_key_from_der_limbs expects. */
+      object_length = i.pos;
+      asn1_der_iterator_first(&i, object_length, data + done);
+
+      n = rsa_public_key_from_der_limbs(&keys[count], limit,
+					*limbs_size - used, limbs + used, &i);
+      if (!n)
+	{
+	  res = 0;
+	  break;
+	}
+
+      used += n;
+      done += object_length;
+    }
+
+  *nkeys = count;
+  *limbs_size = used;
+  *length = done;
+  return res;
+}
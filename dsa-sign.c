@@ -42,6 +42,7 @@
 #include "dsa-internal.h"
 
 #include "bignum.h"
+#include "hogweed-internal.h"
 
 
 int
@@ -71,7 +72,7 @@ dsa_sign(const struct dsa_params *params,
   mpz_add_ui(k, k, 1);
 
   /* Compute r = (g^k (mod p)) (mod q) */
-  mpz_powm_sec(tmp, params->g, k, params->p);
+  _bignum_sec_powm(tmp, params->g, k, params->p);
   mpz_fdiv_r(signature->r, tmp, params->q);
 
   /* Compute hash */
@@ -79,7 +80,7 @@ dsa_sign(const struct dsa_params *params,
   _dsa_hash (h, mpz_sizeinbase(params->q, 2), digest_size, digest);
 
   /* Compute k^-1 (mod q) */
-  if (mpz_invert(k, k, params->q))
+  if (_bignum_sec_invert(k, k, params->q))
     {
       /* Compute signature s = k^-1 (h + xr) (mod q) */
       mpz_mul(tmp, signature->r, x);
@@ -42,10 +42,24 @@
 #include <errno.h>
 #include <string.h>
 
+#include <sys/types.h>
+#include <sys/stat.h>
+#if HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+
+#if HAVE_SYS_MMAN_H && HAVE_MMAP
+# include <sys/mman.h>
+# define USE_MMAP 1
+#else
+# define USE_MMAP 0
+#endif
+
 #include "io.h"
 
 #define RANDOM_DEVICE "/dev/urandom"
 #define BUFSIZE 1000
+#define HASH_BUFSIZE (1 << 18)
 
 int quiet_flag = 0;
 
@@ -184,18 +198,66 @@ simple_random(struct yarrow256_ctx *ctx, const char *name)
   return 1;
 }
 
+#if USE_MMAP
+/* Hashes a regular file by mapping it, avoiding copies. Returns 0 if
+   the file must be read instead. */
+static int
+hash_mapped_file(const struct nettle_hash *hash, void *ctx, FILE *f)
+{
+  struct stat st;
+  int fd = fileno (f);
+  size_t size;
+  void *p;
+
+  if (fstat (fd, &st) < 0 || !S_ISREG (st.st_mode) || st.st_size <= 0
+      || (uintmax_t) st.st_size > SIZE_MAX)
+    return 0;
+
+  /* The mapping starts at the beginning of the file, so give up if
+     anything has been read already. */
+  if (ftell (f) != 0 || lseek (fd, 0, SEEK_CUR) != 0)
+    return 0;
+
+  size = st.st_size;
+  p = mmap (NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (p == MAP_FAILED)
+    return 0;
+
+#if HAVE_MADVISE && defined (MADV_SEQUENTIAL)
+  madvise (p, size, MADV_SEQUENTIAL);
+#endif
+  hash->update(ctx, size, p);
+  munmap (p, size);
+  return 1;
+}
+#endif
+
+/* Also in tools/nettle-hash.c */
 int
 hash_file(const struct nettle_hash *hash, void *ctx, FILE *f)
 {
+  uint8_t *buffer;
+
+#if USE_MMAP
+  if (hash_mapped_file (hash, ctx, f))
+    return 1;
+#endif
+
+  buffer = xalloc (HASH_BUFSIZE);
   for (;;)
     {
-      uint8_t buffer[BUFSIZE];
-      size_t res = fread(buffer, 1, sizeof(buffer), f);
+      size_t res = fread(buffer, 1, HASH_BUFSIZE, f);
       if (ferror(f))
-	return 0;
+	{
+	  free (buffer);
+	  return 0;
+	}
       
       hash->update(ctx, res, buffer);
       if (feof(f))
-	return 1;
+	{
+	  free (buffer);
+	  return 1;
+	}
     }
 }
@@ -66,6 +66,7 @@
 #include "twofish.h"
 #include "umac.h"
 #include "cmac.h"
+#include "pmac.h"
 #include "poly1305.h"
 #include "hmac.h"
 
@@ -268,6 +269,32 @@ bench_aead_update(void *arg)
   info->update (info->ctx, BENCH_BLOCK, info->data);
 }
 
+struct bench_aead_message_info
+{
+  const void *ctx;
+  const struct nettle_aead_message *aead;
+  const uint8_t *nonce;
+  uint8_t *data;
+};
+
+/* The message is BENCH_BLOCK octets including the tag. */
+static void
+bench_aead_message_encrypt(void *arg)
+{
+  const struct bench_aead_message_info *info = arg;
+  info->aead->encrypt (info->ctx, info->aead->nonce_size, info->nonce,
+		       0, NULL, BENCH_BLOCK, info->data, info->data);
+}
+
+static void
+bench_aead_message_decrypt(void *arg)
+{
+  const struct bench_aead_message_info *info = arg;
+  info->aead->decrypt (info->ctx, info->aead->nonce_size, info->nonce,
+		       0, NULL, BENCH_BLOCK - info->aead->digest_size,
+		       info->data, info->data);
+}
+
 /* Set data[i] = floor(sqrt(i)) */
 static void
 init_data(uint8_t *data)
@@ -442,12 +469,39 @@ time_umac(void)
 	  time_function(bench_hash, &info));
 }
 
+struct bench_cmac_many_info
+{
+  const struct cmac_aes128_ctx *ctx;
+  const uint8_t *data;
+};
+
+/* Splits the data into one message per lane. */
+static void
+bench_cmac_many(void *arg)
+{
+  struct bench_cmac_many_info *info = arg;
+  const uint8_t *messages[CMAC128_LANES];
+  size_t lengths[CMAC128_LANES];
+  uint8_t digests[CMAC128_LANES * CMAC128_DIGEST_SIZE];
+  unsigned i;
+
+  for (i = 0; i < CMAC128_LANES; i++)
+    {
+      lengths[i] = BENCH_BLOCK / CMAC128_LANES;
+      messages[i] = info->data + i * lengths[i];
+    }
+  cmac_aes128_many (info->ctx, CMAC128_LANES, lengths, messages,
+		    CMAC128_DIGEST_SIZE, digests);
+}
+
 static void
 time_cmac(void)
 {
   static uint8_t data[BENCH_BLOCK];
   struct bench_hash_info info;
+  struct bench_cmac_many_info many;
   struct cmac_aes128_ctx ctx;
+  struct pmac_aes128_ctx pctx;
 
   uint8_t key[16];
 
@@ -458,6 +512,19 @@ time_cmac(void)
 
   display("cmac-aes128", "update", AES_BLOCK_SIZE,
 	  time_function(bench_hash, &info));
+
+  many.ctx = &ctx;
+  many.data = data;
+  display("cmac-aes128", "many", AES_BLOCK_SIZE,
+	  time_function(bench_cmac_many, &many));
+
+  pmac_aes128_set_key (&pctx, key);
+  info.ctx = &pctx;
+  info.update = (nettle_hash_update_func *) pmac_aes128_update;
+  info.data = data;
+
+  display("pmac-aes128", "update", AES_BLOCK_SIZE,
+	  time_function(bench_hash, &info));
 }
 
 static void
@@ -816,6 +883,39 @@ time_aead(const struct nettle_aead *aead)
   free(nonce);
 }
 
+static void
+time_aead_message(const struct nettle_aead_message *aead)
+{
+  void *ctx = xalloc(aead->context_size);
+  uint8_t *key = xalloc(aead->key_size);
+  uint8_t *nonce = xalloc(aead->nonce_size);
+  static uint8_t data[BENCH_BLOCK];
+  struct bench_aead_message_info info;
+
+  printf("\n");
+
+  init_data(data);
+  init_nonce(aead->nonce_size, nonce);
+  init_key(aead->key_size, key);
+
+  info.ctx = ctx;
+  info.aead = aead;
+  info.nonce = nonce;
+  info.data = data;
+
+  aead->set_encrypt_key(ctx, key);
+  display(aead->name, "encrypt", 16,
+	  time_function(bench_aead_message_encrypt, &info));
+
+  aead->set_decrypt_key(ctx, key);
+  display(aead->name, "decrypt", 16,
+	  time_function(bench_aead_message_decrypt, &info));
+
+  free(ctx);
+  free(key);
+  free(nonce);
+}
+
 /* Try to get accurate cycle times for assembler functions. */
 #if WITH_CYCLE_COUNTER
 static int
@@ -918,6 +1018,8 @@ main(int argc, char **argv)
       &nettle_sha3_224, &nettle_sha3_256,
       &nettle_sha3_384, &nettle_sha3_512,
       &nettle_ripemd160, &nettle_gosthash94,
+      &nettle_blake2b_512, &nettle_blake2s_256,
+      &nettle_blake3_256,
       NULL
     };
 
@@ -952,6 +1054,7 @@ main(int argc, char **argv)
       &nettle_gcm_camellia128,
       &nettle_gcm_camellia256,
       &nettle_eax_aes128,
+      &nettle_ocb_aes128,
       &nettle_chacha_poly1305,
       NULL
     };
@@ -1025,6 +1128,10 @@ main(int argc, char **argv)
 	if (!alg || strstr(aeads[i]->name, alg))
 	  time_aead(aeads[i]);
 
+      for (i = 0; nettle_aead_messages[i]; i++)
+	if (!alg || strstr(nettle_aead_messages[i]->name, alg))
+	  time_aead_message(nettle_aead_messages[i]);
+
       if (!alg || strstr ("hmac-md5", alg))
 	time_hmac_md5();
 
@@ -160,6 +160,7 @@ typedef void aes_crypt_internal_func (unsigned rounds, const uint32_t *keys,
 				      const uint8_t *src);
 
 typedef void *(memxor_func)(void *dst, const void *src, size_t n);
+typedef void *(memxor3_func)(void *dst, const void *a, const void *b, size_t n);
 
 typedef void salsa20_core_func (uint32_t *dst, const uint32_t *src, unsigned rounds);
 
@@ -175,4 +176,11 @@ typedef uint64_t umac_nh_func (const uint32_t *key, unsigned length, const uint8
 typedef void umac_nh_n_func (uint64_t *out, unsigned n, const uint32_t *key,
 			     unsigned length, const uint8_t *msg);
 
+typedef void blake2b_compress_func (uint64_t *state, const uint8_t *block,
+				   uint64_t t_low, uint64_t t_high,
+				   uint64_t f);
+typedef void blake3_hash_chunks_func (uint32_t *cvs, const uint32_t *key,
+				      uint32_t flags, uint64_t counter,
+				      unsigned count, const uint8_t *data);
+
 typedef void chacha_core_func(uint32_t *dst, const uint32_t *src, unsigned rounds);
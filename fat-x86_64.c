@@ -47,12 +47,15 @@
 #include "fat-setup.h"
 
 void _nettle_cpuid (uint32_t input, uint32_t regs[4]);
+uint64_t _nettle_xgetbv (uint32_t xcr);
 
 struct x86_features
 {
   enum x86_vendor { X86_OTHER, X86_INTEL, X86_AMD } vendor;
   int have_aesni;
   int have_sha_ni;
+  int have_avx2;
+  int have_avx512;
 };
 
 #define SKIP(s, slen, literal, llen)				\
@@ -68,6 +71,8 @@ get_x86_features (struct x86_features *features)
   features->vendor = X86_OTHER;
   features->have_aesni = 0;
   features->have_sha_ni = 0;
+  features->have_avx2 = 0;
+  features->have_avx512 = 0;
 
   s = secure_getenv (ENV_OVERRIDE);
   if (s)
@@ -88,6 +93,10 @@ get_x86_features (struct x86_features *features)
 	  features->have_aesni = 1;
 	else if (MATCH (s, length, "sha_ni", 6))
 	  features->have_sha_ni = 1;
+	else if (MATCH (s, length, "avx2", 4))
+	  features->have_avx2 = 1;
+	else if (MATCH (s, length, "avx512", 6))
+	  features->have_avx512 = 1;
 	if (!sep)
 	  break;
 	s = sep + 1;
@@ -95,6 +104,8 @@ get_x86_features (struct x86_features *features)
   else
     {
       uint32_t cpuid_data[4];
+      int os_avx;
+      int os_avx512;
       _nettle_cpuid (0, cpuid_data);
       if (memcmp (cpuid_data + 1, "Genu" "ntel" "ineI", 12) == 0)
 	features->vendor = X86_INTEL;
@@ -105,9 +116,22 @@ get_x86_features (struct x86_features *features)
       if (cpuid_data[2] & 0x02000000)
        features->have_aesni = 1;
 
+      /* The ymm registers are usable only if the OS saves them,
+	 which is indicated by OSXSAVE and the XCR0 bits for the sse
+	 and avx state. */
+      os_avx = ((cpuid_data[2] & 0x18000000) == 0x18000000
+		&& (_nettle_xgetbv (0) & 6) == 6);
+      /* The zmm registers additionally need the opmask and upper zmm
+	 state bits. */
+      os_avx512 = os_avx && (_nettle_xgetbv (0) & 0xe0) == 0xe0;
+
       _nettle_cpuid (7, cpuid_data);
       if (cpuid_data[1] & 0x20000000)
        features->have_sha_ni = 1;
+      if (os_avx && (cpuid_data[1] & 0x00000020))
+       features->have_avx2 = 1;
+      if (os_avx512 && (cpuid_data[1] & 0x00010000))
+       features->have_avx512 = 1;
     }
 }
 
@@ -122,6 +146,13 @@ DECLARE_FAT_FUNC_VAR(aes_decrypt, aes_crypt_internal_func, aesni)
 DECLARE_FAT_FUNC(nettle_memxor, memxor_func)
 DECLARE_FAT_FUNC_VAR(memxor, memxor_func, x86_64)
 DECLARE_FAT_FUNC_VAR(memxor, memxor_func, sse2)
+DECLARE_FAT_FUNC_VAR(memxor, memxor_func, avx2)
+DECLARE_FAT_FUNC_VAR(memxor, memxor_func, avx512)
+
+DECLARE_FAT_FUNC(nettle_memxor3, memxor3_func)
+DECLARE_FAT_FUNC_VAR(memxor3, memxor3_func, x86_64)
+DECLARE_FAT_FUNC_VAR(memxor3, memxor3_func, avx2)
+DECLARE_FAT_FUNC_VAR(memxor3, memxor3_func, avx512)
 
 DECLARE_FAT_FUNC(nettle_sha1_compress, sha1_compress_func)
 DECLARE_FAT_FUNC_VAR(sha1_compress, sha1_compress_func, x86_64)
@@ -131,6 +162,18 @@ DECLARE_FAT_FUNC(_nettle_sha256_compress, sha256_compress_func)
 DECLARE_FAT_FUNC_VAR(sha256_compress, sha256_compress_func, x86_64)
 DECLARE_FAT_FUNC_VAR(sha256_compress, sha256_compress_func, sha_ni)
 
+DECLARE_FAT_FUNC(_nettle_umac_nh_n, umac_nh_n_func)
+DECLARE_FAT_FUNC_VAR(umac_nh_n, umac_nh_n_func, x86_64)
+DECLARE_FAT_FUNC_VAR(umac_nh_n, umac_nh_n_func, avx2)
+
+DECLARE_FAT_FUNC(_nettle_blake2b_compress, blake2b_compress_func)
+DECLARE_FAT_FUNC_VAR(blake2b_compress, blake2b_compress_func, c)
+DECLARE_FAT_FUNC_VAR(blake2b_compress, blake2b_compress_func, avx2)
+
+DECLARE_FAT_FUNC(_nettle_blake3_hash_chunks, blake3_hash_chunks_func)
+DECLARE_FAT_FUNC_VAR(blake3_hash_chunks, blake3_hash_chunks_func, c)
+DECLARE_FAT_FUNC_VAR(blake3_hash_chunks, blake3_hash_chunks_func, avx2)
+
 /* This function should usually be called only once, at startup. But
    it is idempotent, and on x86, pointer updates are atomic, so
    there's no danger if it is called simultaneously from multiple
@@ -151,10 +194,12 @@ fat_init (void)
     {
       const char * const vendor_names[3] =
 	{ "other", "intel", "amd" };
-      fprintf (stderr, "libnettle: cpu features: vendor:%s%s%s\n",
+      fprintf (stderr, "libnettle: cpu features: vendor:%s%s%s%s%s\n",
 	       vendor_names[features.vendor],
 	       features.have_aesni ? ",aesni" : "",
-	       features.have_sha_ni ? ",sha_ni" : "");
+	       features.have_sha_ni ? ",sha_ni" : "",
+	       features.have_avx2 ? ",avx2" : "",
+	       features.have_avx512 ? ",avx512" : "");
     }
   if (features.have_aesni)
     {
@@ -185,17 +230,51 @@ fat_init (void)
       nettle_sha1_compress_vec = _nettle_sha1_compress_x86_64;
       _nettle_sha256_compress_vec = _nettle_sha256_compress_x86_64;
     }
-  if (features.vendor == X86_INTEL)
+
+  if (features.have_avx2)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: using avx2 instructions.\n");
+      _nettle_umac_nh_n_vec = _nettle_umac_nh_n_avx2;
+      _nettle_blake2b_compress_vec = _nettle_blake2b_compress_avx2;
+      _nettle_blake3_hash_chunks_vec = _nettle_blake3_hash_chunks_avx2;
+    }
+  else
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: not using avx2 instructions.\n");
+      _nettle_umac_nh_n_vec = _nettle_umac_nh_n_x86_64;
+      _nettle_blake2b_compress_vec = _nettle_blake2b_compress_c;
+      _nettle_blake3_hash_chunks_vec = _nettle_blake3_hash_chunks_c;
+    }
+
+  if (features.have_avx512)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: avx512 will be used for memxor.\n");
+      nettle_memxor_vec = _nettle_memxor_avx512;
+      nettle_memxor3_vec = _nettle_memxor3_avx512;
+    }
+  else if (features.have_avx2)
+    {
+      if (verbose)
+	fprintf (stderr, "libnettle: avx2 will be used for memxor.\n");
+      nettle_memxor_vec = _nettle_memxor_avx2;
+      nettle_memxor3_vec = _nettle_memxor3_avx2;
+    }
+  else if (features.vendor == X86_INTEL)
     {
       if (verbose)
 	fprintf (stderr, "libnettle: intel SSE2 will be used for memxor.\n");
       nettle_memxor_vec = _nettle_memxor_sse2;
+      nettle_memxor3_vec = _nettle_memxor3_x86_64;
     }
   else
     {
       if (verbose)
 	fprintf (stderr, "libnettle: intel SSE2 will not be used for memxor.\n");
       nettle_memxor_vec = _nettle_memxor_x86_64;
+      nettle_memxor3_vec = _nettle_memxor3_x86_64;
     }
 }
 
@@ -217,6 +296,10 @@ DEFINE_FAT_FUNC(nettle_memxor, void *,
 		(void *dst, const void *src, size_t n),
 		(dst, src, n))
 
+DEFINE_FAT_FUNC(nettle_memxor3, void *,
+		(void *dst, const void *a, const void *b, size_t n),
+		(dst, a, b, n))
+
 DEFINE_FAT_FUNC(nettle_sha1_compress, void,
 		(uint32_t *state, const uint8_t *input),
 		(state, input))
@@ -224,3 +307,19 @@ DEFINE_FAT_FUNC(nettle_sha1_compress, void,
 DEFINE_FAT_FUNC(_nettle_sha256_compress, void,
 		(uint32_t *state, const uint8_t *input, const uint32_t *k),
 		(state, input, k))
+
+DEFINE_FAT_FUNC(_nettle_umac_nh_n, void,
+		(uint64_t *out, unsigned n, const uint32_t *key,
+		 unsigned length, const uint8_t *msg),
+		(out, n, key, length, msg))
+
+DEFINE_FAT_FUNC(_nettle_blake2b_compress, void,
+		(uint64_t *state, const uint8_t *block,
+		 uint64_t t_low, uint64_t t_high, uint64_t f),
+		(state, block, t_low, t_high, f))
+
+DEFINE_FAT_FUNC(_nettle_blake3_hash_chunks, void,
+		(uint32_t *cvs, const uint32_t *key,
+		 uint32_t flags, uint64_t counter,
+		 unsigned count, const uint8_t *data),
+		(cvs, key, flags, counter, count, data))
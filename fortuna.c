@@ -0,0 +1,310 @@
+/* fortuna.c
+
+   The Fortuna pseudo-randomness generator, with a ChaCha20 fast-key-erasure
+   generator.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "fortuna.h"
+#include "chacha-internal.h"
+
+#include "macros.h"
+
+#define CHACHA_ROUNDS 20
+
+/* An upper limit on the entropy (in bits) in one octet of sample
+ * data. */
+#define FORTUNA_MULTIPLIER 4
+
+/* Entropy threshold, summed over all sources, for reseeding when
+ * adding a sample to pool 0 */
+#define FORTUNA_RESEED_THRESHOLD 128
+
+/* Avoid overflow */
+#define FORTUNA_MAX_ENTROPY 0x100000
+
+/* Generates n blocks of output, starting with a zero block counter. */
+static void
+fortuna_generate(struct fortuna_ctx *ctx, size_t n, uint32_t *dst)
+{
+  size_t i;
+
+  ctx->key.state[12] = ctx->key.state[13] = 0;
+  for (i = 0; i < n; i++)
+    {
+      _chacha_core (dst + i * _CHACHA_STATE_LENGTH, ctx->key.state,
+		    CHACHA_ROUNDS);
+      ctx->key.state[13] += (++ctx->key.state[12] == 0);
+    }
+}
+
+/* Replaces the key by the hash of the old key and the given data, and
+   discards any buffered output. */
+static void
+fortuna_rekey(struct fortuna_ctx *ctx, struct sha256_ctx *hash)
+{
+  uint8_t key[CHACHA_KEY_SIZE];
+
+  sha256_digest(hash, sizeof(key), key);
+  chacha_set_key(&ctx->key, key);
+  memset(key, 0, sizeof(key));
+
+  memset(ctx->buffer, 0, sizeof(ctx->buffer));
+  ctx->index = FORTUNA_BUFFER_SIZE;
+  ctx->seeded = 1;
+}
+
+static void
+fortuna_hash_key(struct fortuna_ctx *ctx, struct sha256_ctx *hash)
+{
+  uint8_t key[CHACHA_KEY_SIZE];
+  unsigned i;
+
+  for (i = 0; i < CHACHA_KEY_SIZE / 4; i++)
+    LE_WRITE_UINT32(key + 4*i, ctx->key.state[4 + i]);
+
+  sha256_init(hash);
+  sha256_update(hash, sizeof(key), key);
+  memset(key, 0, sizeof(key));
+}
+
+void
+fortuna_init(struct fortuna_ctx *ctx,
+	     unsigned nsources,
+	     struct fortuna_source *sources)
+{
+  static const uint8_t zero_key[CHACHA_KEY_SIZE];
+  unsigned i;
+
+  for (i = 0; i < FORTUNA_POOLS; i++)
+    sha256_init(&ctx->pools[i]);
+  ctx->reseed_count = 0;
+
+  ctx->seeded = 0;
+
+  memset(&ctx->key, 0, sizeof(ctx->key));
+  chacha_set_key(&ctx->key, zero_key);
+  memset(ctx->buffer, 0, sizeof(ctx->buffer));
+  ctx->index = FORTUNA_BUFFER_SIZE;
+
+  ctx->nsources = nsources;
+  ctx->sources = sources;
+
+  for (i = 0; i<nsources; i++)
+    {
+      ctx->sources[i].pool0_estimate = 0;
+      ctx->sources[i].total_estimate = 0;
+      ctx->sources[i].next_pool = 0;
+    }
+}
+
+void
+fortuna_seed(struct fortuna_ctx *ctx,
+	     size_t length,
+	     const uint8_t *seed_file)
+{
+  struct sha256_ctx hash;
+
+  assert(length > 0);
+
+  fortuna_hash_key(ctx, &hash);
+  sha256_update(&hash, length, seed_file);
+  fortuna_rekey(ctx, &hash);
+}
+
+void
+fortuna_reseed(struct fortuna_ctx *ctx)
+{
+  struct sha256_ctx hash;
+  uint8_t digest[SHA256_DIGEST_SIZE];
+  unsigned i;
+
+  ctx->reseed_count++;
+
+  /* Pool i is used if 2^i divides the reseed count. Getting the
+     digest also resets the pool. */
+  fortuna_hash_key(ctx, &hash);
+  for (i = 0; i < FORTUNA_POOLS; i++)
+    {
+      sha256_digest(&ctx->pools[i], sizeof(digest), digest);
+      sha256_update(&hash, sizeof(digest), digest);
+      if ((ctx->reseed_count >> i) & 1)
+	break;
+    }
+  fortuna_rekey(ctx, &hash);
+
+  /* Reset estimates. */
+  for (i = 0; i<ctx->nsources; i++)
+    ctx->sources[i].pool0_estimate = 0;
+}
+
+static void
+fortuna_add_estimate(uint32_t *estimate, unsigned entropy, size_t length)
+{
+  /* NOTE: We should be careful to avoid overflows in the estimates. */
+  if (*estimate < FORTUNA_MAX_ENTROPY)
+    {
+      if (entropy > FORTUNA_MAX_ENTROPY)
+	entropy = FORTUNA_MAX_ENTROPY;
+
+      if ( (length < (FORTUNA_MAX_ENTROPY / FORTUNA_MULTIPLIER))
+	   && (entropy > FORTUNA_MULTIPLIER * length) )
+	entropy = FORTUNA_MULTIPLIER * length;
+
+      entropy += *estimate;
+      if (entropy > FORTUNA_MAX_ENTROPY)
+	entropy = FORTUNA_MAX_ENTROPY;
+
+      *estimate = entropy;
+    }
+}
+
+int
+fortuna_update(struct fortuna_ctx *ctx,
+	       unsigned source_index, unsigned entropy,
+	       size_t length, const uint8_t *data)
+{
+  struct fortuna_source *source;
+  uint8_t header[8];
+  unsigned current;
+  unsigned total;
+  unsigned i;
+
+  assert(source_index < ctx->nsources);
+
+  if (!length)
+    /* Nothing happens */
+    return 0;
+
+  source = &ctx->sources[source_index];
+
+  if (!ctx->seeded)
+    /* While seeding, use pool 0 only */
+    current = 0;
+  else
+    {
+      /* Each source cycles through the pools independently. */
+      current = source->next_pool;
+      source->next_pool = (current + 1) % FORTUNA_POOLS;
+    }
+
+  WRITE_UINT32(header, source_index);
+  WRITE_UINT32(header + 4, length);
+  sha256_update(&ctx->pools[current], sizeof(header), header);
+  sha256_update(&ctx->pools[current], length, data);
+
+  fortuna_add_estimate(&source->total_estimate, entropy, length);
+  if (current > 0)
+    return 0;
+
+  fortuna_add_estimate(&source->pool0_estimate, entropy, length);
+
+  for (i = total = 0; i < ctx->nsources; i++)
+    total += ctx->sources[i].pool0_estimate;
+
+  if (total >= FORTUNA_RESEED_THRESHOLD)
+    {
+      fortuna_reseed(ctx);
+      return 1;
+    }
+  else
+    return 0;
+}
+
+void
+fortuna_random(struct fortuna_ctx *ctx, size_t length, uint8_t *dst)
+{
+  uint8_t *buffer = (uint8_t *) ctx->buffer;
+
+  assert(ctx->seeded);
+
+  for (;;)
+    {
+      unsigned left = FORTUNA_BUFFER_SIZE - ctx->index;
+      if (length <= left)
+	{
+	  memcpy(dst, buffer + ctx->index, length);
+	  memset(buffer + ctx->index, 0, length);
+	  ctx->index += length;
+	  return;
+	}
+      memcpy(dst, buffer + ctx->index, left);
+      memset(buffer + ctx->index, 0, left);
+      dst += left;
+      length -= left;
+
+      if (length >= FORTUNA_BUFFER_SIZE)
+	{
+	  /* Large requests bypass the buffer. Block 0 is the next key,
+	     and the following blocks are written to the output. */
+	  uint32_t key[_CHACHA_STATE_LENGTH];
+	  uint32_t x[_CHACHA_STATE_LENGTH];
+	  size_t blocks = length / CHACHA_BLOCK_SIZE;
+	  size_t i;
+
+	  fortuna_generate(ctx, 1, key);
+	  for (i = 0; i < blocks; i++)
+	    {
+	      _chacha_core (x, ctx->key.state, CHACHA_ROUNDS);
+	      ctx->key.state[13] += (++ctx->key.state[12] == 0);
+	      memcpy(dst + i * CHACHA_BLOCK_SIZE, x, CHACHA_BLOCK_SIZE);
+	    }
+	  chacha_set_key(&ctx->key, (const uint8_t *) key);
+	  memset(key, 0, sizeof(key));
+	  memset(x, 0, sizeof(x));
+
+	  dst += blocks * CHACHA_BLOCK_SIZE;
+	  length -= blocks * CHACHA_BLOCK_SIZE;
+	  ctx->index = FORTUNA_BUFFER_SIZE;
+	}
+      else
+	{
+	  fortuna_generate(ctx, FORTUNA_BUFFER_SIZE / CHACHA_BLOCK_SIZE,
+			   ctx->buffer);
+	  chacha_set_key(&ctx->key, buffer);
+	  memset(buffer, 0, CHACHA_KEY_SIZE);
+	  ctx->index = CHACHA_KEY_SIZE;
+	}
+    }
+}
+
+int
+fortuna_is_seeded(struct fortuna_ctx *ctx)
+{
+  return ctx->seeded;
+}
@@ -0,0 +1,119 @@
+/* fortuna.h
+
+   The Fortuna pseudo-randomness generator, with a ChaCha20 fast-key-erasure
+   generator.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+ 
+#ifndef NETTLE_FORTUNA_H_INCLUDED
+#define NETTLE_FORTUNA_H_INCLUDED
+
+#include "chacha.h"
+#include "sha2.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Name mangling */
+#define fortuna_init nettle_fortuna_init
+#define fortuna_seed nettle_fortuna_seed
+#define fortuna_update nettle_fortuna_update
+#define fortuna_random nettle_fortuna_random
+#define fortuna_is_seeded nettle_fortuna_is_seeded
+#define fortuna_reseed nettle_fortuna_reseed
+
+#define FORTUNA_POOLS 32
+
+/* Output is generated this many octets at a time. The first
+   CHACHA_KEY_SIZE octets of each buffer become the next key. */
+#define FORTUNA_BUFFER_SIZE (12 * CHACHA_BLOCK_SIZE)
+
+struct fortuna_source
+{
+  /* Entropy added to pool 0 since the last reseed, and in total. */
+  uint32_t pool0_estimate;
+  uint32_t total_estimate;
+
+  /* The pool the next sample goes to. */
+  unsigned next_pool;
+};
+
+/* Fortuna, with pools based on SHA-256, and a generator based on
+   ChaCha20. */
+struct fortuna_ctx
+{
+  struct sha256_ctx pools[FORTUNA_POOLS];
+  uint32_t reseed_count;
+
+  int seeded;
+
+  /* The current key, and unused output in
+     buffer[index ... FORTUNA_BUFFER_SIZE - 1]. */
+  struct chacha_ctx key;
+  unsigned index;
+  uint32_t buffer[FORTUNA_BUFFER_SIZE / 4];
+
+  /* The entropy sources */
+  unsigned nsources;
+  struct fortuna_source *sources;
+};
+
+void
+fortuna_init(struct fortuna_ctx *ctx,
+	     unsigned nsources,
+	     struct fortuna_source *sources);
+
+void
+fortuna_seed(struct fortuna_ctx *ctx,
+	     size_t length,
+	     const uint8_t *seed_file);
+
+/* Returns 1 on reseed */
+int
+fortuna_update(struct fortuna_ctx *ctx,
+	       unsigned source, unsigned entropy,
+	       size_t length, const uint8_t *data);
+
+void
+fortuna_random(struct fortuna_ctx *ctx, size_t length, uint8_t *dst);
+
+int
+fortuna_is_seeded(struct fortuna_ctx *ctx);
+
+void
+fortuna_reseed(struct fortuna_ctx *ctx);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETTLE_FORTUNA_H_INCLUDED */
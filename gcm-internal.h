@@ -0,0 +1,51 @@
+/* gcm-internal.h
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_GCM_INTERNAL_H_INCLUDED
+#define NETTLE_GCM_INTERNAL_H_INCLUDED
+
+#include "gcm.h"
+
+/* Name mangling */
+#define _ghash_set_key _nettle_ghash_set_key
+#define _ghash_update _nettle_ghash_update
+
+/* The GHASH function, for use by other constructions than GCM. Sets
+   up the key tables for the hash subkey H. */
+void
+_ghash_set_key (struct gcm_key *key, const union nettle_block16 *h);
+
+/* Updates the state x. A final partial block is zero padded. */
+void
+_ghash_update (const struct gcm_key *key, union nettle_block16 *x,
+	       size_t length, const uint8_t *data);
+
+#endif /* NETTLE_GCM_INTERNAL_H_INCLUDED */
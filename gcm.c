@@ -48,6 +48,7 @@
 #include <string.h>
 
 #include "gcm.h"
+#include "gcm-internal.h"
 
 #include "memxor.h"
 #include "nettle-internal.h"
@@ -337,17 +338,15 @@ gcm_gf_mul (union nettle_block16 *x, const union nettle_block16 *table)
  * @f: The underlying cipher encryption function
  */
 void
-gcm_set_key(struct gcm_key *key,
-	    const void *cipher, nettle_cipher_func *f)
+_ghash_set_key (struct gcm_key *key, const union nettle_block16 *h)
 {
   /* Middle element if GCM_TABLE_BITS > 0, otherwise the first
      element */
   unsigned i = (1<<GCM_TABLE_BITS)/2;
 
-  /* H */  
   memset(key->h[0].b, 0, GCM_BLOCK_SIZE);
-  f (cipher, GCM_BLOCK_SIZE, key->h[i].b, key->h[0].b);
-  
+  key->h[i] = *h;
+
 #if GCM_TABLE_BITS
   /* Algorithm 3 from the gcm paper. First do powers of two, then do
      the rest by adding. */
@@ -362,6 +361,19 @@ gcm_set_key(struct gcm_key *key,
 #endif
 }
 
+void
+gcm_set_key(struct gcm_key *key,
+	    const void *cipher, nettle_cipher_func *f)
+{
+  union nettle_block16 h;
+
+  /* H */
+  memset(h.b, 0, GCM_BLOCK_SIZE);
+  f (cipher, GCM_BLOCK_SIZE, h.b, h.b);
+
+  _ghash_set_key (key, &h);
+}
+
 #ifndef gcm_hash
 static void
 gcm_hash(const struct gcm_key *key, union nettle_block16 *x,
@@ -381,6 +393,13 @@ gcm_hash(const struct gcm_key *key, union nettle_block16 *x,
 }
 #endif /* !gcm_hash */
 
+void
+_ghash_update (const struct gcm_key *key, union nettle_block16 *x,
+	       size_t length, const uint8_t *data)
+{
+  gcm_hash (key, x, length, data);
+}
+
 static void
 gcm_hash_sizes(const struct gcm_key *key, union nettle_block16 *x,
 	       uint64_t auth_size, uint64_t data_size)
@@ -311,6 +311,56 @@ mpn_get_base256_le (uint8_t *rp, size_t rn,
     }
 }
 
+static mp_limb_t
+read_limb_be (const uint8_t *p)
+{
+  mp_limb_t x;
+  unsigned i;
+  for (i = x = 0; i < sizeof(mp_limb_t); i++)
+    x = (x << 8) | p[i];
+  return x;
+}
+
+static void
+write_limb_be (uint8_t *p, mp_limb_t x)
+{
+  unsigned i;
+  for (i = sizeof(mp_limb_t); i > 0; x >>= 8)
+    p[--i] = x;
+}
+
+/* Limb i is stored in the octets of limb n - 1 - i, so the limbs are
+   processed pairwise from both ends, reading both before writing. */
+void
+mpn_set_base256_in_place (mp_limb_t *xp, mp_size_t n)
+{
+  uint8_t *p = (uint8_t *) xp;
+  mp_size_t i, j;
+
+  for (i = 0, j = n - 1; i <= j; i++, j--)
+    {
+      mp_limb_t lo = read_limb_be (p + j * sizeof(mp_limb_t));
+      mp_limb_t hi = read_limb_be (p + i * sizeof(mp_limb_t));
+      xp[i] = lo;
+      xp[j] = hi;
+    }
+}
+
+void
+mpn_get_base256_in_place (mp_limb_t *xp, mp_size_t n)
+{
+  uint8_t *p = (uint8_t *) xp;
+  mp_size_t i, j;
+
+  for (i = 0, j = n - 1; i <= j; i++, j--)
+    {
+      mp_limb_t lo = xp[i];
+      mp_limb_t hi = xp[j];
+      write_limb_be (p + j * sizeof(mp_limb_t), lo);
+      write_limb_be (p + i * sizeof(mp_limb_t), hi);
+    }
+}
+
 mp_limb_t *
 gmp_alloc_limbs (mp_size_t n)
 {
@@ -59,6 +59,8 @@
 #define mpn_set_base256_le _nettle_mpn_set_base256_le
 #define mpn_get_base256 _nettle_mpn_get_base256
 #define mpn_get_base256_le _nettle_mpn_get_base256_le
+#define mpn_set_base256_in_place _nettle_mpn_set_base256_in_place
+#define mpn_get_base256_in_place _nettle_mpn_get_base256_in_place
 #define gmp_alloc_limbs _nettle_gmp_alloc_limbs
 #define gmp_free_limbs _nettle_gmp_free_limbs
 #define gmp_free _nettle_gmp_free
@@ -159,6 +161,14 @@ void
 mpn_get_base256_le (uint8_t *rp, size_t rn,
 		    const mp_limb_t *xp, mp_size_t xn);
 
+/* In-place conversions between n limbs, and the n * sizeof(mp_limb_t)
+   octets, big-endian, occupying the same storage. */
+void
+mpn_set_base256_in_place (mp_limb_t *xp, mp_size_t n);
+
+void
+mpn_get_base256_in_place (mp_limb_t *xp, mp_size_t n);
+
 
 mp_limb_t *
 gmp_alloc_limbs (mp_size_t n);
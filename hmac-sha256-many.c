@@ -0,0 +1,178 @@
+/* hmac-sha256-many.c
+
+   HMAC-SHA256 of many messages in parallel.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "hmac.h"
+
+#include "macros.h"
+#include "sha2-internal.h"
+
+#define LANES _SHA256_LANES
+
+/* Processes up to LANES messages, m > 0. Unused lanes repeat the
+   first message, and their results are discarded. */
+static void
+hmac_sha256_lanes (unsigned m,
+		   const struct hmac_sha256_key * const *keys,
+		   const size_t *lengths, const uint8_t * const *messages,
+		   size_t digest_length, uint8_t *digests)
+{
+  uint32_t state[_SHA256_DIGEST_LENGTH][LANES];
+  uint32_t next[_SHA256_DIGEST_LENGTH][LANES];
+  /* The last partial block of each message, with the padding. */
+  uint8_t tail[LANES][2*SHA256_BLOCK_SIZE];
+  const uint8_t *data[LANES];
+  size_t full[LANES];
+  size_t blocks[LANES];
+  size_t min_blocks, max_blocks;
+  size_t j;
+  unsigned i, l;
+
+  assert (digest_length <= SHA256_DIGEST_SIZE);
+
+  for (l = 0; l < LANES; l++)
+    {
+      unsigned k = l < m ? l : 0;
+      size_t length = lengths[k];
+      size_t left = length % SHA256_BLOCK_SIZE;
+      uint8_t *end;
+
+      full[l] = length / SHA256_BLOCK_SIZE;
+      memcpy (tail[l], messages[k] + full[l] * SHA256_BLOCK_SIZE, left);
+      tail[l][left++] = 0x80;
+      if (left > SHA256_BLOCK_SIZE - 8)
+	{
+	  blocks[l] = full[l] + 2;
+	  end = tail[l] + 2*SHA256_BLOCK_SIZE;
+	}
+      else
+	{
+	  blocks[l] = full[l] + 1;
+	  end = tail[l] + SHA256_BLOCK_SIZE;
+	}
+      memset (tail[l] + left, 0, end - 8 - (tail[l] + left));
+      /* The inner hash includes the key block. */
+      WRITE_UINT64 (end - 8, (uint64_t) (SHA256_BLOCK_SIZE + length) << 3);
+
+      for (i = 0; i < _SHA256_DIGEST_LENGTH; i++)
+	state[i][l] = keys[k]->inner[i];
+    }
+
+  for (l = 1, min_blocks = max_blocks = blocks[0]; l < LANES; l++)
+    {
+      if (blocks[l] < min_blocks)
+	min_blocks = blocks[l];
+      if (blocks[l] > max_blocks)
+	max_blocks = blocks[l];
+    }
+
+  for (j = 0; j < max_blocks; j++)
+    {
+      for (l = 0; l < LANES; l++)
+	{
+	  unsigned k = l < m ? l : 0;
+	  if (j < full[l])
+	    data[l] = messages[k] + j * SHA256_BLOCK_SIZE;
+	  else if (j < blocks[l])
+	    data[l] = tail[l] + (j - full[l]) * SHA256_BLOCK_SIZE;
+	  else
+	    data[l] = tail[l];
+	}
+      if (j < min_blocks)
+	_nettle_sha256_compress_lanes (state, data);
+      else
+	{
+	  /* Some lanes are done, keep their state. */
+	  memcpy (next, state, sizeof(next));
+	  _nettle_sha256_compress_lanes (next, data);
+	  for (l = 0; l < LANES; l++)
+	    if (j < blocks[l])
+	      for (i = 0; i < _SHA256_DIGEST_LENGTH; i++)
+		state[i][l] = next[i][l];
+	}
+    }
+
+  /* Outer hash, of the inner digest and fixed padding. */
+  for (l = 0; l < LANES; l++)
+    {
+      unsigned k = l < m ? l : 0;
+
+      for (i = 0; i < _SHA256_DIGEST_LENGTH; i++)
+	{
+	  WRITE_UINT32 (tail[l] + 4*i, state[i][l]);
+	  state[i][l] = keys[k]->outer[i];
+	}
+      tail[l][SHA256_DIGEST_SIZE] = 0x80;
+      memset (tail[l] + SHA256_DIGEST_SIZE + 1, 0,
+	      SHA256_BLOCK_SIZE - 8 - SHA256_DIGEST_SIZE - 1);
+      WRITE_UINT64 (tail[l] + SHA256_BLOCK_SIZE - 8,
+		    (uint64_t) (SHA256_BLOCK_SIZE + SHA256_DIGEST_SIZE) << 3);
+      data[l] = tail[l];
+    }
+  _nettle_sha256_compress_lanes (state, data);
+
+  for (l = 0; l < m; l++, digests += digest_length)
+    {
+      uint8_t digest[SHA256_DIGEST_SIZE];
+      for (i = 0; i < _SHA256_DIGEST_LENGTH; i++)
+	WRITE_UINT32 (digest + 4*i, state[i][l]);
+      memcpy (digests, digest, digest_length);
+    }
+}
+
+void
+hmac_sha256_many(size_t n,
+		 const struct hmac_sha256_key * const *keys,
+		 const size_t *lengths, const uint8_t * const *messages,
+		 size_t digest_length, uint8_t *digests)
+{
+  assert (digest_length <= SHA256_DIGEST_SIZE);
+
+  for (; n >= LANES; n -= LANES)
+    {
+      hmac_sha256_lanes (LANES, keys, lengths, messages,
+			 digest_length, digests);
+      keys += LANES;
+      lengths += LANES;
+      messages += LANES;
+      digests += LANES * digest_length;
+    }
+  if (n > 0)
+    hmac_sha256_lanes (n, keys, lengths, messages, digest_length, digests);
+}
@@ -3,6 +3,7 @@
    HMAC-SHA256 message authentication code.
 
    Copyright (C) 2003 Niels Möller
+   Copyright (C) 2026 agent
 
    This file is part of GNU Nettle.
 
@@ -35,8 +36,55 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
+#include <string.h>
+
 #include "hmac.h"
 
+#include "macros.h"
+#include "memxor.h"
+#include "nettle-write.h"
+#include "sha2-internal.h"
+
+#define IPAD 0x36
+#define OPAD 0x5c
+
+/* Completes a hash started from one of the midstates, i.e., after
+   one block, and writes the digest. The full blocks of data are
+   compressed directly from the input, only the final block is
+   copied. */
+static void
+hmac_sha256_midstate_digest (const uint32_t *midstate,
+			     size_t length, const uint8_t *data,
+			     size_t digest_length, uint8_t *digest)
+{
+  uint32_t state[_SHA256_DIGEST_LENGTH];
+  uint8_t block[SHA256_BLOCK_SIZE];
+  uint64_t bit_count = (uint64_t) (SHA256_BLOCK_SIZE + length) << 3;
+
+  assert (digest_length <= SHA256_DIGEST_SIZE);
+
+  memcpy (state, midstate, sizeof(state));
+
+  for (; length >= SHA256_BLOCK_SIZE;
+       length -= SHA256_BLOCK_SIZE, data += SHA256_BLOCK_SIZE)
+    _nettle_sha256_compress_block (state, data);
+
+  memcpy (block, data, length);
+  block[length++] = 0x80;
+  if (length > SHA256_BLOCK_SIZE - 8)
+    {
+      memset (block + length, 0, SHA256_BLOCK_SIZE - length);
+      _nettle_sha256_compress_block (state, block);
+      length = 0;
+    }
+  memset (block + length, 0, SHA256_BLOCK_SIZE - 8 - length);
+  WRITE_UINT64 (block + SHA256_BLOCK_SIZE - 8, bit_count);
+  _nettle_sha256_compress_block (state, block);
+
+  _nettle_write_be32 (digest_length, digest, state);
+}
+
 void
 hmac_sha256_set_key(struct hmac_sha256_ctx *ctx,
 		    size_t key_length, const uint8_t *key)
@@ -51,9 +99,78 @@ hmac_sha256_update(struct hmac_sha256_ctx *ctx,
   sha256_update(&ctx->state, length, data);
 }
 
+/* Like HMAC_DIGEST, but the outer hash is done directly from the
+   outer midstate, and only the inner midstate is copied to reset the
+   context. */
 void
 hmac_sha256_digest(struct hmac_sha256_ctx *ctx,
 		   size_t length, uint8_t *digest)
 {
-  HMAC_DIGEST(ctx, &nettle_sha256, length, digest);
+  uint8_t inner[SHA256_DIGEST_SIZE];
+
+  sha256_digest (&ctx->state, SHA256_DIGEST_SIZE, inner);
+  hmac_sha256_midstate_digest (ctx->outer.state, sizeof(inner), inner,
+			       length, digest);
+
+  memcpy (ctx->state.state, ctx->inner.state, sizeof(ctx->state.state));
+  ctx->state.count = 1;
+  ctx->state.index = 0;
+}
+
+void
+hmac_sha256_key_set(struct hmac_sha256_key *key,
+		    size_t key_length, const uint8_t *key_data)
+{
+  struct sha256_ctx ctx;
+  uint8_t pad[SHA256_BLOCK_SIZE];
+  uint8_t digest[SHA256_DIGEST_SIZE];
+
+  if (key_length > SHA256_BLOCK_SIZE)
+    {
+      sha256_init (&ctx);
+      sha256_update (&ctx, key_length, key_data);
+      sha256_digest (&ctx, SHA256_DIGEST_SIZE, digest);
+      key_data = digest;
+      key_length = SHA256_DIGEST_SIZE;
+    }
+
+  memset (pad, IPAD, sizeof(pad));
+  memxor (pad, key_data, key_length);
+  sha256_init (&ctx);
+  _nettle_sha256_compress_block (ctx.state, pad);
+  memcpy (key->inner, ctx.state, sizeof(key->inner));
+
+  memset (pad, OPAD, sizeof(pad));
+  memxor (pad, key_data, key_length);
+  sha256_init (&ctx);
+  _nettle_sha256_compress_block (ctx.state, pad);
+  memcpy (key->outer, ctx.state, sizeof(key->outer));
+}
+
+void
+hmac_sha256_load_key(struct hmac_sha256_ctx *ctx,
+		     const struct hmac_sha256_key *key)
+{
+  memcpy (ctx->outer.state, key->outer, sizeof(key->outer));
+  ctx->outer.count = 1;
+  ctx->outer.index = 0;
+
+  memcpy (ctx->inner.state, key->inner, sizeof(key->inner));
+  ctx->inner.count = 1;
+  ctx->inner.index = 0;
+
+  ctx->state = ctx->inner;
+}
+
+void
+hmac_sha256(const struct hmac_sha256_key *key,
+	    size_t length, const uint8_t *data,
+	    size_t digest_length, uint8_t *digest)
+{
+  uint8_t inner[SHA256_DIGEST_SIZE];
+
+  hmac_sha256_midstate_digest (key->inner, length, data,
+			       sizeof(inner), inner);
+  hmac_sha256_midstate_digest (key->outer, sizeof(inner), inner,
+			       digest_length, digest);
 }
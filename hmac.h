@@ -63,6 +63,10 @@ extern "C" {
 #define hmac_sha256_set_key nettle_hmac_sha256_set_key
 #define hmac_sha256_update nettle_hmac_sha256_update
 #define hmac_sha256_digest nettle_hmac_sha256_digest
+#define hmac_sha256_key_set nettle_hmac_sha256_key_set
+#define hmac_sha256_load_key nettle_hmac_sha256_load_key
+#define hmac_sha256 nettle_hmac_sha256
+#define hmac_sha256_many nettle_hmac_sha256_many
 #define hmac_sha384_set_key nettle_hmac_sha384_set_key
 #define hmac_sha384_digest nettle_hmac_sha384_digest
 #define hmac_sha512_set_key nettle_hmac_sha512_set_key
@@ -162,6 +166,40 @@ void
 hmac_sha256_digest(struct hmac_sha256_ctx *ctx,
 		   size_t length, uint8_t *digest);
 
+/* A prepared key, holding only the midstates after the inner and
+   outer pad blocks. Can be shared between threads. */
+struct hmac_sha256_key
+{
+  uint32_t inner[_SHA256_DIGEST_LENGTH];
+  uint32_t outer[_SHA256_DIGEST_LENGTH];
+};
+
+void
+hmac_sha256_key_set(struct hmac_sha256_key *key,
+		    size_t key_length, const uint8_t *key_data);
+
+/* Sets up ctx for use with hmac_sha256_update and
+   hmac_sha256_digest, equivalent to hmac_sha256_set_key with the
+   original key. */
+void
+hmac_sha256_load_key(struct hmac_sha256_ctx *ctx,
+		     const struct hmac_sha256_key *key);
+
+/* One-shot HMAC-SHA256 of a complete message. */
+void
+hmac_sha256(const struct hmac_sha256_key *key,
+	    size_t length, const uint8_t *data,
+	    size_t digest_length, uint8_t *digest);
+
+/* HMAC-SHA256 of n independent messages, each with its own key,
+   computed several at a time. The digests are stored one after
+   another, digest_length octets each. */
+void
+hmac_sha256_many(size_t n,
+		 const struct hmac_sha256_key * const *keys,
+		 const size_t *lengths, const uint8_t * const *messages,
+		 size_t digest_length, uint8_t *digests);
+
 /* hmac-sha224 */
 #define hmac_sha224_ctx hmac_sha256_ctx
 
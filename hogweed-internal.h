@@ -42,7 +42,33 @@ _nettle_generate_pocklington_prime (mpz_t p, mpz_t r,
 				    const mpz_t q,
 				    const mpz_t p0q);
 
+void
+_nettle_generate_pocklington_prime_sieve (mpz_t p, mpz_t r,
+					  unsigned bits, int top_bits_set,
+					  void *ctx, nettle_random_func *random,
+					  const mpz_t p0,
+					  const mpz_t q,
+					  const mpz_t p0q);
+
+void
+_nettle_random_prime_sieve (mpz_t p, unsigned bits, int top_bits_set,
+			    void *random_ctx, nettle_random_func *random,
+			    void *progress_ctx, nettle_progress_func *progress);
+
+/* In bignum-backend.c */
+#define _bignum_sec_powm _nettle_bignum_sec_powm
+#define _bignum_sec_invert _nettle_bignum_sec_invert
+
+/* Side-channel silent r = b^e (mod m). Requires e > 0 and an odd
+   m > 1; unlike mpz_powm, other moduli are not handled. */
+void
+_bignum_sec_powm (mpz_t r, const mpz_t b, const mpz_t e, const mpz_t m);
+
+int
+_bignum_sec_invert (mpz_t r, const mpz_t a, const mpz_t m);
+
 #define _pkcs1_signature_prefix _nettle_pkcs1_signature_prefix
+#define _pkcs1_signature_check _nettle_pkcs1_signature_check
 
 uint8_t *
 _pkcs1_signature_prefix(unsigned key_size,
@@ -51,4 +77,12 @@ _pkcs1_signature_prefix(unsigned key_size,
 			const uint8_t *id,
 			unsigned digest_size);
 
+int
+_pkcs1_signature_check(unsigned key_size,
+		       const uint8_t *em,
+		       unsigned id_size,
+		       const uint8_t *id,
+		       unsigned digest_size,
+		       const uint8_t *digest);
+
 #endif /* NETTLE_HOGWEED_INTERNAL_H_INCLUDED */
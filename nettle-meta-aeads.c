@@ -44,6 +44,7 @@ const struct nettle_aead * const _nettle_aeads[] = {
   &nettle_gcm_camellia128,
   &nettle_gcm_camellia256,
   &nettle_eax_aes128,
+  &nettle_ocb_aes128,
   &nettle_chacha_poly1305,
   NULL
 };
@@ -53,3 +54,15 @@ nettle_get_aeads (void)
 {
   return _nettle_aeads;
 }
+
+const struct nettle_aead_message * const _nettle_aead_messages[] = {
+  &nettle_siv_gcm_aes128,
+  &nettle_siv_gcm_aes256,
+  NULL
+};
+
+const struct nettle_aead_message * const *
+nettle_get_aead_messages (void)
+{
+  return _nettle_aead_messages;
+}
@@ -36,6 +36,8 @@
 #include <stddef.h>
 #include "nettle-meta.h"
 
+#include "nettle-internal.h"
+
 const struct nettle_armor * const _nettle_armors[] = {
   &nettle_base64,
   &nettle_base64url,
@@ -48,3 +50,33 @@ nettle_get_armors (void)
 {
   return _nettle_armors;
 }
+
+size_t
+nettle_armor_encode (const struct nettle_armor *armor,
+		     char *dst, size_t length, const uint8_t *src)
+{
+  TMP_DECL_ALIGN(ctx, NETTLE_MAX_ARMOR_CONTEXT_SIZE);
+  size_t done;
+
+  TMP_ALLOC_ALIGN(ctx, armor->encode_context_size);
+
+  armor->encode_init (ctx);
+  done = armor->encode_update (ctx, dst, length, src);
+  done += armor->encode_final (ctx, dst + done);
+
+  return done;
+}
+
+int
+nettle_armor_decode (const struct nettle_armor *armor,
+		     size_t *dst_length, uint8_t *dst,
+		     size_t length, const char *src)
+{
+  TMP_DECL_ALIGN(ctx, NETTLE_MAX_ARMOR_CONTEXT_SIZE);
+
+  TMP_ALLOC_ALIGN(ctx, armor->decode_context_size);
+
+  armor->decode_init (ctx);
+  return (armor->decode_update (ctx, dst_length, dst, length, src)
+	  && armor->decode_final (ctx));
+}
@@ -51,6 +51,9 @@ const struct nettle_hash * const _nettle_hashes[] = {
   &nettle_sha3_256,
   &nettle_sha3_384,
   &nettle_sha3_512,
+  &nettle_blake2b_512,
+  &nettle_blake2s_256,
+  &nettle_blake3_256,
   NULL
 };
 
@@ -142,6 +142,9 @@ extern const struct nettle_hash nettle_sha3_224;
 extern const struct nettle_hash nettle_sha3_256;
 extern const struct nettle_hash nettle_sha3_384;
 extern const struct nettle_hash nettle_sha3_512;
+extern const struct nettle_hash nettle_blake2b_512;
+extern const struct nettle_hash nettle_blake2s_256;
+extern const struct nettle_hash nettle_blake3_256;
 
 struct nettle_aead
 {
@@ -177,8 +180,35 @@ extern const struct nettle_aead nettle_gcm_aes256;
 extern const struct nettle_aead nettle_gcm_camellia128;
 extern const struct nettle_aead nettle_gcm_camellia256;
 extern const struct nettle_aead nettle_eax_aes128;
+extern const struct nettle_aead nettle_ocb_aes128;
 extern const struct nettle_aead nettle_chacha_poly1305;
 
+/* AEAD constructions processing a complete message at a time. */
+struct nettle_aead_message
+{
+  const char *name;
+
+  unsigned context_size;
+  unsigned key_size;
+  unsigned nonce_size;
+  unsigned digest_size;
+
+  nettle_set_key_func *set_encrypt_key;
+  nettle_set_key_func *set_decrypt_key;
+  nettle_encrypt_message_func *encrypt;
+  nettle_decrypt_message_func *decrypt;
+};
+
+/* null-terminated list of message aead constructions implemented by
+   this version of nettle */
+const struct nettle_aead_message * const * _NETTLE_ATTRIBUTE_PURE
+nettle_get_aead_messages (void);
+
+#define nettle_aead_messages (nettle_get_aead_messages())
+
+extern const struct nettle_aead_message nettle_siv_gcm_aes128;
+extern const struct nettle_aead_message nettle_siv_gcm_aes256;
+
 struct nettle_armor
 {
   const char *name;
@@ -238,6 +268,20 @@ extern const struct nettle_armor nettle_base64;
 extern const struct nettle_armor nettle_base64url;
 extern const struct nettle_armor nettle_base16;
 
+/* Encodes a complete buffer, including the final padding, and
+   returns the number of characters written. The output is at most
+   encode_length(length) + encode_final_length characters. */
+size_t
+nettle_armor_encode (const struct nettle_armor *armor,
+		     char *dst, size_t length, const uint8_t *src);
+
+/* Decodes a complete buffer. Returns 1 on success, 0 on errors,
+   including truncated input. */
+int
+nettle_armor_decode (const struct nettle_armor *armor,
+		     size_t *dst_length, uint8_t *dst,
+		     size_t length, const char *src);
+
 #ifdef __cplusplus
 }
 #endif
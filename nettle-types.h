@@ -98,6 +98,21 @@ typedef void nettle_hash_update_func(void *ctx,
 typedef void nettle_hash_digest_func(void *ctx,
 				     size_t length, uint8_t *dst);
 
+/* Message oriented AEAD, for constructions like SIV which need the
+   complete message. The ciphertext includes the tag, so clength is
+   the message length plus the tag length. Decryption returns 1 if the
+   tag is valid. */
+typedef void nettle_encrypt_message_func(const void *ctx,
+					 size_t nlength, const uint8_t *nonce,
+					 size_t alength, const uint8_t *adata,
+					 size_t clength, uint8_t *dst,
+					 const uint8_t *src);
+typedef int nettle_decrypt_message_func(const void *ctx,
+					size_t nlength, const uint8_t *nonce,
+					size_t alength, const uint8_t *adata,
+					size_t mlength, uint8_t *dst,
+					const uint8_t *src);
+
 /* ASCII armor codecs. NOTE: Experimental and subject to change. */
 
 typedef size_t nettle_armor_length_func(size_t length);
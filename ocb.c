@@ -0,0 +1,303 @@
+/* ocb.c
+
+   OCB AEAD mode, RFC 7253
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "ocb.h"
+
+#include "macros.h"
+#include "memxor.h"
+
+/* Number of blocks passed to the cipher in a single call. */
+#define OCB_BATCH 16
+
+#define MIN(x,y) ((x)<(y)?(x):(y))
+
+static void
+block16_xor (union nettle_block16 *dst, const union nettle_block16 *src)
+{
+  dst->w[0] ^= src->w[0];
+  dst->w[1] ^= src->w[1];
+#if SIZEOF_LONG == 4
+  dst->w[2] ^= src->w[2];
+  dst->w[3] ^= src->w[3];
+#endif
+}
+
+/* Doubling in GF(2^128), with the same polynomial as CMAC. */
+static void
+block16_mulx (union nettle_block16 *dst, const union nettle_block16 *src)
+{
+  uint64_t b1 = READ_UINT64(src->b);
+  uint64_t b2 = READ_UINT64(src->b+8);
+
+  b1 = (b1 << 1) | (b2 >> 63);
+  b2 <<= 1;
+
+  if (src->b[0] & 0x80)
+    b2 ^= 0x87;
+
+  WRITE_UINT64(dst->b, b1);
+  WRITE_UINT64(dst->b+8, b2);
+}
+
+void
+ocb_set_key (struct ocb_key *key, const void *cipher, nettle_cipher_func *f)
+{
+  unsigned i;
+
+  memset (key->L_star.b, 0, OCB_BLOCK_SIZE);
+  f (cipher, OCB_BLOCK_SIZE, key->L_star.b, key->L_star.b);
+  block16_mulx (&key->L_dollar, &key->L_star);
+  block16_mulx (&key->L[0], &key->L_dollar);
+  for (i = 1; i < OCB_L_SIZE; i++)
+    block16_mulx (&key->L[i], &key->L[i-1]);
+}
+
+void
+ocb_set_nonce (struct ocb_ctx *ctx,
+	       const void *cipher, nettle_cipher_func *f,
+	       size_t tag_length, size_t nonce_length, const uint8_t *nonce)
+{
+  union nettle_block16 top;
+  uint64_t stretch;
+  unsigned bottom;
+
+  assert (nonce_length > 0);
+  assert (nonce_length <= OCB_MAX_NONCE_SIZE);
+  assert (tag_length > 0);
+  assert (tag_length <= OCB_DIGEST_SIZE);
+
+  /* Nonce = num2str(TAGLEN mod 128, 7) || zeros || 1 || N */
+  memset (top.b, 0, OCB_BLOCK_SIZE);
+  top.b[0] = (tag_length & 15) << 4;
+  top.b[OCB_BLOCK_SIZE - 1 - nonce_length] |= 1;
+  memcpy (top.b + OCB_BLOCK_SIZE - nonce_length, nonce, nonce_length);
+
+  bottom = top.b[OCB_BLOCK_SIZE - 1] & 0x3f;
+  top.b[OCB_BLOCK_SIZE - 1] &= 0xc0;
+
+  f (cipher, OCB_BLOCK_SIZE, top.b, top.b);
+
+  /* Stretch = Ktop || (Ktop[1..64] xor Ktop[9..72]), and the initial
+     offset is the 128 bits starting at bit number bottom. */
+  stretch = READ_UINT64 (top.b) ^ READ_UINT64 (top.b + 1);
+  if (bottom == 0)
+    memcpy (ctx->offset.b, top.b, OCB_BLOCK_SIZE);
+  else
+    {
+      uint64_t hi = READ_UINT64 (top.b);
+      uint64_t lo = READ_UINT64 (top.b + 8);
+      WRITE_UINT64 (ctx->offset.b, (hi << bottom) | (lo >> (64 - bottom)));
+      WRITE_UINT64 (ctx->offset.b + 8,
+		    (lo << bottom) | (stretch >> (64 - bottom)));
+    }
+
+  memset (ctx->checksum.b, 0, OCB_BLOCK_SIZE);
+  memset (ctx->data_offset.b, 0, OCB_BLOCK_SIZE);
+  memset (ctx->sum.b, 0, OCB_BLOCK_SIZE);
+  ctx->message_count = ctx->data_count = 0;
+}
+
+/* Advances offset for block number i = *count + 1, adding L_ntz(i). */
+static void
+ocb_next_offset (union nettle_block16 *offset, const struct ocb_key *key,
+		 size_t *count)
+{
+  size_t i = ++*count;
+  unsigned ntz;
+
+  for (ntz = 0; !(i & 1); ntz++)
+    i >>= 1;
+
+  if (ntz < OCB_L_SIZE)
+    block16_xor (offset, &key->L[ntz]);
+  else
+    {
+      union nettle_block16 t;
+      unsigned j;
+      block16_mulx (&t, &key->L[OCB_L_SIZE-1]);
+      for (j = OCB_L_SIZE; j < ntz; j++)
+	block16_mulx (&t, &t);
+      block16_xor (offset, &t);
+    }
+}
+
+/* Pads a final partial block with 1 || zeros. */
+static void
+ocb_pad (union nettle_block16 *block, size_t length, const uint8_t *src)
+{
+  memcpy (block->b, src, length);
+  block->b[length] = 0x80;
+  memset (block->b + length + 1, 0, OCB_BLOCK_SIZE - 1 - length);
+}
+
+void
+ocb_update (struct ocb_ctx *ctx, const struct ocb_key *key,
+	    const void *cipher, nettle_cipher_func *f,
+	    size_t length, const uint8_t *data)
+{
+  union nettle_block16 buffer[OCB_BATCH];
+  size_t blocks = length / OCB_BLOCK_SIZE;
+
+  while (blocks > 0)
+    {
+      size_t n = MIN (blocks, OCB_BATCH);
+      size_t i;
+
+      for (i = 0; i < n; i++, data += OCB_BLOCK_SIZE)
+	{
+	  ocb_next_offset (&ctx->data_offset, key, &ctx->data_count);
+	  memxor3 (buffer[i].b, ctx->data_offset.b, data, OCB_BLOCK_SIZE);
+	}
+      f (cipher, n * OCB_BLOCK_SIZE, buffer[0].b, buffer[0].b);
+      for (i = 0; i < n; i++)
+	block16_xor (&ctx->sum, &buffer[i]);
+
+      blocks -= n;
+    }
+
+  length %= OCB_BLOCK_SIZE;
+  if (length > 0)
+    {
+      ocb_pad (&buffer[0], length, data);
+      block16_xor (&ctx->data_offset, &key->L_star);
+      block16_xor (&buffer[0], &ctx->data_offset);
+      f (cipher, OCB_BLOCK_SIZE, buffer[0].b, buffer[0].b);
+      block16_xor (&ctx->sum, &buffer[0]);
+    }
+}
+
+void
+ocb_encrypt (struct ocb_ctx *ctx, const struct ocb_key *key,
+	     const void *cipher, nettle_cipher_func *f,
+	     size_t length, uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 offset[OCB_BATCH];
+  union nettle_block16 buffer[OCB_BATCH];
+  size_t blocks = length / OCB_BLOCK_SIZE;
+
+  while (blocks > 0)
+    {
+      size_t n = MIN (blocks, OCB_BATCH);
+      size_t i;
+
+      for (i = 0; i < n; i++)
+	{
+	  ocb_next_offset (&ctx->offset, key, &ctx->message_count);
+	  offset[i] = ctx->offset;
+	  memxor (ctx->checksum.b, src + i * OCB_BLOCK_SIZE, OCB_BLOCK_SIZE);
+	  memxor3 (buffer[i].b, offset[i].b, src + i * OCB_BLOCK_SIZE,
+		   OCB_BLOCK_SIZE);
+	}
+      f (cipher, n * OCB_BLOCK_SIZE, buffer[0].b, buffer[0].b);
+      memxor3 (dst, buffer[0].b, offset[0].b, n * OCB_BLOCK_SIZE);
+
+      src += n * OCB_BLOCK_SIZE;
+      dst += n * OCB_BLOCK_SIZE;
+      blocks -= n;
+    }
+
+  length %= OCB_BLOCK_SIZE;
+  if (length > 0)
+    {
+      ocb_pad (&buffer[0], length, src);
+      block16_xor (&ctx->checksum, &buffer[0]);
+      block16_xor (&ctx->offset, &key->L_star);
+      f (cipher, OCB_BLOCK_SIZE, buffer[0].b, ctx->offset.b);
+      memxor3 (dst, src, buffer[0].b, length);
+    }
+}
+
+void
+ocb_decrypt (struct ocb_ctx *ctx, const struct ocb_key *key,
+	     const void *encrypt_ctx, nettle_cipher_func *encrypt,
+	     const void *decrypt_ctx, nettle_cipher_func *decrypt,
+	     size_t length, uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 offset[OCB_BATCH];
+  union nettle_block16 buffer[OCB_BATCH];
+  size_t blocks = length / OCB_BLOCK_SIZE;
+
+  while (blocks > 0)
+    {
+      size_t n = MIN (blocks, OCB_BATCH);
+      size_t i;
+
+      for (i = 0; i < n; i++)
+	{
+	  ocb_next_offset (&ctx->offset, key, &ctx->message_count);
+	  offset[i] = ctx->offset;
+	}
+      memxor3 (buffer[0].b, offset[0].b, src, n * OCB_BLOCK_SIZE);
+      decrypt (decrypt_ctx, n * OCB_BLOCK_SIZE, buffer[0].b, buffer[0].b);
+      memxor3 (dst, buffer[0].b, offset[0].b, n * OCB_BLOCK_SIZE);
+      memxor (ctx->checksum.b, dst, OCB_BLOCK_SIZE);
+      for (i = 1; i < n; i++)
+	memxor (ctx->checksum.b, dst + i * OCB_BLOCK_SIZE, OCB_BLOCK_SIZE);
+
+      src += n * OCB_BLOCK_SIZE;
+      dst += n * OCB_BLOCK_SIZE;
+      blocks -= n;
+    }
+
+  length %= OCB_BLOCK_SIZE;
+  if (length > 0)
+    {
+      block16_xor (&ctx->offset, &key->L_star);
+      encrypt (encrypt_ctx, OCB_BLOCK_SIZE, buffer[0].b, ctx->offset.b);
+      memxor3 (dst, src, buffer[0].b, length);
+      ocb_pad (&buffer[0], length, dst);
+      block16_xor (&ctx->checksum, &buffer[0]);
+    }
+}
+
+void
+ocb_digest (struct ocb_ctx *ctx, const struct ocb_key *key,
+	    const void *cipher, nettle_cipher_func *f,
+	    size_t length, uint8_t *digest)
+{
+  union nettle_block16 block;
+
+  assert (length <= OCB_DIGEST_SIZE);
+
+  memxor3 (block.b, ctx->checksum.b, ctx->offset.b, OCB_BLOCK_SIZE);
+  block16_xor (&block, &key->L_dollar);
+  f (cipher, OCB_BLOCK_SIZE, block.b, block.b);
+  memxor3 (digest, block.b, ctx->sum.b, length);
+}
@@ -3,6 +3,7 @@
    PKCS #5 PBKDF2 used with HMAC-SHA1, see RFC 2898.
 
    Copyright (C) 2012 Simon Josefsson
+   Copyright (C) 2026 agent
 
    This file is part of GNU Nettle.
 
@@ -35,19 +36,73 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
+#include <string.h>
+
 #include "pbkdf2.h"
 
 #include "hmac.h"
+#include "macros.h"
+#include "memxor.h"
+#include "nettle-write.h"
 
+/* Works on the hmac midstates, like pbkdf2_hmac_sha256. */
 void
 pbkdf2_hmac_sha1 (size_t key_length, const uint8_t *key,
 		  unsigned iterations,
 		  size_t salt_length, const uint8_t *salt,
 		  size_t length, uint8_t *dst)
 {
-  struct hmac_sha1_ctx sha1ctx;
+  struct hmac_sha1_ctx ctx;
+  uint32_t state[_SHA1_DIGEST_LENGTH];
+  uint8_t block[SHA1_BLOCK_SIZE];
+  uint8_t T[SHA1_DIGEST_SIZE];
+  unsigned i;
+
+  assert (iterations > 0);
+
+  if (length == 0)
+    return;
+
+  hmac_sha1_set_key (&ctx, key_length, key);
+
+  memset (block + SHA1_DIGEST_SIZE, 0, SHA1_BLOCK_SIZE - SHA1_DIGEST_SIZE);
+  block[SHA1_DIGEST_SIZE] = 0x80;
+  WRITE_UINT64 (block + SHA1_BLOCK_SIZE - 8,
+		(uint64_t) 8 * (SHA1_BLOCK_SIZE + SHA1_DIGEST_SIZE));
+
+  for (i = 1;;
+       i++, dst += SHA1_DIGEST_SIZE, length -= SHA1_DIGEST_SIZE)
+    {
+      uint8_t tmp[4];
+      unsigned u;
+
+      WRITE_UINT32 (tmp, i);
+
+      hmac_sha1_update (&ctx, salt_length, salt);
+      hmac_sha1_update (&ctx, sizeof(tmp), tmp);
+      hmac_sha1_digest (&ctx, SHA1_DIGEST_SIZE, block);
+
+      memcpy (T, block, SHA1_DIGEST_SIZE);
+
+      for (u = 1; u < iterations; u++)
+	{
+	  memcpy (state, ctx.inner.state, sizeof(state));
+	  nettle_sha1_compress (state, block);
+	  _nettle_write_be32 (SHA1_DIGEST_SIZE, block, state);
+
+	  memcpy (state, ctx.outer.state, sizeof(state));
+	  nettle_sha1_compress (state, block);
+	  _nettle_write_be32 (SHA1_DIGEST_SIZE, block, state);
+
+	  memxor (T, block, SHA1_DIGEST_SIZE);
+	}
 
-  hmac_sha1_set_key (&sha1ctx, key_length, key);
-  PBKDF2 (&sha1ctx, hmac_sha1_update, hmac_sha1_digest,
-	  SHA1_DIGEST_SIZE, iterations, salt_length, salt, length, dst);
+      if (length <= SHA1_DIGEST_SIZE)
+	{
+	  memcpy (dst, T, length);
+	  return;
+	}
+      memcpy (dst, T, SHA1_DIGEST_SIZE);
+    }
 }
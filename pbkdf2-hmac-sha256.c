@@ -3,6 +3,7 @@
    PKCS #5 PBKDF2 used with HMAC-SHA256, see RFC 2898.
 
    Copyright (C) 2012 Simon Josefsson
+   Copyright (C) 2026 agent
 
    This file is part of GNU Nettle.
 
@@ -35,19 +36,80 @@
 # include "config.h"
 #endif
 
+#include <assert.h>
+#include <string.h>
+
 #include "pbkdf2.h"
 
 #include "hmac.h"
+#include "macros.h"
+#include "memxor.h"
+#include "nettle-write.h"
+#include "sha2-internal.h"
 
+/* Instead of going through the generic pbkdf2 function, which copies
+   the hmac contexts and pads the message for each hash, the
+   iterations after the first work directly on the inner and outer
+   midstates left by hmac_sha256_set_key. Each iteration then costs
+   exactly two compressions of a block holding the previous digest
+   and fixed padding, for a message of one block plus one digest. */
 void
 pbkdf2_hmac_sha256 (size_t key_length, const uint8_t *key,
 		    unsigned iterations,
 		    size_t salt_length, const uint8_t *salt,
 		    size_t length, uint8_t *dst)
 {
-  struct hmac_sha256_ctx sha256ctx;
+  struct hmac_sha256_ctx ctx;
+  uint32_t state[_SHA256_DIGEST_LENGTH];
+  uint8_t block[SHA256_BLOCK_SIZE];
+  uint8_t T[SHA256_DIGEST_SIZE];
+  unsigned i;
+
+  assert (iterations > 0);
+
+  if (length == 0)
+    return;
+
+  hmac_sha256_set_key (&ctx, key_length, key);
+
+  memset (block + SHA256_DIGEST_SIZE, 0,
+	  SHA256_BLOCK_SIZE - SHA256_DIGEST_SIZE);
+  block[SHA256_DIGEST_SIZE] = 0x80;
+  WRITE_UINT64 (block + SHA256_BLOCK_SIZE - 8,
+		(uint64_t) 8 * (SHA256_BLOCK_SIZE + SHA256_DIGEST_SIZE));
+
+  for (i = 1;;
+       i++, dst += SHA256_DIGEST_SIZE, length -= SHA256_DIGEST_SIZE)
+    {
+      uint8_t tmp[4];
+      unsigned u;
+
+      WRITE_UINT32 (tmp, i);
+
+      hmac_sha256_update (&ctx, salt_length, salt);
+      hmac_sha256_update (&ctx, sizeof(tmp), tmp);
+      hmac_sha256_digest (&ctx, SHA256_DIGEST_SIZE, block);
+
+      memcpy (T, block, SHA256_DIGEST_SIZE);
+
+      for (u = 1; u < iterations; u++)
+	{
+	  memcpy (state, ctx.inner.state, sizeof(state));
+	  _nettle_sha256_compress_block (state, block);
+	  _nettle_write_be32 (SHA256_DIGEST_SIZE, block, state);
+
+	  memcpy (state, ctx.outer.state, sizeof(state));
+	  _nettle_sha256_compress_block (state, block);
+	  _nettle_write_be32 (SHA256_DIGEST_SIZE, block, state);
+
+	  memxor (T, block, SHA256_DIGEST_SIZE);
+	}
 
-  hmac_sha256_set_key (&sha256ctx, key_length, key);
-  PBKDF2 (&sha256ctx, hmac_sha256_update, hmac_sha256_digest,
-	  SHA256_DIGEST_SIZE, iterations, salt_length, salt, length, dst);
+      if (length <= SHA256_DIGEST_SIZE)
+	{
+	  memcpy (dst, T, length);
+	  return;
+	}
+      memcpy (dst, T, SHA256_DIGEST_SIZE);
+    }
 }
@@ -37,6 +37,20 @@
 
 #define _pkcs1_sec_decrypt _nettle_pkcs1_sec_decrypt
 #define _pkcs1_sec_decrypt_variable _nettle_pkcs1_sec_decrypt_variable
+#define _pkcs1_rsa_digest_encode _nettle_pkcs1_rsa_digest_encode
+#define _pkcs1_rsa_md5_encode_digest _nettle_pkcs1_rsa_md5_encode_digest
+#define _pkcs1_rsa_sha1_encode_digest _nettle_pkcs1_rsa_sha1_encode_digest
+#define _pkcs1_rsa_sha256_encode_digest _nettle_pkcs1_rsa_sha256_encode_digest
+#define _pkcs1_rsa_sha512_encode_digest _nettle_pkcs1_rsa_sha512_encode_digest
+#define _pss_encode_mgf1 _nettle_pss_encode_mgf1
+#define _pkcs1_rsa_digest_check _nettle_pkcs1_rsa_digest_check
+#define _pkcs1_rsa_md5_check_digest _nettle_pkcs1_rsa_md5_check_digest
+#define _pkcs1_rsa_sha1_check_digest _nettle_pkcs1_rsa_sha1_check_digest
+#define _pkcs1_rsa_sha256_check_digest _nettle_pkcs1_rsa_sha256_check_digest
+#define _pkcs1_rsa_sha512_check_digest _nettle_pkcs1_rsa_sha512_check_digest
+#define _pss_verify_mgf1 _nettle_pss_verify_mgf1
+
+struct nettle_hash;
 
 /* additional resistance to memory access side-channel attacks.
  * Note: message buffer is returned unchanged on error */
@@ -50,4 +64,63 @@ _pkcs1_sec_decrypt_variable(size_t *length, uint8_t *message,
                             size_t padded_message_length,
                             const volatile uint8_t *padded_message);
 
+/* Variants of the pkcs1_rsa_*_encode_digest and pss_encode_mgf1
+ * functions, writing the encoded message as octets to a caller
+ * supplied buffer, rather than to an mpz_t. */
+int
+_pkcs1_rsa_digest_encode(size_t key_size, uint8_t *em,
+			 size_t di_length, const uint8_t *digest_info);
+
+int
+_pkcs1_rsa_md5_encode_digest(size_t key_size, uint8_t *em,
+			     const uint8_t *digest);
+
+int
+_pkcs1_rsa_sha1_encode_digest(size_t key_size, uint8_t *em,
+			      const uint8_t *digest);
+
+int
+_pkcs1_rsa_sha256_encode_digest(size_t key_size, uint8_t *em,
+				const uint8_t *digest);
+
+int
+_pkcs1_rsa_sha512_encode_digest(size_t key_size, uint8_t *em,
+				const uint8_t *digest);
+
+int
+_pss_encode_mgf1(uint8_t *em, size_t bits,
+		 const struct nettle_hash *hash,
+		 size_t salt_length, const uint8_t *salt,
+		 const uint8_t *digest);
+
+/* Checks of an encoded message, given as octets, e.g., decoded in
+ * place by _rsa_verify_recover_octets. Return 1 on match. */
+int
+_pkcs1_rsa_digest_check(size_t key_size, const uint8_t *em,
+			size_t di_length, const uint8_t *digest_info);
+
+int
+_pkcs1_rsa_md5_check_digest(size_t key_size, const uint8_t *em,
+			    const uint8_t *digest);
+
+int
+_pkcs1_rsa_sha1_check_digest(size_t key_size, const uint8_t *em,
+			     const uint8_t *digest);
+
+int
+_pkcs1_rsa_sha256_check_digest(size_t key_size, const uint8_t *em,
+			       const uint8_t *digest);
+
+int
+_pkcs1_rsa_sha512_check_digest(size_t key_size, const uint8_t *em,
+			       const uint8_t *digest);
+
+/* Like pss_verify_mgf1, but the encoded message, (bits + 7) / 8
+ * octets, is unmasked in place. */
+int
+_pss_verify_mgf1(uint8_t *em, size_t bits,
+		 const struct nettle_hash *hash,
+		 size_t salt_length,
+		 const uint8_t *digest);
+
 #endif /* NETTLE_PKCS1_INTERNAL_H_INCLUDED */
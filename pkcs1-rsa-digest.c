@@ -38,25 +38,39 @@
 #include "gmp-glue.h"
 #include "nettle-internal.h"
 #include "hogweed-internal.h"
+#include "pkcs1-internal.h"
+
+/* Writes the encoding, key_size octets, to em. */
+int
+_pkcs1_rsa_digest_encode(size_t key_size, uint8_t *em,
+			 size_t di_length, const uint8_t *digest_info)
+{
+  return _pkcs1_signature_prefix(key_size, em,
+				 di_length, digest_info, 0) != NULL;
+}
+
+/* Checks that em, key_size octets, is the encoding of digest_info. */
+int
+_pkcs1_rsa_digest_check(size_t key_size, const uint8_t *em,
+			size_t di_length, const uint8_t *digest_info)
+{
+  return _pkcs1_signature_check(key_size, em,
+				di_length, digest_info, 0, NULL);
+}
 
 int
 pkcs1_rsa_digest_encode(mpz_t m, size_t key_size,
 			size_t di_length, const uint8_t *digest_info)
 {
   TMP_GMP_DECL(em, uint8_t);
+  int res;
 
   TMP_GMP_ALLOC(em, key_size);
 
-  if (_pkcs1_signature_prefix(key_size, em,
-			      di_length, digest_info, 0))
-    {
-      nettle_mpz_set_str_256_u(m, key_size, em);
-      TMP_GMP_FREE(em);
-      return 1;
-    }
-  else
-    {
-      TMP_GMP_FREE(em);
-      return 0;
-    }
+  res = _pkcs1_rsa_digest_encode(key_size, em, di_length, digest_info);
+  if (res)
+    nettle_mpz_set_str_256_u(m, key_size, em);
+
+  TMP_GMP_FREE(em);
+  return res;
 }
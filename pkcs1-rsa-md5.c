@@ -44,6 +44,7 @@
 #include "bignum.h"
 #include "pkcs1.h"
 #include "hogweed-internal.h"
+#include "pkcs1-internal.h"
 
 #include "gmp-glue.h"
 
@@ -96,28 +97,47 @@ pkcs1_rsa_md5_encode(mpz_t m, size_t key_size, struct md5_ctx *hash)
     }
 }
 
+/* Writes the encoding, key_size octets, to em. */
 int
-pkcs1_rsa_md5_encode_digest(mpz_t m, size_t key_size, const uint8_t *digest)
+_pkcs1_rsa_md5_encode_digest(size_t key_size, uint8_t *em,
+			     const uint8_t *digest)
 {
   uint8_t *p;
-  TMP_GMP_DECL(em, uint8_t);
-
-  TMP_GMP_ALLOC(em, key_size);
 
   p = _pkcs1_signature_prefix(key_size, em,
 			      sizeof(md5_prefix),
 			      md5_prefix,
 			      MD5_DIGEST_SIZE);
-  if (p)
-    {
-      memcpy(p, digest, MD5_DIGEST_SIZE);
-      nettle_mpz_set_str_256_u(m, key_size, em);
-      TMP_GMP_FREE(em);
-      return 1;
-    }
-  else
-    {
-      TMP_GMP_FREE(em);
-      return 0;
-    }
+  if (!p)
+    return 0;
+
+  memcpy(p, digest, MD5_DIGEST_SIZE);
+  return 1;
+}
+
+/* Checks that em, key_size octets, is the encoding of digest. */
+int
+_pkcs1_rsa_md5_check_digest(size_t key_size, const uint8_t *em,
+			    const uint8_t *digest)
+{
+  return _pkcs1_signature_check(key_size, em,
+				sizeof(md5_prefix),
+				md5_prefix,
+				MD5_DIGEST_SIZE, digest);
+}
+
+int
+pkcs1_rsa_md5_encode_digest(mpz_t m, size_t key_size, const uint8_t *digest)
+{
+  TMP_GMP_DECL(em, uint8_t);
+  int res;
+
+  TMP_GMP_ALLOC(em, key_size);
+
+  res = _pkcs1_rsa_md5_encode_digest(key_size, em, digest);
+  if (res)
+    nettle_mpz_set_str_256_u(m, key_size, em);
+
+  TMP_GMP_FREE(em);
+  return res;
 }
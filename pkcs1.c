@@ -72,3 +72,33 @@ _pkcs1_signature_prefix(unsigned key_size,
 
   return buffer + j + id_size;
 }
+
+/* Checks that em, key_size octets, has the format produced by
+   _pkcs1_signature_prefix, followed by the given digest. Since
+   signatures are public, this needs no side-channel silence. */
+int
+_pkcs1_signature_check(unsigned key_size,
+		       const uint8_t *em,
+		       unsigned id_size,
+		       const uint8_t *id,
+		       unsigned digest_size,
+		       const uint8_t *digest)
+{
+  unsigned i, j;
+
+  if (key_size < 11 + id_size + digest_size)
+    return 0;
+
+  j = key_size - digest_size - id_size;
+
+  if (em[0] != 0 || em[1] != 1 || em[j-1] != 0)
+    return 0;
+
+  for (i = 2; i < j - 1; i++)
+    if (em[i] != 0xff)
+      return 0;
+
+  return (memcmp (em + j, id, id_size) == 0
+	  && (digest_size == 0
+	      || memcmp (em + j + id_size, digest, digest_size) == 0));
+}
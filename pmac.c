@@ -0,0 +1,221 @@
+/* pmac.c
+
+   PMAC mode, a parallelizable block cipher MAC. This is PMAC1, as
+   described by Rogaway, "Efficient Instantiations of Tweakable
+   Blockciphers and Refinements to Modes OCB and PMAC".
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "pmac.h"
+
+#include "memxor.h"
+#include "macros.h"
+
+/* Number of blocks encrypted with a single call to the cipher. */
+#define PMAC128_BATCH 16
+
+#define MIN(x,y) ((x)<(y)?(x):(y))
+
+static void
+block16_xor (union nettle_block16 *dst, const union nettle_block16 *src)
+{
+  dst->w[0] ^= src->w[0];
+  dst->w[1] ^= src->w[1];
+#if SIZEOF_LONG == 4
+  dst->w[2] ^= src->w[2];
+  dst->w[3] ^= src->w[3];
+#endif
+}
+
+/* shift one and XOR with 0x87. */
+static void
+block_mulx(union nettle_block16 *dst,
+	   const union nettle_block16 *src)
+{
+  uint64_t b1 = READ_UINT64(src->b);
+  uint64_t b2 = READ_UINT64(src->b+8);
+
+  b1 = (b1 << 1) | (b2 >> 63);
+  b2 <<= 1;
+
+  if (src->b[0] & 0x80)
+    b2 ^= 0x87;
+
+  WRITE_UINT64(dst->b, b1);
+  WRITE_UINT64(dst->b+8, b2);
+}
+
+/* Multiplication by x^{-1} = x^127 + x^6 + x + 1. */
+static void
+block_divx(union nettle_block16 *dst,
+	   const union nettle_block16 *src)
+{
+  uint64_t b1 = READ_UINT64(src->b);
+  uint64_t b2 = READ_UINT64(src->b+8);
+  uint64_t mask = -(b2 & 1);
+
+  b2 = (b2 >> 1) | (b1 << 63);
+  b1 >>= 1;
+
+  b1 ^= mask & ((uint64_t) 1 << 63);
+  b2 ^= mask & 0x43;
+
+  WRITE_UINT64(dst->b, b1);
+  WRITE_UINT64(dst->b+8, b2);
+}
+
+void
+pmac128_set_key(struct pmac128_ctx *ctx, const void *cipher,
+		nettle_cipher_func *encrypt)
+{
+  unsigned i;
+
+  memset(ctx, 0, sizeof(*ctx));
+
+  encrypt(cipher, 16, ctx->L[0].b, ctx->block.b);
+  for (i = 1; i < PMAC128_L_SIZE; i++)
+    block_mulx(&ctx->L[i], &ctx->L[i-1]);
+  block_divx(&ctx->L_inv, &ctx->L[0]);
+}
+
+/* Advances the offset to the one for the next block, adding
+   L x^ntz(count). */
+static void
+pmac128_next_offset(struct pmac128_ctx *ctx)
+{
+  uint64_t count = ++ctx->count;
+  unsigned ntz;
+
+  for (ntz = 0; !(count & 1); ntz++)
+    count >>= 1;
+
+  if (ntz < PMAC128_L_SIZE)
+    block16_xor(&ctx->offset, &ctx->L[ntz]);
+  else
+    {
+      union nettle_block16 t;
+      unsigned i;
+      block_mulx(&t, &ctx->L[PMAC128_L_SIZE-1]);
+      for (i = PMAC128_L_SIZE; i < ntz; i++)
+	block_mulx(&t, &t);
+      block16_xor(&ctx->offset, &t);
+    }
+}
+
+/* Processes n complete blocks, none of them the final block. The
+   blocks are independent, and are passed to the cipher in batches. */
+static void
+pmac128_blocks(struct pmac128_ctx *ctx, const void *cipher,
+	       nettle_cipher_func *encrypt,
+	       size_t n, const uint8_t *msg)
+{
+  union nettle_block16 buffer[PMAC128_BATCH];
+
+  while (n > 0)
+    {
+      size_t batch = MIN(n, PMAC128_BATCH);
+      size_t i;
+
+      for (i = 0; i < batch; i++, msg += 16)
+	{
+	  pmac128_next_offset(ctx);
+	  memxor3(buffer[i].b, ctx->offset.b, msg, 16);
+	}
+      encrypt(cipher, batch * 16, buffer[0].b, buffer[0].b);
+      for (i = 0; i < batch; i++)
+	block16_xor(&ctx->checksum, &buffer[i]);
+
+      n -= batch;
+    }
+}
+
+void
+pmac128_update(struct pmac128_ctx *ctx, const void *cipher,
+	       nettle_cipher_func *encrypt,
+	       size_t msg_len, const uint8_t *msg)
+{
+  if (ctx->index < 16)
+    {
+      size_t len = MIN(16 - ctx->index, msg_len);
+      memcpy(&ctx->block.b[ctx->index], msg, len);
+      msg += len;
+      msg_len -= len;
+      ctx->index += len;
+    }
+
+  if (msg_len == 0)
+    /* It may still be the last block. */
+    return;
+
+  pmac128_blocks(ctx, cipher, encrypt, 1, ctx->block.b);
+
+  /* Process all complete blocks but the last, which is kept for
+     pmac128_digest. */
+  pmac128_blocks(ctx, cipher, encrypt, (msg_len - 1) / 16, msg);
+  msg += (msg_len - 1) & ~(size_t) 15;
+  msg_len = ((msg_len - 1) & 15) + 1;
+
+  memcpy(ctx->block.b, msg, msg_len);
+  ctx->index = msg_len;
+}
+
+void
+pmac128_digest(struct pmac128_ctx *ctx, const void *cipher,
+	       nettle_cipher_func *encrypt,
+	       unsigned length,
+	       uint8_t *dst)
+{
+  assert(length <= 16);
+
+  if (ctx->index < 16)
+    {
+      ctx->block.b[ctx->index] = 0x80;
+      memset(ctx->block.b + ctx->index + 1, 0, 15 - ctx->index);
+    }
+  else
+    block16_xor(&ctx->checksum, &ctx->L_inv);
+
+  block16_xor(&ctx->checksum, &ctx->block);
+  encrypt(cipher, 16, ctx->block.b, ctx->checksum.b);
+  memcpy(dst, ctx->block.b, length);
+
+  /* reset state for re-use */
+  memset(&ctx->offset, 0, sizeof(ctx->offset));
+  memset(&ctx->checksum, 0, sizeof(ctx->checksum));
+  ctx->count = 0;
+  ctx->index = 0;
+}
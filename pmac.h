@@ -0,0 +1,145 @@
+/* pmac.h
+
+   PMAC mode, a parallelizable block cipher MAC.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_PMAC_H_INCLUDED
+#define NETTLE_PMAC_H_INCLUDED
+
+#include "aes.h"
+#include "nettle-types.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define PMAC128_DIGEST_SIZE 16
+
+/* Number of precomputed multiples L x^i. Larger values of i are
+   computed when needed. */
+#define PMAC128_L_SIZE 8
+
+#define pmac128_set_key nettle_pmac128_set_key
+#define pmac128_update nettle_pmac128_update
+#define pmac128_digest nettle_pmac128_digest
+#define pmac_aes128_set_key nettle_pmac_aes128_set_key
+#define pmac_aes128_update nettle_pmac_aes128_update
+#define pmac_aes128_digest nettle_pmac_aes128_digest
+#define pmac_aes256_set_key nettle_pmac_aes256_set_key
+#define pmac_aes256_update nettle_pmac_aes256_update
+#define pmac_aes256_digest nettle_pmac_aes256_digest
+
+struct pmac128_ctx
+{
+  /* Key, L x^i and L x^{-1}, where L = E_K(0). */
+  union nettle_block16 L[PMAC128_L_SIZE];
+  union nettle_block16 L_inv;
+
+  /* MAC state */
+  union nettle_block16 offset;
+  union nettle_block16 checksum;
+  /* Number of blocks processed */
+  uint64_t count;
+
+  /* Block buffer */
+  union nettle_block16 block;
+  size_t index;
+};
+
+void
+pmac128_set_key(struct pmac128_ctx *ctx, const void *cipher,
+		nettle_cipher_func *encrypt);
+void
+pmac128_update(struct pmac128_ctx *ctx, const void *cipher,
+	       nettle_cipher_func *encrypt,
+	       size_t msg_len, const uint8_t *msg);
+void
+pmac128_digest(struct pmac128_ctx *ctx, const void *cipher,
+	       nettle_cipher_func *encrypt,
+	       unsigned length,
+	       uint8_t *digest);
+
+
+#define PMAC128_CTX(type) \
+  { struct pmac128_ctx ctx; type cipher; }
+
+/* NOTE: Avoid using NULL, as we don't include anything defining it. */
+#define PMAC128_SET_KEY(self, set_key, encrypt, pmac_key)	\
+  do {								\
+    (set_key)(&(self)->cipher, (pmac_key));			\
+    if (0) (encrypt)(&(self)->cipher, ~(size_t) 0,		\
+		     (uint8_t *) 0, (const uint8_t *) 0);	\
+    pmac128_set_key(&(self)->ctx, &(self)->cipher,		\
+		(nettle_cipher_func *) (encrypt));		\
+  } while (0)
+
+#define PMAC128_UPDATE(self, encrypt, length, src)		\
+  pmac128_update(&(self)->ctx, &(self)->cipher,			\
+	      (nettle_cipher_func *)encrypt, (length), (src))
+
+#define PMAC128_DIGEST(self, encrypt, length, digest)		\
+  (0 ? (encrypt)(&(self)->cipher, ~(size_t) 0,			\
+		 (uint8_t *) 0, (const uint8_t *) 0)		\
+     : pmac128_digest(&(self)->ctx, &(self)->cipher,		\
+		  (nettle_cipher_func *) (encrypt),		\
+		  (length), (digest)))
+
+struct pmac_aes128_ctx PMAC128_CTX(struct aes128_ctx);
+
+void
+pmac_aes128_set_key(struct pmac_aes128_ctx *ctx, const uint8_t *key);
+
+void
+pmac_aes128_update(struct pmac_aes128_ctx *ctx,
+		   size_t length, const uint8_t *data);
+
+void
+pmac_aes128_digest(struct pmac_aes128_ctx *ctx,
+		   size_t length, uint8_t *digest);
+
+struct pmac_aes256_ctx PMAC128_CTX(struct aes256_ctx);
+
+void
+pmac_aes256_set_key(struct pmac_aes256_ctx *ctx, const uint8_t *key);
+
+void
+pmac_aes256_update(struct pmac_aes256_ctx *ctx,
+		   size_t length, const uint8_t *data);
+
+void
+pmac_aes256_digest(struct pmac_aes256_ctx *ctx,
+		   size_t length, uint8_t *digest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETTLE_PMAC_H_INCLUDED */
@@ -39,6 +39,7 @@
 #include "rsa-internal.h"
 
 #include "bignum.h"
+#include "hogweed-internal.h"
 
 /* Blinds the c, by computing c *= r^e (mod n), for a random r. Also
    returns the inverse (ri), for use by rsa_unblind. */
@@ -59,10 +60,10 @@ _rsa_blind (const struct rsa_public_key *pub,
       nettle_mpz_random(r, random_ctx, random, pub->n);
       /* invert r */
     }
-  while (!mpz_invert (ri, r, pub->n));
+  while (!_bignum_sec_invert (ri, r, pub->n));
 
   /* c = c*(r^e) mod n */
-  mpz_powm_sec(r, r, pub->e, pub->n);
+  _bignum_sec_powm(r, r, pub->e, pub->n);
   mpz_mul(c, c, r);
   mpz_fdiv_r(c, c, pub->n);
 
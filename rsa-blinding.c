@@ -0,0 +1,258 @@
+/* rsa-blinding.c
+
+   Pool of precomputed RSA blinding factors.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "bignum-backend.h"
+#include "gmp-glue.h"
+#include "hogweed-internal.h"
+#include "rsa.h"
+#include "rsa-internal.h"
+
+#define MAX(a, b) ((a) > (b) ? (a) : (b))
+
+void
+rsa_blinding_pool_init(struct rsa_blinding_pool *pool)
+{
+  unsigned i;
+  mpz_init (pool->n);
+  for (i = 0; i < RSA_BLINDING_POOL_SIZE; i++)
+    {
+      pool->uses[i] = 0;
+      mpz_init (pool->blind[i]);
+      mpz_init (pool->unblind[i]);
+    }
+}
+
+void
+rsa_blinding_pool_clear(struct rsa_blinding_pool *pool)
+{
+  unsigned i;
+  mpz_clear (pool->n);
+  for (i = 0; i < RSA_BLINDING_POOL_SIZE; i++)
+    {
+      pool->uses[i] = 0;
+      mpz_clear (pool->blind[i]);
+      mpz_clear (pool->unblind[i]);
+    }
+}
+
+unsigned
+rsa_blinding_pool_uses(const struct rsa_blinding_pool *pool)
+{
+  unsigned i;
+  unsigned uses;
+  for (i = uses = 0; i < RSA_BLINDING_POOL_SIZE; i++)
+    uses += pool->uses[i];
+  return uses;
+}
+
+/* Returns the index of an entry to use for blinding, and counts the
+   use, or -1 if the pool is empty or filled for a different key. */
+int
+_rsa_blinding_pool_next(struct rsa_blinding_pool *pool,
+			const struct rsa_public_key *pub)
+{
+  unsigned i;
+  if (mpz_cmp (pool->n, pub->n) != 0)
+    return -1;
+
+  for (i = 0; i < RSA_BLINDING_POOL_SIZE; i++)
+    if (pool->uses[i] > 0)
+      {
+	pool->uses[i]--;
+	return i;
+      }
+  return -1;
+}
+
+/* Discards all entries if the pool was filled for a different key. */
+static void
+rsa_blinding_pool_set_key(struct rsa_blinding_pool *pool,
+			  const struct rsa_public_key *pub)
+{
+  unsigned i;
+  if (mpz_cmp (pool->n, pub->n) == 0)
+    return;
+
+  for (i = 0; i < RSA_BLINDING_POOL_SIZE; i++)
+    pool->uses[i] = 0;
+  mpz_set (pool->n, pub->n);
+}
+
+#if NETTLE_USE_MINI_GMP
+void
+rsa_blinding_pool_refill(struct rsa_blinding_pool *pool,
+			 const struct rsa_public_key *pub,
+			 void *random_ctx, nettle_random_func *random)
+{
+  unsigned i;
+  mpz_t r;
+
+  rsa_blinding_pool_set_key (pool, pub);
+  mpz_init (r);
+
+  for (i = 0; i < RSA_BLINDING_POOL_SIZE; i++)
+    {
+      if (pool->uses[i] > 0)
+	continue;
+
+      do
+	nettle_mpz_random(r, random_ctx, random, pub->n);
+      while (!_bignum_sec_invert (pool->unblind[i], r, pub->n));
+
+      _bignum_sec_powm (pool->blind[i], r, pub->e, pub->n);
+      pool->uses[i] = RSA_BLINDING_MAX_USES;
+    }
+
+  mpz_clear (r);
+}
+
+mp_size_t
+_rsa_blinding_pool_update_itch(const struct rsa_public_key *pub UNUSED)
+{
+  return 0;
+}
+
+void
+_rsa_blinding_pool_update(struct rsa_blinding_pool *pool,
+			  const struct rsa_public_key *pub, unsigned i,
+			  mp_limb_t *scratch UNUSED)
+{
+  mpz_mul (pool->blind[i], pool->blind[i], pool->blind[i]);
+  mpz_fdiv_r (pool->blind[i], pool->blind[i], pub->n);
+  mpz_mul (pool->unblind[i], pool->unblind[i], pool->unblind[i]);
+  mpz_fdiv_r (pool->unblind[i], pool->unblind[i], pub->n);
+}
+
+#else /* !NETTLE_USE_MINI_GMP */
+void
+rsa_blinding_pool_refill(struct rsa_blinding_pool *pool,
+			 const struct rsa_public_key *pub,
+			 void *random_ctx, nettle_random_func *random)
+{
+  const struct bignum_backend *backend = BIGNUM_BACKEND;
+  const mp_limb_t *ep = mpz_limbs_read (pub->e);
+  const mp_limb_t *np = mpz_limbs_read (pub->n);
+  mp_bitcnt_t ebn = mpz_sizeinbase (pub->e, 2);
+  mp_size_t nn = mpz_size (pub->n);
+  mp_size_t itch;
+  mp_size_t i2;
+  mp_limb_t *rp;
+  mp_limb_t *tp;
+  unsigned i;
+
+  TMP_GMP_DECL (scratch, mp_limb_t);
+
+  rsa_blinding_pool_set_key (pool, pub);
+
+  itch = backend->sec_powm_itch (nn, ebn, nn);
+  i2 = backend->sec_invert_itch (nn);
+  itch = MAX (itch, i2);
+
+  TMP_GMP_ALLOC (scratch, 2*nn + itch);
+  rp = scratch;
+  tp = scratch + nn;
+
+  for (i = 0; i < RSA_BLINDING_POOL_SIZE; i++)
+    {
+      if (pool->uses[i] > 0)
+	continue;
+
+      /* Same as in rsa_sec_blind, the random octets are generated
+	 into tp, and then converted. */
+      do
+	{
+	  random(random_ctx, nn * sizeof(mp_limb_t), (uint8_t *) tp);
+	  mpn_set_base256(rp, nn, (uint8_t *) tp, nn * sizeof(mp_limb_t));
+	  mpn_copyi(tp, rp, nn);
+	}
+      while (!backend->sec_invert (mpz_limbs_write (pool->unblind[i], nn),
+				   tp, np, nn, 2 * nn * GMP_NUMB_BITS,
+				   scratch + 2*nn));
+      mpz_limbs_finish (pool->unblind[i], nn);
+
+      backend->sec_powm (mpz_limbs_write (pool->blind[i], nn),
+			 rp, nn, ep, ebn, np, nn, scratch + 2*nn);
+      mpz_limbs_finish (pool->blind[i], nn);
+
+      pool->uses[i] = RSA_BLINDING_MAX_USES;
+    }
+
+  TMP_GMP_FREE (scratch);
+}
+
+mp_size_t
+_rsa_blinding_pool_update_itch(const struct rsa_public_key *pub)
+{
+  mp_size_t nn = mpz_size (pub->n);
+  mp_size_t itch;
+  mp_size_t i2;
+
+  itch = mpn_sec_sqr_itch (nn);
+  i2 = mpn_sec_div_r_itch (2*nn, nn);
+  itch = MAX (itch, i2);
+
+  /* nn limbs for the factor, and 2 nn for its square. */
+  return 3*nn + itch;
+}
+
+static void
+sec_sqr_mod (mpz_t x, const struct rsa_public_key *pub,
+	     mp_limb_t *scratch)
+{
+  const mp_limb_t *np = mpz_limbs_read (pub->n);
+  mp_size_t nn = mpz_size (pub->n);
+  mp_limb_t *xp = scratch;
+  mp_limb_t *tp = scratch + nn;
+
+  mpz_limbs_copy (xp, x, nn);
+  mpn_sec_sqr (tp, xp, nn, tp + 2*nn);
+  mpn_sec_div_r (tp, 2*nn, np, nn, tp + 2*nn);
+  mpz_set_n (x, tp, nn);
+}
+
+/* Updates entry i for its next use, replacing r by r^2. */
+void
+_rsa_blinding_pool_update(struct rsa_blinding_pool *pool,
+			  const struct rsa_public_key *pub, unsigned i,
+			  mp_limb_t *scratch)
+{
+  sec_sqr_mod (pool->blind[i], pub, scratch);
+  sec_sqr_mod (pool->unblind[i], pub, scratch);
+}
+#endif /* !NETTLE_USE_MINI_GMP */
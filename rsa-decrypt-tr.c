@@ -47,25 +47,42 @@ rsa_decrypt_tr(const struct rsa_public_key *pub,
 	       size_t *length, uint8_t *message,
 	       const mpz_t gibberish)
 {
-  TMP_GMP_DECL (m, mp_limb_t);
-  TMP_GMP_DECL (em, uint8_t);
+  TMP_GMP_DECL (scratch, mp_limb_t);
+  int res;
+
+  TMP_GMP_ALLOC (scratch, rsa_sec_itch (pub, key));
+
+  res = rsa_decrypt_tr_scratch (pub, key, random_ctx, random,
+				length, message, gibberish, scratch);
+
+  TMP_GMP_FREE (scratch);
+  return res;
+}
+
+int
+rsa_decrypt_tr_scratch(const struct rsa_public_key *pub,
+		       const struct rsa_private_key *key,
+		       void *random_ctx, nettle_random_func *random,
+		       size_t *length, uint8_t *message,
+		       const mpz_t gibberish, mp_limb_t *scratch)
+{
   mp_size_t key_limb_size;
+  mp_limb_t *m;
+  uint8_t *em;
   int res;
 
   key_limb_size = NETTLE_OCTET_SIZE_TO_LIMB_SIZE(key->size);
-
-  TMP_GMP_ALLOC (m, key_limb_size);
-  TMP_GMP_ALLOC (em, key->size);
+  m = scratch;
+  em = (uint8_t *) (scratch + key_limb_size);
 
   res = _rsa_sec_compute_root_tr (pub, key, random_ctx, random, m,
 				  mpz_limbs_read(gibberish),
-				  mpz_size(gibberish));
+				  mpz_size(gibberish),
+				  scratch + 2 * key_limb_size);
 
   mpn_get_base256 (em, key->size, m, key_limb_size);
 
   res &= _pkcs1_sec_decrypt_variable (length, message, key->size, em);
 
-  TMP_GMP_FREE (em);
-  TMP_GMP_FREE (m);
   return res;
 }
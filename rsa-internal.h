@@ -36,14 +36,25 @@
 
 #include "rsa.h"
 
+struct nettle_hash;
+
 #define _rsa_verify _nettle_rsa_verify
 #define _rsa_verify_recover _nettle_rsa_verify_recover
+#define _rsa_verify_recover_octets _nettle_rsa_verify_recover_octets
+#define _rsa_pss_verify_digest _nettle_rsa_pss_verify_digest
 #define _rsa_check_size _nettle_rsa_check_size
 #define _rsa_blind _nettle_rsa_blind
 #define _rsa_unblind _nettle_rsa_unblind
 #define _rsa_sec_compute_root_itch _nettle_rsa_sec_compute_root_itch
 #define _rsa_sec_compute_root _nettle_rsa_sec_compute_root
+#define _rsa_sec_compute_root_tr_itch _nettle_rsa_sec_compute_root_tr_itch
 #define _rsa_sec_compute_root_tr _nettle_rsa_sec_compute_root_tr
+#define _rsa_sec_sign_tr _nettle_rsa_sec_sign_tr
+#define _rsa_sec_compute_root_pool _nettle_rsa_sec_compute_root_pool
+#define _rsa_sec_sign_pool _nettle_rsa_sec_sign_pool
+#define _rsa_blinding_pool_next _nettle_rsa_blinding_pool_next
+#define _rsa_blinding_pool_update_itch _nettle_rsa_blinding_pool_update_itch
+#define _rsa_blinding_pool_update _nettle_rsa_blinding_pool_update
 
 /* Internal functions. */
 int
@@ -56,6 +67,20 @@ _rsa_verify_recover(const struct rsa_public_key *key,
 		    mpz_t m,
 		    const mpz_t s);
 
+/* Like _rsa_verify_recover, but also converts m in place to
+ * key->size big-endian octets, returning a pointer to them. */
+uint8_t *
+_rsa_verify_recover_octets(const struct rsa_public_key *key,
+			   mpz_t m,
+			   const mpz_t s);
+
+int
+_rsa_pss_verify_digest(const struct rsa_public_key *key,
+		       const struct nettle_hash *hash,
+		       size_t salt_length,
+		       const uint8_t *digest,
+		       const mpz_t signature);
+
 size_t
 _rsa_check_size(mpz_t n);
 
@@ -79,10 +104,59 @@ _rsa_sec_compute_root(const struct rsa_private_key *key,
 
 /* Safe side-channel silent variant, using RSA blinding, and checking the
  * result after CRT. */
+mp_size_t
+_rsa_sec_compute_root_tr_itch(const struct rsa_public_key *pub,
+			      const struct rsa_private_key *key);
 int
 _rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
 			 const struct rsa_private_key *key,
 			 void *random_ctx, nettle_random_func *random,
-			 mp_limb_t *x, const mp_limb_t *m, size_t mn);
+			 mp_limb_t *x, const mp_limb_t *m, size_t mn,
+			 mp_limb_t *scratch);
+
+/* Signs the encoded message, LENGTH octets, which is stored right
+ * aligned in the first limbs of the scratch area, at the location
+ * given by RSA_SEC_SIGN_EM. The scratch area must have room for
+ * rsa_sec_itch limbs. On success, the signature is stored in s. */
+#define RSA_SEC_SIGN_EM(key, scratch, length)				\
+  ((uint8_t *) ((scratch) + NETTLE_OCTET_SIZE_TO_LIMB_SIZE ((key)->size)) \
+   - (length))
+
+int
+_rsa_sec_sign_tr(const struct rsa_public_key *pub,
+		 const struct rsa_private_key *key,
+		 void *random_ctx, nettle_random_func *random,
+		 size_t length, mpz_t s, mp_limb_t *scratch);
+
+/* Variants taking the blinding factor from a pool, if non-NULL, not
+ * empty, and filled for the same key. Scratch needs are the same as
+ * for the _tr functions. */
+int
+_rsa_sec_compute_root_pool(const struct rsa_public_key *pub,
+			   const struct rsa_private_key *key,
+			   struct rsa_blinding_pool *pool,
+			   void *random_ctx, nettle_random_func *random,
+			   mp_limb_t *x, const mp_limb_t *m, size_t mn,
+			   mp_limb_t *scratch);
+
+int
+_rsa_sec_sign_pool(const struct rsa_public_key *pub,
+		   const struct rsa_private_key *key,
+		   struct rsa_blinding_pool *pool,
+		   void *random_ctx, nettle_random_func *random,
+		   size_t length, mpz_t s, mp_limb_t *scratch);
+
+/* Blinding pool entries. */
+int
+_rsa_blinding_pool_next(struct rsa_blinding_pool *pool,
+			const struct rsa_public_key *pub);
+
+mp_size_t
+_rsa_blinding_pool_update_itch(const struct rsa_public_key *pub);
+
+void
+_rsa_blinding_pool_update(struct rsa_blinding_pool *pool,
+			  const struct rsa_public_key *pub, unsigned i,
+			  mp_limb_t *scratch);
 
 #endif /* NETTLE_RSA_INTERNAL_H_INCLUDED */
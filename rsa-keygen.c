@@ -41,6 +41,7 @@
 #include "rsa.h"
 #include "rsa-internal.h"
 #include "bignum.h"
+#include "hogweed-internal.h"
 
 #ifndef DEBUG
 # define DEBUG 0
@@ -51,19 +52,15 @@
 #endif
 
 
-int
-rsa_generate_keypair(struct rsa_public_key *pub,
-		     struct rsa_private_key *key,
-		     void *random_ctx, nettle_random_func *random,
-		     void *progress_ctx, nettle_progress_func *progress,
-		     unsigned n_size,
-		     unsigned e_size)
-{
-  mpz_t p1;
-  mpz_t q1;
-  mpz_t phi;
-  mpz_t tmp;
+typedef void
+prime_func(mpz_t p, unsigned bits, int top_bits_set,
+	   void *random_ctx, nettle_random_func *random,
+	   void *progress_ctx, nettle_progress_func *progress);
 
+static int
+check_sizes(const struct rsa_public_key *pub,
+	    unsigned n_size, unsigned e_size)
+{
   if (e_size)
     {
       /* We should choose e randomly. Is the size reasonable? */
@@ -87,75 +84,56 @@ rsa_generate_keypair(struct rsa_public_key *pub,
 	return 0;
     }
 
-  if (n_size < RSA_MINIMUM_N_BITS)
-    return 0;
-  
-  mpz_init(p1); mpz_init(q1); mpz_init(phi); mpz_init(tmp);
+  return n_size >= RSA_MINIMUM_N_BITS;
+}
+
+/* Generates a prime p, and sets p1 = p - 1. If e is non-NULL, p is
+   chosen such that gcd(p-1, e) = 1. */
+static void
+generate_prime(mpz_t p, mpz_t p1, unsigned bits, const mpz_t e,
+	       void *random_ctx, nettle_random_func *random,
+	       void *progress_ctx, nettle_progress_func *progress,
+	       prime_func *random_prime)
+{
+  mpz_t tmp;
+  mpz_init(tmp);
 
-  /* Generate primes */
   for (;;)
     {
-      /* Generate p, such that gcd(p-1, e) = 1 */
-      for (;;)
-	{
-	  nettle_random_prime(key->p, (n_size+1)/2, 1,
-			      random_ctx, random,
-			      progress_ctx, progress);
-
-	  mpz_sub_ui(p1, key->p, 1);
-      
-	  /* If e was given, we must choose p such that p-1 has no factors in
-	   * common with e. */
-	  if (e_size)
-	    break;
-	  
-	  mpz_gcd(tmp, pub->e, p1);
-
-	  if (mpz_cmp_ui(tmp, 1) == 0)
-	    break;
-	  else if (progress) progress(progress_ctx, 'c');
-	} 
-
-      if (progress)
-	progress(progress_ctx, '\n');
-      
-      /* Generate q, such that gcd(q-1, e) = 1 */
-      for (;;)
-	{
-	  nettle_random_prime(key->q, n_size/2, 1,
-			      random_ctx, random,
-			      progress_ctx, progress);
+      random_prime(p, bits, 1,
+		   random_ctx, random,
+		   progress_ctx, progress);
 
-	  mpz_sub_ui(q1, key->q, 1);
-      
-	  /* If e was given, we must choose q such that q-1 has no factors in
-	   * common with e. */
-	  if (e_size)
-	    break;
-	  
-	  mpz_gcd(tmp, pub->e, q1);
-
-	  if (mpz_cmp_ui(tmp, 1) == 0)
-	    break;
-	  else if (progress) progress(progress_ctx, 'c');
-	}
-
-      /* Now we have the primes. Is the product of the right size? */
-      mpz_mul(pub->n, key->p, key->q);
+      mpz_sub_ui(p1, p, 1);
 
-      assert (mpz_sizeinbase(pub->n, 2) == n_size);
+      if (!e)
+	break;
 
-      if (progress)
-	progress(progress_ctx, '\n');
+      mpz_gcd(tmp, e, p1);
 
-      /* c = q^{-1} (mod p) */
-      if (mpz_invert(key->c, key->q, key->p))
-	/* This should succeed everytime. But if it doesn't,
-	 * we try again. */
+      if (mpz_cmp_ui(tmp, 1) == 0)
 	break;
-      else if (progress) progress(progress_ctx, '?');
+      else if (progress) progress(progress_ctx, 'c');
     }
+  mpz_clear(tmp);
+}
+
+/* Computes the exponents, given p1 = p-1, q1 = q-1, n and c. If
+   e_size is non-zero, a random e is generated. Returns zero if a fixed
+   e is not invertible. */
+static int
+compute_exponents(struct rsa_public_key *pub,
+		  struct rsa_private_key *key,
+		  void *random_ctx, nettle_random_func *random,
+		  void *progress_ctx, nettle_progress_func *progress,
+		  const mpz_t p1, const mpz_t q1,
+		  unsigned n_size, unsigned e_size)
+{
+  mpz_t phi;
+  mpz_t d;
 
+  mpz_init(phi);
+  mpz_init(d);
   mpz_mul(phi, p1, q1);
   
   /* If we didn't have a given e, generate one now. */
@@ -174,7 +152,7 @@ rsa_generate_keypair(struct rsa_public_key *pub,
 	  mpz_setbit(pub->e, e_size - 1);
 
 	  /* Needs gmp-3, or inverse might be negative. */
-	  if (mpz_invert(key->d, pub->e, phi))
+	  if (mpz_invert(d, pub->e, phi))
 	    break;
 
 	  if (progress) progress(progress_ctx, 'e');
@@ -183,14 +161,16 @@ rsa_generate_keypair(struct rsa_public_key *pub,
       if (retried && progress)
 	progress(progress_ctx, '\n');	
     }
-  else
+  else if (!mpz_invert(d, pub->e, phi))
     {
-      /* Must always succeed, as we already that e
-       * doesn't have any common factor with p-1 or q-1. */
-      int res = mpz_invert(key->d, pub->e, phi);
-      assert(res);
+      mpz_clear(phi);
+      mpz_clear(d);
+      return 0;
     }
 
+  /* The key is modified only on success. */
+  mpz_swap(key->d, d);
+
   /* Done! Almost, we must compute the auxillary private values. */
   /* a = d % (p-1) */
   mpz_fdiv_r(key->a, key->d, p1);
@@ -203,7 +183,160 @@ rsa_generate_keypair(struct rsa_public_key *pub,
   pub->size = key->size = (n_size + 7) / 8;
   assert(pub->size >= RSA_MINIMUM_N_OCTETS);
   
-  mpz_clear(p1); mpz_clear(q1); mpz_clear(phi); mpz_clear(tmp);
+  mpz_clear(phi);
+  mpz_clear(d);
 
   return 1;
 }
+
+static int
+generate_keypair(struct rsa_public_key *pub,
+		 struct rsa_private_key *key,
+		 void *random_ctx, nettle_random_func *random,
+		 void *progress_ctx, nettle_progress_func *progress,
+		 unsigned n_size,
+		 unsigned e_size,
+		 prime_func *random_prime)
+{
+  mpz_t p1;
+  mpz_t q1;
+  int res;
+
+  if (!check_sizes(pub, n_size, e_size))
+    return 0;
+  
+  mpz_init(p1); mpz_init(q1);
+
+  /* Generate primes */
+  for (;;)
+    {
+      /* Generate p, such that gcd(p-1, e) = 1. If e was given, we
+       * must choose p such that p-1 has no factors in common with
+       * e. */
+      generate_prime(key->p, p1, (n_size+1)/2, e_size ? NULL : pub->e,
+		     random_ctx, random, progress_ctx, progress,
+		     random_prime);
+
+      if (progress)
+	progress(progress_ctx, '\n');
+      
+      /* Generate q, such that gcd(q-1, e) = 1 */
+      generate_prime(key->q, q1, n_size/2, e_size ? NULL : pub->e,
+		     random_ctx, random, progress_ctx, progress,
+		     random_prime);
+
+      /* Now we have the primes. Is the product of the right size? */
+      mpz_mul(pub->n, key->p, key->q);
+
+      assert (mpz_sizeinbase(pub->n, 2) == n_size);
+
+      if (progress)
+	progress(progress_ctx, '\n');
+
+      /* c = q^{-1} (mod p) */
+      if (mpz_invert(key->c, key->q, key->p))
+	/* This should succeed everytime. But if it doesn't,
+	 * we try again. */
+	break;
+      else if (progress) progress(progress_ctx, '?');
+    }
+
+  /* Must always succeed, as we already that e
+   * doesn't have any common factor with p-1 or q-1. */
+  res = compute_exponents(pub, key, random_ctx, random,
+			  progress_ctx, progress, p1, q1, n_size, e_size);
+  assert(res);
+
+  mpz_clear(p1); mpz_clear(q1);
+
+  return res;
+}
+
+int
+rsa_generate_keypair(struct rsa_public_key *pub,
+		     struct rsa_private_key *key,
+		     void *random_ctx, nettle_random_func *random,
+		     void *progress_ctx, nettle_progress_func *progress,
+		     unsigned n_size,
+		     unsigned e_size)
+{
+  return generate_keypair(pub, key, random_ctx, random,
+			  progress_ctx, progress, n_size, e_size,
+			  nettle_random_prime);
+}
+
+int
+rsa_generate_keypair_sieve(struct rsa_public_key *pub,
+			   struct rsa_private_key *key,
+			   void *random_ctx, nettle_random_func *random,
+			   void *progress_ctx, nettle_progress_func *progress,
+			   unsigned n_size,
+			   unsigned e_size)
+{
+  return generate_keypair(pub, key, random_ctx, random,
+			  progress_ctx, progress, n_size, e_size,
+			  _nettle_random_prime_sieve);
+}
+
+void
+rsa_generate_prime(mpz_t p, unsigned bits, const mpz_t e,
+		   void *random_ctx, nettle_random_func *random,
+		   void *progress_ctx, nettle_progress_func *progress)
+{
+  mpz_t p1;
+
+  assert (bits > 20);
+
+  mpz_init(p1);
+  generate_prime(p, p1, bits, e, random_ctx, random,
+		 progress_ctx, progress, _nettle_random_prime_sieve);
+  mpz_clear(p1);
+}
+
+int
+rsa_keypair_from_primes(struct rsa_public_key *pub,
+			struct rsa_private_key *key,
+			void *random_ctx, nettle_random_func *random,
+			void *progress_ctx, nettle_progress_func *progress,
+			unsigned n_size,
+			unsigned e_size)
+{
+  mpz_t n;
+  mpz_t c;
+  mpz_t p1;
+  mpz_t q1;
+  int res;
+
+  if (!check_sizes(pub, n_size, e_size))
+    return 0;
+
+  /* n and c are computed into temporaries, so that neither key is
+     modified on failure. */
+  mpz_init(n); mpz_init(c);
+  mpz_mul(n, key->p, key->q);
+
+  /* c = q^{-1} (mod p), fails if p = q. */
+  if (mpz_sizeinbase(n, 2) != n_size
+      || !mpz_invert(c, key->q, key->p))
+    {
+      mpz_clear(n); mpz_clear(c);
+      return 0;
+    }
+
+  mpz_init(p1); mpz_init(q1);
+  mpz_sub_ui(p1, key->p, 1);
+  mpz_sub_ui(q1, key->q, 1);
+
+  res = compute_exponents(pub, key, random_ctx, random,
+			  progress_ctx, progress, p1, q1, n_size, e_size);
+  if (res)
+    {
+      mpz_swap(pub->n, n);
+      mpz_swap(key->c, c);
+    }
+
+  mpz_clear(p1); mpz_clear(q1);
+  mpz_clear(n); mpz_clear(c);
+
+  return res;
+}
@@ -42,23 +42,18 @@
 
 #include "bignum.h"
 #include "pkcs1.h"
+#include "pkcs1-internal.h"
 
 int
 rsa_md5_verify(const struct rsa_public_key *key,
-               struct md5_ctx *hash,
-               const mpz_t s)
+	       struct md5_ctx *hash,
+	       const mpz_t s)
 {
-  int res;
-  mpz_t m;
-
-  mpz_init(m);
+  uint8_t digest[MD5_DIGEST_SIZE];
 
-  res = (pkcs1_rsa_md5_encode(m, key->size, hash)
-	 && _rsa_verify(key, m, s));
+  md5_digest(hash, sizeof(digest), digest);
 
-  mpz_clear(m);
-
-  return res;
+  return rsa_md5_verify_digest(key, digest, s);
 }
 
 int
@@ -66,13 +61,14 @@ rsa_md5_verify_digest(const struct rsa_public_key *key,
 		      const uint8_t *digest,
 		      const mpz_t s)
 {
+  const uint8_t *em;
   int res;
   mpz_t m;
 
   mpz_init(m);
-  
-  res = (pkcs1_rsa_md5_encode_digest(m, key->size, digest)
-	 && _rsa_verify(key, m, s));
+
+  em = _rsa_verify_recover_octets(key, m, s);
+  res = em && _pkcs1_rsa_md5_check_digest(key->size, em, digest);
 
   mpz_clear(m);
 
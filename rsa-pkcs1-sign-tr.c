@@ -38,6 +38,8 @@
 #include "rsa-internal.h"
 
 #include "pkcs1.h"
+#include "pkcs1-internal.h"
+#include "gmp-glue.h"
 
 /* Side-channel resistant version of rsa_pkcs1_sign() */
 int
@@ -47,14 +49,63 @@ rsa_pkcs1_sign_tr(const struct rsa_public_key *pub,
 	          size_t length, const uint8_t *digest_info,
    	          mpz_t s)
 {
-  mpz_t m;
-  int ret;
+  TMP_GMP_DECL (scratch, mp_limb_t);
+  int res;
 
-  mpz_init(m);
+  TMP_GMP_ALLOC (scratch, rsa_sec_itch (pub, key));
 
-  ret = (pkcs1_rsa_digest_encode (m, key->size, length, digest_info)
-	 && rsa_compute_root_tr (pub, key, random_ctx, random,
-				 s, m));
-  mpz_clear(m);
-  return ret;
+  res = rsa_pkcs1_sign_tr_scratch (pub, key, random_ctx, random,
+				   length, digest_info, s, scratch);
+
+  TMP_GMP_FREE (scratch);
+  return res;
+}
+
+int
+rsa_pkcs1_sign_tr_scratch(const struct rsa_public_key *pub,
+			  const struct rsa_private_key *key,
+			  void *random_ctx, nettle_random_func *random,
+			  size_t length, const uint8_t *digest_info,
+			  mpz_t s, mp_limb_t *scratch)
+{
+  uint8_t *em = RSA_SEC_SIGN_EM (key, scratch, key->size);
+
+  return (_pkcs1_rsa_digest_encode (key->size, em, length, digest_info)
+	  && _rsa_sec_sign_tr (pub, key, random_ctx, random,
+			       key->size, s, scratch));
+}
+
+int
+rsa_pkcs1_sign_pool(const struct rsa_public_key *pub,
+		    const struct rsa_private_key *key,
+		    struct rsa_blinding_pool *pool,
+		    void *random_ctx, nettle_random_func *random,
+		    size_t length, const uint8_t *digest_info,
+		    mpz_t s)
+{
+  TMP_GMP_DECL (scratch, mp_limb_t);
+  int res;
+
+  TMP_GMP_ALLOC (scratch, rsa_sec_itch (pub, key));
+
+  res = rsa_pkcs1_sign_pool_scratch (pub, key, pool, random_ctx, random,
+				     length, digest_info, s, scratch);
+
+  TMP_GMP_FREE (scratch);
+  return res;
+}
+
+int
+rsa_pkcs1_sign_pool_scratch(const struct rsa_public_key *pub,
+			    const struct rsa_private_key *key,
+			    struct rsa_blinding_pool *pool,
+			    void *random_ctx, nettle_random_func *random,
+			    size_t length, const uint8_t *digest_info,
+			    mpz_t s, mp_limb_t *scratch)
+{
+  uint8_t *em = RSA_SEC_SIGN_EM (key, scratch, key->size);
+
+  return (_pkcs1_rsa_digest_encode (key->size, em, length, digest_info)
+	  && _rsa_sec_sign_pool (pub, key, pool, random_ctx, random,
+				 key->size, s, scratch));
 }
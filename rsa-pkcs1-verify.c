@@ -39,19 +39,21 @@
 #include "rsa-internal.h"
 
 #include "pkcs1.h"
+#include "pkcs1-internal.h"
 
 int
 rsa_pkcs1_verify(const struct rsa_public_key *key,
 		 size_t length, const uint8_t *digest_info,
 		 const mpz_t s)
 {
+  const uint8_t *em;
   int res;
   mpz_t m;
 
   mpz_init (m);
 
-  res = (pkcs1_rsa_digest_encode (m, key->size, length, digest_info)
-	 && _rsa_verify (key, m, s));
+  em = _rsa_verify_recover_octets (key, m, s);
+  res = em && _pkcs1_rsa_digest_check (key->size, em, length, digest_info);
 
   mpz_clear(m);
 
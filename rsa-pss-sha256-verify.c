@@ -47,15 +47,6 @@ rsa_pss_sha256_verify_digest(const struct rsa_public_key *key,
 			     const uint8_t *digest,
 			     const mpz_t signature)
 {
-  int res;
-  mpz_t m;
-
-  mpz_init (m);
-
-  res = (_rsa_verify_recover(key, m, signature) &&
-	 pss_verify_mgf1(m, mpz_sizeinbase(key->n, 2) - 1, &nettle_sha256,
-			 salt_length, digest));
-
-  mpz_clear (m);
-  return res;
+  return _rsa_pss_verify_digest(key, &nettle_sha256, salt_length, digest,
+				signature);
 }
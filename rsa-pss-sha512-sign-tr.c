@@ -40,6 +40,8 @@
 
 #include "bignum.h"
 #include "pss.h"
+#include "pkcs1-internal.h"
+#include "gmp-glue.h"
 
 int
 rsa_pss_sha384_sign_digest_tr(const struct rsa_public_key *pub,
@@ -49,21 +51,36 @@ rsa_pss_sha384_sign_digest_tr(const struct rsa_public_key *pub,
 			      const uint8_t *digest,
 			      mpz_t s)
 {
-  mpz_t m;
+  TMP_GMP_DECL (scratch, mp_limb_t);
   int res;
 
-  mpz_init (m);
+  TMP_GMP_ALLOC (scratch, rsa_sec_itch (pub, key));
 
-  res = (pss_encode_mgf1(m, mpz_sizeinbase(pub->n, 2) - 1, &nettle_sha384,
-			 salt_length, salt, digest)
-	 && rsa_compute_root_tr (pub, key,
-				 random_ctx, random,
-				 s, m));
+  res = rsa_pss_sha384_sign_digest_tr_scratch (pub, key, random_ctx, random,
+					       salt_length, salt, digest, s, scratch);
 
-  mpz_clear (m);
+  TMP_GMP_FREE (scratch);
   return res;
 }
 
+int
+rsa_pss_sha384_sign_digest_tr_scratch(const struct rsa_public_key *pub,
+				      const struct rsa_private_key *key,
+				      void *random_ctx,
+				      nettle_random_func *random,
+				      size_t salt_length, const uint8_t *salt,
+				      const uint8_t *digest,
+				      mpz_t s, mp_limb_t *scratch)
+{
+  size_t bits = mpz_sizeinbase(pub->n, 2) - 1;
+  uint8_t *em = RSA_SEC_SIGN_EM (key, scratch, (bits + 7) / 8);
+
+  return (_pss_encode_mgf1(em, bits, &nettle_sha384,
+			   salt_length, salt, digest)
+	  && _rsa_sec_sign_tr (pub, key, random_ctx, random,
+			       (bits + 7) / 8, s, scratch));
+}
+
 int
 rsa_pss_sha512_sign_digest_tr(const struct rsa_public_key *pub,
 			      const struct rsa_private_key *key,
@@ -72,17 +89,32 @@ rsa_pss_sha512_sign_digest_tr(const struct rsa_public_key *pub,
 			      const uint8_t *digest,
 			      mpz_t s)
 {
-  mpz_t m;
+  TMP_GMP_DECL (scratch, mp_limb_t);
   int res;
 
-  mpz_init (m);
+  TMP_GMP_ALLOC (scratch, rsa_sec_itch (pub, key));
 
-  res = (pss_encode_mgf1(m, mpz_sizeinbase(pub->n, 2) - 1, &nettle_sha512,
-			 salt_length, salt, digest)
-	 && rsa_compute_root_tr (pub, key,
-				 random_ctx, random,
-				 s, m));
+  res = rsa_pss_sha512_sign_digest_tr_scratch (pub, key, random_ctx, random,
+					       salt_length, salt, digest, s, scratch);
 
-  mpz_clear (m);
+  TMP_GMP_FREE (scratch);
   return res;
 }
+
+int
+rsa_pss_sha512_sign_digest_tr_scratch(const struct rsa_public_key *pub,
+				      const struct rsa_private_key *key,
+				      void *random_ctx,
+				      nettle_random_func *random,
+				      size_t salt_length, const uint8_t *salt,
+				      const uint8_t *digest,
+				      mpz_t s, mp_limb_t *scratch)
+{
+  size_t bits = mpz_sizeinbase(pub->n, 2) - 1;
+  uint8_t *em = RSA_SEC_SIGN_EM (key, scratch, (bits + 7) / 8);
+
+  return (_pss_encode_mgf1(em, bits, &nettle_sha512,
+			   salt_length, salt, digest)
+	  && _rsa_sec_sign_tr (pub, key, random_ctx, random,
+			       (bits + 7) / 8, s, scratch));
+}
@@ -47,17 +47,8 @@ rsa_pss_sha384_verify_digest(const struct rsa_public_key *key,
 			     const uint8_t *digest,
 			     const mpz_t signature)
 {
-  int res;
-  mpz_t m;
-
-  mpz_init (m);
-
-  res = (_rsa_verify_recover(key, m, signature) &&
-	 pss_verify_mgf1(m, mpz_sizeinbase(key->n, 2) - 1, &nettle_sha384,
-			 salt_length, digest));
-
-  mpz_clear (m);
-  return res;
+  return _rsa_pss_verify_digest(key, &nettle_sha384, salt_length, digest,
+				signature);
 }
 
 int
@@ -66,15 +57,6 @@ rsa_pss_sha512_verify_digest(const struct rsa_public_key *key,
 			     const uint8_t *digest,
 			     const mpz_t signature)
 {
-  int res;
-  mpz_t m;
-
-  mpz_init (m);
-
-  res = (_rsa_verify_recover(key, m, signature) &&
-	 pss_verify_mgf1(m, mpz_sizeinbase(key->n, 2) - 1, &nettle_sha512,
-			 salt_length, digest));
-
-  mpz_clear (m);
-  return res;
+  return _rsa_pss_verify_digest(key, &nettle_sha512, salt_length, digest,
+				signature);
 }
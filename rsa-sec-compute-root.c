@@ -40,6 +40,7 @@
 
 #include "rsa.h"
 #include "rsa-internal.h"
+#include "bignum-backend.h"
 #include "gmp-glue.h"
 
 #if !NETTLE_USE_MINI_GMP
@@ -92,8 +93,10 @@ sec_mod_mul (mp_limb_t *rp,
 static mp_size_t
 sec_powm_itch (mp_size_t bn, mp_size_t en, mp_size_t mn)
 {
+  const struct bignum_backend *backend = BIGNUM_BACKEND;
   mp_size_t mod_itch = bn + mpn_sec_div_r_itch (bn, mn);
-  mp_size_t pow_itch = mn + mpn_sec_powm_itch (mn, en * GMP_NUMB_BITS, mn);
+  mp_size_t pow_itch = mn + backend->sec_powm_itch (mn, en * GMP_NUMB_BITS,
+						    mn);
   return MAX (mod_itch, pow_itch);
 }
 
@@ -105,12 +108,14 @@ sec_powm (mp_limb_t *rp,
 	  const mp_limb_t *ep, mp_size_t en,
 	  const mp_limb_t *mp, mp_size_t mn, mp_limb_t *scratch)
 {
+  const struct bignum_backend *backend = BIGNUM_BACKEND;
+
   assert (bn >= mn);
   assert (en <= mn);
   mpn_copyi (scratch, bp, bn);
   mpn_sec_div_r (scratch, bn, mp, mn, scratch + bn);
-  mpn_sec_powm (rp, scratch, mn, ep, en * GMP_NUMB_BITS, mp, mn,
-		scratch + mn);
+  backend->sec_powm (rp, scratch, mn, ep, en * GMP_NUMB_BITS, mp, mn,
+		     scratch + mn);
 }
 
 mp_size_t
@@ -51,23 +51,39 @@ rsa_sec_decrypt(const struct rsa_public_key *pub,
 	        size_t length, uint8_t *message,
 	        const mpz_t gibberish)
 {
-  TMP_GMP_DECL (m, mp_limb_t);
-  TMP_GMP_DECL (em, uint8_t);
+  TMP_GMP_DECL (scratch, mp_limb_t);
   int res;
 
-  TMP_GMP_ALLOC (m, mpz_size(pub->n));
-  TMP_GMP_ALLOC (em, key->size);
+  TMP_GMP_ALLOC (scratch, rsa_sec_itch (pub, key));
+
+  res = rsa_sec_decrypt_scratch (pub, key, random_ctx, random,
+				 length, message, gibberish, scratch);
+
+  TMP_GMP_FREE (scratch);
+  return res;
+}
+
+int
+rsa_sec_decrypt_scratch(const struct rsa_public_key *pub,
+			const struct rsa_private_key *key,
+			void *random_ctx, nettle_random_func *random,
+			size_t length, uint8_t *message,
+			const mpz_t gibberish, mp_limb_t *scratch)
+{
+  mp_size_t nn = mpz_size(pub->n);
+  mp_limb_t *m = scratch;
+  uint8_t *em = (uint8_t *) (scratch + nn);
+  int res;
 
   res = _rsa_sec_compute_root_tr (pub, key, random_ctx, random, m,
 				  mpz_limbs_read(gibberish),
-				  mpz_size(gibberish));
+				  mpz_size(gibberish),
+				  scratch + 2 * nn);
 
-  mpn_get_base256 (em, key->size, m, mpz_size(pub->n));
+  mpn_get_base256 (em, key->size, m, nn);
 
   res &= _pkcs1_sec_decrypt (length, message, key->size, em);
 
-  TMP_GMP_FREE (em);
-  TMP_GMP_FREE (m);
   return res;
 }
 
@@ -39,10 +39,13 @@
 
 #include "rsa.h"
 #include "rsa-internal.h"
+#include "pkcs1-internal.h"
 
 #include "bignum.h"
 #include "pkcs1.h"
 
+#include "gmp-glue.h"
+
 int
 rsa_sha1_sign_tr(const struct rsa_public_key *pub,
 		 const struct rsa_private_key *key,
@@ -69,16 +72,28 @@ rsa_sha1_sign_digest_tr(const struct rsa_public_key *pub,
 			const uint8_t *digest,
 			mpz_t s)
 {
-  mpz_t m;
+  TMP_GMP_DECL (scratch, mp_limb_t);
   int res;
 
-  mpz_init (m);
+  TMP_GMP_ALLOC (scratch, rsa_sec_itch (pub, key));
 
-  res = (pkcs1_rsa_sha1_encode_digest(m, key->size, digest)
-	 && rsa_compute_root_tr (pub, key,
-				 random_ctx, random,
-				 s, m));
+  res = rsa_sha1_sign_digest_tr_scratch (pub, key, random_ctx, random,
+					 digest, s, scratch);
 
-  mpz_clear (m);
+  TMP_GMP_FREE (scratch);
   return res;
 }
+
+int
+rsa_sha1_sign_digest_tr_scratch(const struct rsa_public_key *pub,
+				const struct rsa_private_key *key,
+				void *random_ctx, nettle_random_func *random,
+				const uint8_t *digest,
+				mpz_t s, mp_limb_t *scratch)
+{
+  uint8_t *em = RSA_SEC_SIGN_EM (key, scratch, key->size);
+
+  return (_pkcs1_rsa_sha1_encode_digest (key->size, em, digest)
+	  && _rsa_sec_sign_tr (pub, key, random_ctx, random,
+			       key->size, s, scratch));
+}
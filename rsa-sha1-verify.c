@@ -42,23 +42,18 @@
 
 #include "bignum.h"
 #include "pkcs1.h"
+#include "pkcs1-internal.h"
 
 int
 rsa_sha1_verify(const struct rsa_public_key *key,
-                struct sha1_ctx *hash,
-                const mpz_t s)
+		struct sha1_ctx *hash,
+		const mpz_t s)
 {
-  int res;
-  mpz_t m;
+  uint8_t digest[SHA1_DIGEST_SIZE];
 
-  mpz_init(m);
-  
-  res = (pkcs1_rsa_sha1_encode(m, key->size, hash)
-	 && _rsa_verify(key, m, s));
-  
-  mpz_clear(m);
+  sha1_digest(hash, sizeof(digest), digest);
 
-  return res;
+  return rsa_sha1_verify_digest(key, digest, s);
 }
 
 int
@@ -66,14 +61,15 @@ rsa_sha1_verify_digest(const struct rsa_public_key *key,
 		       const uint8_t *digest,
 		       const mpz_t s)
 {
+  const uint8_t *em;
   int res;
   mpz_t m;
 
   mpz_init(m);
-  
-  res = (pkcs1_rsa_sha1_encode_digest(m, key->size, digest)
-	 && _rsa_verify(key, m, s));
-  
+
+  em = _rsa_verify_recover_octets(key, m, s);
+  res = em && _pkcs1_rsa_sha1_check_digest(key->size, em, digest);
+
   mpz_clear(m);
 
   return res;
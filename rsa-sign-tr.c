@@ -38,8 +38,11 @@
 #endif
 
 #include <assert.h>
+#include <string.h>
 
+#include "bignum-backend.h"
 #include "gmp-glue.h"
+#include "hogweed-internal.h"
 #include "rsa.h"
 #include "rsa-internal.h"
 
@@ -65,10 +68,10 @@ rsa_blind (const struct rsa_public_key *pub,
       nettle_mpz_random(r, random_ctx, random, pub->n);
       /* invert r */
     }
-  while (!mpz_invert (ri, r, pub->n));
+  while (!_bignum_sec_invert (ri, r, pub->n));
 
   /* c = c*(r^e) mod n */
-  mpz_powm_sec(r, r, pub->e, pub->n);
+  _bignum_sec_powm(r, r, pub->e, pub->n);
   mpz_mul(c, m, r);
   mpz_fdiv_r(c, c, pub->n);
 
@@ -86,14 +89,17 @@ rsa_unblind (const struct rsa_public_key *pub,
 
 /* Checks for any errors done in the RSA computation. That avoids
  * attacks which rely on faults on hardware, or even software MPI
- * implementation. */
+ * implementation. If pool is non-NULL, not empty, and filled for
+ * this key, blinding uses precomputed factors from the pool. */
 int
-rsa_compute_root_tr(const struct rsa_public_key *pub,
-		    const struct rsa_private_key *key,
-		    void *random_ctx, nettle_random_func *random,
-		    mpz_t x, const mpz_t m)
+rsa_compute_root_pool(const struct rsa_public_key *pub,
+		      const struct rsa_private_key *key,
+		      struct rsa_blinding_pool *pool,
+		      void *random_ctx, nettle_random_func *random,
+		      mpz_t x, const mpz_t m)
 {
   int res;
+  int entry;
   mpz_t t, mb, xb, ri;
 
   /* mpz_powm_sec handles only odd moduli. If p, q or n is even, the
@@ -109,16 +115,28 @@ rsa_compute_root_tr(const struct rsa_public_key *pub,
   mpz_init (ri);
   mpz_init (t);
 
-  rsa_blind (pub, random_ctx, random, mb, ri, m);
+  entry = pool ? _rsa_blinding_pool_next (pool, pub) : -1;
+  if (entry >= 0)
+    {
+      mpz_mul (mb, m, pool->blind[entry]);
+      mpz_fdiv_r (mb, mb, pub->n);
+      mpz_set (ri, pool->unblind[entry]);
+    }
+  else
+    rsa_blind (pub, random_ctx, random, mb, ri, m);
 
   rsa_compute_root (key, xb, mb);
 
-  mpz_powm_sec(t, xb, pub->e, pub->n);
+  _bignum_sec_powm(t, xb, pub->e, pub->n);
   res = (mpz_cmp(mb, t) == 0);
 
   if (res)
     rsa_unblind (pub, x, ri, xb);
 
+  /* Prepare the entry for its next use, r -> r^2. */
+  if (entry >= 0 && pool->uses[entry] > 0)
+    _rsa_blinding_pool_update (pool, pub, entry, NULL);
+
   mpz_clear (mb);
   mpz_clear (xb);
   mpz_clear (ri);
@@ -128,10 +146,30 @@ rsa_compute_root_tr(const struct rsa_public_key *pub,
 }
 
 int
-_rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
-			 const struct rsa_private_key *key,
-			 void *random_ctx, nettle_random_func *random,
-			 mp_limb_t *x, const mp_limb_t *m, size_t mn)
+rsa_compute_root_tr(const struct rsa_public_key *pub,
+		    const struct rsa_private_key *key,
+		    void *random_ctx, nettle_random_func *random,
+		    mpz_t x, const mpz_t m)
+{
+  return rsa_compute_root_pool (pub, key, NULL, random_ctx, random, x, m);
+}
+
+/* The mini-gmp version works on mpz_t values, and needs no scratch
+   space. */
+mp_size_t
+_rsa_sec_compute_root_tr_itch (const struct rsa_public_key *pub UNUSED,
+			       const struct rsa_private_key *key UNUSED)
+{
+  return 0;
+}
+
+int
+_rsa_sec_compute_root_pool(const struct rsa_public_key *pub,
+			   const struct rsa_private_key *key,
+			   struct rsa_blinding_pool *pool,
+			   void *random_ctx, nettle_random_func *random,
+			   mp_limb_t *x, const mp_limb_t *m, size_t mn,
+			   mp_limb_t *scratch UNUSED)
 {
   mpz_t mz;
   mpz_t xz;
@@ -143,7 +181,7 @@ _rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
   mpn_copyi(mpz_limbs_write(mz, mn), m, mn);
   mpz_limbs_finish(mz, mn);
 
-  res = rsa_compute_root_tr(pub, key, random_ctx, random, xz, mz);
+  res = rsa_compute_root_pool(pub, key, pool, random_ctx, random, xz, mz);
 
   if (res)
     mpz_limbs_copy(x, xz, mpz_size(pub->n));
@@ -152,87 +190,131 @@ _rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
   mpz_clear(xz);
   return res;
 }
+
+int
+_rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
+			 const struct rsa_private_key *key,
+			 void *random_ctx, nettle_random_func *random,
+			 mp_limb_t *x, const mp_limb_t *m, size_t mn,
+			 mp_limb_t *scratch)
+{
+  return _rsa_sec_compute_root_pool (pub, key, NULL, random_ctx, random,
+				     x, m, mn, scratch);
+}
 #else
+/* Scratch space needed by rsa_sec_blind, assuming mn <= nn. */
+static mp_size_t
+rsa_sec_blind_itch (const struct rsa_public_key *pub)
+{
+  const struct bignum_backend *backend = BIGNUM_BACKEND;
+  mp_bitcnt_t ebn = mpz_sizeinbase (pub->e, 2);
+  mp_size_t nn = mpz_size (pub->n);
+  size_t itch;
+  size_t i2;
+
+  itch = backend->sec_powm_itch(nn, ebn, nn);
+  i2 = mpn_sec_mul_itch(nn, nn);
+  itch = MAX(itch, i2);
+  i2 = mpn_sec_div_r_itch(nn + nn, nn);
+  itch = MAX(itch, i2);
+  i2 = backend->sec_invert_itch(nn);
+  itch = MAX(itch, i2);
+
+  /* nn limbs for rp, and nn + mn for tp. */
+  return 3 * nn + itch;
+}
+
 /* Blinds m, by computing c = m r^e (mod n), for a random r. Also
    returns the inverse (ri), for use by rsa_unblind. */
 static void
 rsa_sec_blind (const struct rsa_public_key *pub,
                void *random_ctx, nettle_random_func *random,
                mp_limb_t *c, mp_limb_t *ri, const mp_limb_t *m,
-               mp_size_t mn)
+               mp_size_t mn, mp_limb_t *scratch)
 {
+  const struct bignum_backend *backend = BIGNUM_BACKEND;
   const mp_limb_t *ep = mpz_limbs_read (pub->e);
   const mp_limb_t *np = mpz_limbs_read (pub->n);
   mp_bitcnt_t ebn = mpz_sizeinbase (pub->e, 2);
   mp_size_t nn = mpz_size (pub->n);
-  size_t itch;
-  size_t i2;
-  mp_limb_t *scratch;
-  TMP_GMP_DECL (tp, mp_limb_t);
-  TMP_GMP_DECL (rp, mp_limb_t);
-  TMP_GMP_DECL (r, uint8_t);
-
-  TMP_GMP_ALLOC (rp, nn);
-  TMP_GMP_ALLOC (r, nn * sizeof(mp_limb_t));
+  mp_limb_t *rp = scratch;
+  mp_limb_t *tp = scratch + nn;
 
-  /* c = m*(r^e) mod n */
-  itch = mpn_sec_powm_itch(nn, ebn, nn);
-  i2 = mpn_sec_mul_itch(nn, mn);
-  itch = MAX(itch, i2);
-  i2 = mpn_sec_div_r_itch(nn + mn, nn);
-  itch = MAX(itch, i2);
-  i2 = mpn_sec_invert_itch(nn);
-  itch = MAX(itch, i2);
-
-  TMP_GMP_ALLOC (tp, nn + mn + itch);
   scratch = tp + nn + mn;
 
-  /* ri = r^(-1) */
+  /* ri = r^(-1). The random octets are generated into tp, which is
+     overwritten once they have been converted. */
   do
     {
-      random(random_ctx, nn * sizeof(mp_limb_t), (uint8_t *)r);
-      mpn_set_base256(rp, nn, r, nn * sizeof(mp_limb_t));
+      random(random_ctx, nn * sizeof(mp_limb_t), (uint8_t *) tp);
+      mpn_set_base256(rp, nn, (uint8_t *) tp, nn * sizeof(mp_limb_t));
       mpn_copyi(tp, rp, nn);
       /* invert r */
     }
-  while (!mpn_sec_invert (ri, tp, np, nn, 2 * nn * GMP_NUMB_BITS, scratch));
+  while (!backend->sec_invert (ri, tp, np, nn, 2 * nn * GMP_NUMB_BITS,
+			       scratch));
 
-  mpn_sec_powm (c, rp, nn, ep, ebn, np, nn, scratch);
+  /* c = m*(r^e) mod n */
+  backend->sec_powm (c, rp, nn, ep, ebn, np, nn, scratch);
   /* normally mn == nn, but m can be smaller in some cases */
   mpn_sec_mul (tp, c, nn, m, mn, scratch);
   mpn_sec_div_r (tp, nn + mn, np, nn, scratch);
   mpn_copyi(c, tp, nn);
-
-  TMP_GMP_FREE (r);
-  TMP_GMP_FREE (rp);
-  TMP_GMP_FREE (tp);
 }
 
-/* m = c ri mod n */
+/* Like rsa_sec_blind, but using the precomputed factors of entry i
+   of the pool, c = m r^e (mod n) and ri = r^{-1} (mod n). Needs no
+   more scratch than rsa_sec_blind. */
 static void
-rsa_sec_unblind (const struct rsa_public_key *pub,
-                 mp_limb_t *x, mp_limb_t *ri, const mp_limb_t *c)
+rsa_sec_blind_pool (const struct rsa_public_key *pub,
+		    const struct rsa_blinding_pool *pool, unsigned i,
+		    mp_limb_t *c, mp_limb_t *ri, const mp_limb_t *m,
+		    mp_size_t mn, mp_limb_t *scratch)
 {
   const mp_limb_t *np = mpz_limbs_read (pub->n);
   mp_size_t nn = mpz_size (pub->n);
+  mp_limb_t *rp = scratch;
+  mp_limb_t *tp = scratch + nn;
+
+  scratch = tp + nn + mn;
 
+  mpz_limbs_copy (rp, pool->blind[i], nn);
+  mpz_limbs_copy (ri, pool->unblind[i], nn);
+
+  mpn_sec_mul (tp, rp, nn, m, mn, scratch);
+  mpn_sec_div_r (tp, nn + mn, np, nn, scratch);
+  mpn_copyi(c, tp, nn);
+}
+
+static mp_size_t
+rsa_sec_unblind_itch (const struct rsa_public_key *pub)
+{
+  mp_size_t nn = mpz_size (pub->n);
   size_t itch;
   size_t i2;
-  mp_limb_t *scratch;
-  TMP_GMP_DECL(tp, mp_limb_t);
 
   itch = mpn_sec_mul_itch(nn, nn);
   i2 = mpn_sec_div_r_itch(nn + nn, nn);
   itch = MAX(itch, i2);
 
-  TMP_GMP_ALLOC (tp, nn + nn + itch);
+  return nn + nn + itch;
+}
+
+/* m = c ri mod n */
+static void
+rsa_sec_unblind (const struct rsa_public_key *pub,
+                 mp_limb_t *x, mp_limb_t *ri, const mp_limb_t *c,
+                 mp_limb_t *scratch)
+{
+  const mp_limb_t *np = mpz_limbs_read (pub->n);
+  mp_size_t nn = mpz_size (pub->n);
+  mp_limb_t *tp = scratch;
+
   scratch = tp + nn + nn;
 
   mpn_sec_mul (tp, c, nn, ri, nn, scratch);
   mpn_sec_div_r (tp, nn + nn, np, nn, scratch);
   mpn_copyi(x, tp, nn);
-
-  TMP_GMP_FREE (tp);
 }
 
 static int
@@ -250,30 +332,29 @@ sec_equal(const mp_limb_t *a, const mp_limb_t *b, size_t limbs)
   return z == 0;
 }
 
+static mp_size_t
+rsa_sec_check_root_itch (const struct rsa_public_key *pub)
+{
+  mp_size_t nn = mpz_size (pub->n);
+  mp_size_t ebn = mpz_sizeinbase (pub->e, 2);
+
+  return nn + BIGNUM_BACKEND->sec_powm_itch (nn, ebn, nn);
+}
+
 static int
 rsa_sec_check_root(const struct rsa_public_key *pub,
-                   const mp_limb_t *x, const mp_limb_t *m)
+                   const mp_limb_t *x, const mp_limb_t *m,
+                   mp_limb_t *scratch)
 {
   mp_size_t nn = mpz_size (pub->n);
   mp_size_t ebn = mpz_sizeinbase (pub->e, 2);
   const mp_limb_t *np = mpz_limbs_read (pub->n);
   const mp_limb_t *ep = mpz_limbs_read (pub->e);
-  int ret;
-
-  mp_size_t itch;
-
-  mp_limb_t *scratch;
-  TMP_GMP_DECL(tp, mp_limb_t);
-
-  itch = mpn_sec_powm_itch (nn, ebn, nn);
-  TMP_GMP_ALLOC (tp, nn + itch);
-  scratch = tp + nn;
-
-  mpn_sec_powm(tp, x, nn, ep, ebn, np, nn, scratch);
-  ret = sec_equal(tp, m, nn);
+  mp_limb_t *tp = scratch;
 
-  TMP_GMP_FREE (tp);
-  return ret;
+  BIGNUM_BACKEND->sec_powm (tp, x, nn, ep, ebn, np, nn,
+					 scratch + nn);
+  return sec_equal(tp, m, nn);
 }
 
 static void
@@ -290,21 +371,46 @@ cnd_mpn_zero (int cnd, volatile mp_ptr rp, mp_size_t n)
     }
 }
 
+mp_size_t
+_rsa_sec_compute_root_tr_itch (const struct rsa_public_key *pub,
+			       const struct rsa_private_key *key)
+{
+  mp_size_t nn = NETTLE_OCTET_SIZE_TO_LIMB_SIZE(key->size);
+  mp_size_t itch = _rsa_sec_compute_root_itch (key);
+  mp_size_t i2;
+
+  i2 = rsa_sec_blind_itch (pub);
+  itch = MAX (itch, i2);
+  i2 = rsa_sec_check_root_itch (pub);
+  itch = MAX (itch, i2);
+  i2 = rsa_sec_unblind_itch (pub);
+  itch = MAX (itch, i2);
+  i2 = _rsa_blinding_pool_update_itch (pub);
+  itch = MAX (itch, i2);
+
+  /* nn limbs each for c and ri. */
+  return 2 * nn + itch;
+}
+
 /* Checks for any errors done in the RSA computation. That avoids
  * attacks which rely on faults on hardware, or even software MPI
  * implementation.
  * This version is side-channel silent even in case of error,
- * the destination buffer is always overwritten */
-int
-_rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
-			 const struct rsa_private_key *key,
-			 void *random_ctx, nettle_random_func *random,
-			 mp_limb_t *x, const mp_limb_t *m, size_t mn)
+ * the destination buffer is always overwritten. If pool is non-NULL,
+ * not empty, and filled for this key, blinding uses precomputed
+ * factors from the pool. */
+static int
+sec_compute_root_tr(const struct rsa_public_key *pub,
+		    const struct rsa_private_key *key,
+		    struct rsa_blinding_pool *pool,
+		    void *random_ctx, nettle_random_func *random,
+		    mp_limb_t *x, const mp_limb_t *m, size_t mn,
+		    mp_limb_t *scratch)
 {
-  TMP_GMP_DECL (c, mp_limb_t);
-  TMP_GMP_DECL (ri, mp_limb_t);
-  TMP_GMP_DECL (scratch, mp_limb_t);
+  mp_limb_t *c;
+  mp_limb_t *ri;
   size_t key_limb_size;
+  int entry;
   int ret;
 
   key_limb_size = NETTLE_OCTET_SIZE_TO_LIMB_SIZE(key->size);
@@ -323,26 +429,54 @@ _rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
   assert(mpz_size(pub->n) == key_limb_size);
   assert(mn <= key_limb_size);
 
-  TMP_GMP_ALLOC (c, key_limb_size);
-  TMP_GMP_ALLOC (ri, key_limb_size);
-  TMP_GMP_ALLOC (scratch, _rsa_sec_compute_root_itch(key));
+  c = scratch;
+  ri = scratch + key_limb_size;
+  scratch = ri + key_limb_size;
 
-  rsa_sec_blind (pub, random_ctx, random, x, ri, m, mn);
+  entry = pool ? _rsa_blinding_pool_next (pool, pub) : -1;
+  if (entry >= 0)
+    rsa_sec_blind_pool (pub, pool, entry, x, ri, m, mn, scratch);
+  else
+    rsa_sec_blind (pub, random_ctx, random, x, ri, m, mn, scratch);
 
   _rsa_sec_compute_root(key, c, x, scratch);
 
-  ret = rsa_sec_check_root(pub, c, x);
+  ret = rsa_sec_check_root(pub, c, x, scratch);
 
-  rsa_sec_unblind(pub, x, ri, c);
+  rsa_sec_unblind(pub, x, ri, c, scratch);
 
   cnd_mpn_zero(1 - ret, x, key_limb_size);
 
-  TMP_GMP_FREE (scratch);
-  TMP_GMP_FREE (ri);
-  TMP_GMP_FREE (c);
+  /* Prepare the entry for its next use, r -> r^2. */
+  if (entry >= 0 && pool->uses[entry] > 0)
+    _rsa_blinding_pool_update (pool, pub, entry, scratch);
+
   return ret;
 }
 
+int
+_rsa_sec_compute_root_tr(const struct rsa_public_key *pub,
+			 const struct rsa_private_key *key,
+			 void *random_ctx, nettle_random_func *random,
+			 mp_limb_t *x, const mp_limb_t *m, size_t mn,
+			 mp_limb_t *scratch)
+{
+  return sec_compute_root_tr (pub, key, NULL, random_ctx, random,
+			      x, m, mn, scratch);
+}
+
+int
+_rsa_sec_compute_root_pool(const struct rsa_public_key *pub,
+			   const struct rsa_private_key *key,
+			   struct rsa_blinding_pool *pool,
+			   void *random_ctx, nettle_random_func *random,
+			   mp_limb_t *x, const mp_limb_t *m, size_t mn,
+			   mp_limb_t *scratch)
+{
+  return sec_compute_root_tr (pub, key, pool, random_ctx, random,
+			      x, m, mn, scratch);
+}
+
 /* Checks for any errors done in the RSA computation. That avoids
  * attacks which rely on faults on hardware, or even software MPI
  * implementation.
@@ -360,10 +494,11 @@ rsa_compute_root_tr(const struct rsa_public_key *pub,
   int res;
 
   mp_size_t l_size = NETTLE_OCTET_SIZE_TO_LIMB_SIZE(key->size);
-  TMP_GMP_ALLOC (l, l_size);
+  TMP_GMP_ALLOC (l, l_size + _rsa_sec_compute_root_tr_itch (pub, key));
 
   res = _rsa_sec_compute_root_tr (pub, key, random_ctx, random, l,
-				  mpz_limbs_read(m), mpz_size(m));
+				  mpz_limbs_read(m), mpz_size(m),
+				  l + l_size);
   if (res) {
     mp_limb_t *xp = mpz_limbs_write (x, l_size);
     mpn_copyi (xp, l, l_size);
@@ -373,4 +508,76 @@ rsa_compute_root_tr(const struct rsa_public_key *pub,
   TMP_GMP_FREE (l);
   return res;
 }
+
+int
+rsa_compute_root_pool(const struct rsa_public_key *pub,
+		      const struct rsa_private_key *key,
+		      struct rsa_blinding_pool *pool,
+		      void *random_ctx, nettle_random_func *random,
+		      mpz_t x, const mpz_t m)
+{
+  TMP_GMP_DECL (l, mp_limb_t);
+  int res;
+
+  mp_size_t l_size = NETTLE_OCTET_SIZE_TO_LIMB_SIZE(key->size);
+  TMP_GMP_ALLOC (l, l_size + _rsa_sec_compute_root_tr_itch (pub, key));
+
+  res = _rsa_sec_compute_root_pool (pub, key, pool, random_ctx, random,
+				    l, mpz_limbs_read(m), mpz_size(m),
+				    l + l_size);
+  if (res)
+    mpz_set_n (x, l, l_size);
+
+  TMP_GMP_FREE (l);
+  return res;
+}
 #endif
+
+mp_size_t
+rsa_sec_itch (const struct rsa_public_key *pub,
+	      const struct rsa_private_key *key)
+{
+  mp_size_t nn = NETTLE_OCTET_SIZE_TO_LIMB_SIZE(key->size);
+
+  /* nn limbs for the result, and nn limbs for the input to the root
+     computation. The encoded message, or the decrypted padded
+     message, is stored in one of these areas. */
+  return 2 * nn + _rsa_sec_compute_root_tr_itch (pub, key);
+}
+
+/* Signs an encoded message, of LENGTH octets, stored at the start of
+   the scratch area. */
+int
+_rsa_sec_sign_tr(const struct rsa_public_key *pub,
+		 const struct rsa_private_key *key,
+		 void *random_ctx, nettle_random_func *random,
+		 size_t length, mpz_t s, mp_limb_t *scratch)
+{
+  return _rsa_sec_sign_pool (pub, key, NULL, random_ctx, random,
+			     length, s, scratch);
+}
+
+int
+_rsa_sec_sign_pool(const struct rsa_public_key *pub,
+		   const struct rsa_private_key *key,
+		   struct rsa_blinding_pool *pool,
+		   void *random_ctx, nettle_random_func *random,
+		   size_t length, mpz_t s, mp_limb_t *scratch)
+{
+  mp_size_t nn = NETTLE_OCTET_SIZE_TO_LIMB_SIZE(key->size);
+  mp_limb_t *mp = scratch;
+  mp_limb_t *xp = scratch + nn;
+  int res;
+
+  assert (length <= key->size);
+
+  memset (mp, 0, nn * sizeof(mp_limb_t) - length);
+  mpn_set_base256_in_place (mp, nn);
+
+  res = _rsa_sec_compute_root_pool (pub, key, pool, random_ctx, random,
+				    xp, mp, nn, xp + nn);
+  if (res)
+    mpz_set_n (s, xp, nn);
+
+  return res;
+}
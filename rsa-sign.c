@@ -40,6 +40,7 @@
 #include "rsa.h"
 #include "rsa-internal.h"
 #include "gmp-glue.h"
+#include "hogweed-internal.h"
 
 void
 rsa_private_key_init(struct rsa_private_key *key)
@@ -106,11 +107,11 @@ rsa_compute_root(const struct rsa_private_key *key,
 
   /* Compute xq = m^d % q = (m%q)^b % q */
   mpz_fdiv_r(xq, m, key->q);
-  mpz_powm_sec(xq, xq, key->b, key->q);
+  _bignum_sec_powm(xq, xq, key->b, key->q);
 
   /* Compute xp = m^d % p = (m%p)^a % p */
   mpz_fdiv_r(xp, m, key->p);
-  mpz_powm_sec(xp, xp, key->a, key->p);
+  _bignum_sec_powm(xp, xp, key->a, key->p);
 
   /* Set xp' = (xp - xq) c % p. */
   mpz_sub(xp, xp, xq);
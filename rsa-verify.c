@@ -39,6 +39,8 @@
 #include "rsa-internal.h"
 
 #include "bignum.h"
+#include "gmp-glue.h"
+#include "pkcs1-internal.h"
 
 int
 _rsa_verify(const struct rsa_public_key *key,
@@ -77,3 +79,53 @@ _rsa_verify_recover(const struct rsa_public_key *key,
 
   return 1;
 }
+
+/* Computes m = s^e (mod n), and converts it in place, to key->size
+   octets, big-endian, stored in the limbs of m. Returns a pointer to
+   the octets, or NULL if s is out of range. Afterwards, m is no
+   longer a valid number, and may only be cleared. */
+uint8_t *
+_rsa_verify_recover_octets(const struct rsa_public_key *key,
+			   mpz_t m,
+			   const mpz_t s)
+{
+  mp_size_t nn = mpz_size (key->n);
+  mp_size_t mn;
+  mp_limb_t *mp;
+
+  if (!_rsa_verify_recover (key, m, s))
+    return NULL;
+
+  mn = mpz_size (m);
+  mp = mpz_limbs_modify (m, nn);
+  mpn_zero (mp + mn, nn - mn);
+  mpn_get_base256_in_place (mp, nn);
+
+  return (uint8_t *) (mp + nn) - key->size;
+}
+
+int
+_rsa_pss_verify_digest(const struct rsa_public_key *key,
+		       const struct nettle_hash *hash,
+		       size_t salt_length,
+		       const uint8_t *digest,
+		       const mpz_t signature)
+{
+  size_t bits = mpz_sizeinbase(key->n, 2) - 1;
+  size_t em_size = (bits + 7) / 8;
+  uint8_t *em;
+  int res;
+  mpz_t m;
+
+  mpz_init (m);
+
+  /* The encoding is one octet shorter than n, if the size of n is
+     1 mod 8, and then the first octet must be zero. */
+  em = _rsa_verify_recover_octets (key, m, signature);
+  res = (em && (em_size == key->size || em[0] == 0)
+	 && _pss_verify_mgf1 (em + key->size - em_size, bits, hash,
+			      salt_length, digest));
+
+  mpz_clear (m);
+  return res;
+}
@@ -91,13 +91,36 @@ extern "C" {
 #define rsa_sec_decrypt nettle_rsa_sec_decrypt
 #define rsa_compute_root nettle_rsa_compute_root
 #define rsa_compute_root_tr nettle_rsa_compute_root_tr
+#define rsa_blinding_pool_init nettle_rsa_blinding_pool_init
+#define rsa_blinding_pool_clear nettle_rsa_blinding_pool_clear
+#define rsa_blinding_pool_refill nettle_rsa_blinding_pool_refill
+#define rsa_blinding_pool_uses nettle_rsa_blinding_pool_uses
+#define rsa_compute_root_pool nettle_rsa_compute_root_pool
+#define rsa_pkcs1_sign_pool nettle_rsa_pkcs1_sign_pool
+#define rsa_pkcs1_sign_pool_scratch nettle_rsa_pkcs1_sign_pool_scratch
+#define rsa_sec_itch nettle_rsa_sec_itch
+#define rsa_pkcs1_sign_tr_scratch nettle_rsa_pkcs1_sign_tr_scratch
+#define rsa_md5_sign_digest_tr_scratch nettle_rsa_md5_sign_digest_tr_scratch
+#define rsa_sha1_sign_digest_tr_scratch nettle_rsa_sha1_sign_digest_tr_scratch
+#define rsa_sha256_sign_digest_tr_scratch nettle_rsa_sha256_sign_digest_tr_scratch
+#define rsa_sha512_sign_digest_tr_scratch nettle_rsa_sha512_sign_digest_tr_scratch
+#define rsa_pss_sha256_sign_digest_tr_scratch nettle_rsa_pss_sha256_sign_digest_tr_scratch
+#define rsa_pss_sha384_sign_digest_tr_scratch nettle_rsa_pss_sha384_sign_digest_tr_scratch
+#define rsa_pss_sha512_sign_digest_tr_scratch nettle_rsa_pss_sha512_sign_digest_tr_scratch
+#define rsa_decrypt_tr_scratch nettle_rsa_decrypt_tr_scratch
+#define rsa_sec_decrypt_scratch nettle_rsa_sec_decrypt_scratch
 #define rsa_generate_keypair nettle_rsa_generate_keypair
+#define rsa_generate_keypair_sieve nettle_rsa_generate_keypair_sieve
+#define rsa_generate_prime nettle_rsa_generate_prime
+#define rsa_keypair_from_primes nettle_rsa_keypair_from_primes
 #define rsa_keypair_to_sexp nettle_rsa_keypair_to_sexp
 #define rsa_keypair_from_sexp_alist nettle_rsa_keypair_from_sexp_alist
 #define rsa_keypair_from_sexp nettle_rsa_keypair_from_sexp
 #define rsa_public_key_from_der_iterator nettle_rsa_public_key_from_der_iterator
 #define rsa_private_key_from_der_iterator nettle_rsa_private_key_from_der_iterator
 #define rsa_keypair_from_der nettle_rsa_keypair_from_der
+#define rsa_public_key_from_der_limbs nettle_rsa_public_key_from_der_limbs
+#define rsa_public_keys_from_der nettle_rsa_public_keys_from_der
 #define rsa_keypair_to_openpgp nettle_rsa_keypair_to_openpgp
 
 /* This limit is somewhat arbitrary. Technically, the smallest modulo
@@ -145,6 +168,27 @@ struct rsa_private_key
   mpz_t c;
 };
 
+/* Number of entries in a blinding pool, and the number of signatures
+   each entry is used for, squaring it in between, before it must be
+   refilled. */
+#define RSA_BLINDING_POOL_SIZE 4
+#define RSA_BLINDING_MAX_USES 32
+
+/* Precomputed blinding factors, for use with a single key. Not safe
+   for concurrent use. */
+struct rsa_blinding_pool
+{
+  /* The modulus of the key the entries were computed for, zero
+     before the first refill. */
+  mpz_t n;
+  /* Remaining uses of each entry, zero for an empty entry. */
+  unsigned uses[RSA_BLINDING_POOL_SIZE];
+  /* r^e (mod n) */
+  mpz_t blind[RSA_BLINDING_POOL_SIZE];
+  /* r^{-1} (mod n) */
+  mpz_t unblind[RSA_BLINDING_POOL_SIZE];
+};
+
 /* Signing a message works as follows:
  *
  * Store the private key in a rsa_private_key struct.
@@ -441,6 +485,139 @@ rsa_compute_root_tr(const struct rsa_public_key *pub,
 		    void *random_ctx, nettle_random_func *random,
 		    mpz_t x, const mpz_t m);
 
+/* Blinding pool. Refilling an empty entry costs an exponentiation and
+ * an inversion, and should be done off the latency critical path.
+ * Each use of an entry costs only two modular squarings. */
+void
+rsa_blinding_pool_init(struct rsa_blinding_pool *pool);
+
+void
+rsa_blinding_pool_clear(struct rsa_blinding_pool *pool);
+
+/* Fills the empty entries. If the pool was last filled for a
+ * different key, all entries are discarded first. */
+void
+rsa_blinding_pool_refill(struct rsa_blinding_pool *pool,
+			 const struct rsa_public_key *pub,
+			 void *random_ctx, nettle_random_func *random);
+
+/* Number of signatures the pool can blind before it's empty. */
+unsigned
+rsa_blinding_pool_uses(const struct rsa_blinding_pool *pool);
+
+/* Like rsa_compute_root_tr, but takes the blinding factor from the
+ * pool. If the pool is empty, or was filled for a different key, a
+ * fresh factor is generated using the randomness generator. */
+int
+rsa_compute_root_pool(const struct rsa_public_key *pub,
+		      const struct rsa_private_key *key,
+		      struct rsa_blinding_pool *pool,
+		      void *random_ctx, nettle_random_func *random,
+		      mpz_t x, const mpz_t m);
+
+int
+rsa_pkcs1_sign_pool(const struct rsa_public_key *pub,
+		    const struct rsa_private_key *key,
+		    struct rsa_blinding_pool *pool,
+		    void *random_ctx, nettle_random_func *random,
+		    size_t length, const uint8_t *digest_info,
+		    mpz_t s);
+
+/* Scratch space as for rsa_pkcs1_sign_tr_scratch. */
+int
+rsa_pkcs1_sign_pool_scratch(const struct rsa_public_key *pub,
+			    const struct rsa_private_key *key,
+			    struct rsa_blinding_pool *pool,
+			    void *random_ctx, nettle_random_func *random,
+			    size_t length, const uint8_t *digest_info,
+			    mpz_t s, mp_limb_t *scratch);
+
+/* Variants of the side-channel silent signing and decryption
+ * functions which use caller supplied scratch space, of at least
+ * rsa_sec_itch(pub, key) limbs. If also the signature has room for
+ * key->size octets (e.g., it's reused, or initialized with mpz_init2),
+ * these functions do no memory allocation at all. Except when using
+ * mini-gmp, where the root computation still allocates temporaries. */
+mp_size_t
+rsa_sec_itch(const struct rsa_public_key *pub,
+	     const struct rsa_private_key *key);
+
+int
+rsa_pkcs1_sign_tr_scratch(const struct rsa_public_key *pub,
+			  const struct rsa_private_key *key,
+			  void *random_ctx, nettle_random_func *random,
+			  size_t length, const uint8_t *digest_info,
+			  mpz_t s, mp_limb_t *scratch);
+
+int
+rsa_md5_sign_digest_tr_scratch(const struct rsa_public_key *pub,
+			       const struct rsa_private_key *key,
+			       void *random_ctx, nettle_random_func *random,
+			       const uint8_t *digest,
+			       mpz_t s, mp_limb_t *scratch);
+
+int
+rsa_sha1_sign_digest_tr_scratch(const struct rsa_public_key *pub,
+				const struct rsa_private_key *key,
+				void *random_ctx, nettle_random_func *random,
+				const uint8_t *digest,
+				mpz_t s, mp_limb_t *scratch);
+
+int
+rsa_sha256_sign_digest_tr_scratch(const struct rsa_public_key *pub,
+				  const struct rsa_private_key *key,
+				  void *random_ctx, nettle_random_func *random,
+				  const uint8_t *digest,
+				  mpz_t s, mp_limb_t *scratch);
+
+int
+rsa_sha512_sign_digest_tr_scratch(const struct rsa_public_key *pub,
+				  const struct rsa_private_key *key,
+				  void *random_ctx, nettle_random_func *random,
+				  const uint8_t *digest,
+				  mpz_t s, mp_limb_t *scratch);
+
+int
+rsa_pss_sha256_sign_digest_tr_scratch(const struct rsa_public_key *pub,
+				      const struct rsa_private_key *key,
+				      void *random_ctx,
+				      nettle_random_func *random,
+				      size_t salt_length, const uint8_t *salt,
+				      const uint8_t *digest,
+				      mpz_t s, mp_limb_t *scratch);
+
+int
+rsa_pss_sha384_sign_digest_tr_scratch(const struct rsa_public_key *pub,
+				      const struct rsa_private_key *key,
+				      void *random_ctx,
+				      nettle_random_func *random,
+				      size_t salt_length, const uint8_t *salt,
+				      const uint8_t *digest,
+				      mpz_t s, mp_limb_t *scratch);
+
+int
+rsa_pss_sha512_sign_digest_tr_scratch(const struct rsa_public_key *pub,
+				      const struct rsa_private_key *key,
+				      void *random_ctx,
+				      nettle_random_func *random,
+				      size_t salt_length, const uint8_t *salt,
+				      const uint8_t *digest,
+				      mpz_t s, mp_limb_t *scratch);
+
+int
+rsa_decrypt_tr_scratch(const struct rsa_public_key *pub,
+		       const struct rsa_private_key *key,
+		       void *random_ctx, nettle_random_func *random,
+		       size_t *length, uint8_t *message,
+		       const mpz_t gibberish, mp_limb_t *scratch);
+
+int
+rsa_sec_decrypt_scratch(const struct rsa_public_key *pub,
+			const struct rsa_private_key *key,
+			void *random_ctx, nettle_random_func *random,
+			size_t length, uint8_t *message,
+			const mpz_t gibberish, mp_limb_t *scratch);
+
 /* Key generation */
 
 /* Note that the key structs must be initialized first. */
@@ -458,6 +635,40 @@ rsa_generate_keypair(struct rsa_public_key *pub,
 		      * zero, the passed in value pub->e is used. */
 		     unsigned e_size);
 
+/* Like rsa_generate_keypair, but prime candidates are found by
+   incremental sieving with a table of small primes, which is
+   considerably faster. Produces different keys than
+   rsa_generate_keypair for the same randomness. */
+int
+rsa_generate_keypair_sieve(struct rsa_public_key *pub,
+			   struct rsa_private_key *key,
+			   void *random_ctx, nettle_random_func *random,
+			   void *progress_ctx, nettle_progress_func *progress,
+			   unsigned n_size,
+			   unsigned e_size);
+
+/* Generates a single RSA prime of the given size (which must be
+   larger than 20 bits), with the two most significant bits set. If e
+   is non-NULL, p-1 is coprime to e. Calls with independent randomness
+   contexts can run concurrently, e.g., generating p and q in separate
+   threads, followed by rsa_keypair_from_primes. */
+void
+rsa_generate_prime(mpz_t p, unsigned bits, const mpz_t e,
+		   void *random_ctx, nettle_random_func *random,
+		   void *progress_ctx, nettle_progress_func *progress);
+
+/* Completes a key pair from the primes key->p and key->q, computing
+   n, d, a, b and c. The arguments are as for rsa_generate_keypair;
+   randomness is used only when e_size is non-zero. Returns zero if n
+   is not of size n_size, if p = q, or if a given e is not invertible. */
+int
+rsa_keypair_from_primes(struct rsa_public_key *pub,
+			struct rsa_private_key *key,
+			void *random_ctx, nettle_random_func *random,
+			void *progress_ctx, nettle_progress_func *progress,
+			unsigned n_size,
+			unsigned e_size);
+
 
 #define RSA_SIGN(key, algorithm, ctx, length, data, signature) ( \
   algorithm##_update(ctx, length, data), \
@@ -521,6 +732,37 @@ rsa_keypair_from_der(struct rsa_public_key *pub,
 		     unsigned limit, 
 		     size_t length, const uint8_t *data);
 
+/* Loading of public keys without memory allocation. The key's
+ * integers are stored in the LIMBS array, and PUB->n and PUB->e are
+ * set up as read-only references to it, using mpz_roinit_n. PUB must
+ * not be initialized or cleared with rsa_public_key_init or
+ * rsa_public_key_clear, and it can only be used as long as the limbs
+ * are valid. Returns the number of limbs used, or 0 on failure,
+ * including if LIMBS_SIZE is too small. For an RSAPublicKey with
+ * LENGTH octets of contents, RSA_PUBLIC_KEY_DER_LIMBS(LENGTH) limbs
+ * are always enough. */
+#define RSA_PUBLIC_KEY_DER_LIMBS(length) \
+  ((length) / sizeof(mp_limb_t) + 2)
+
+mp_size_t
+rsa_public_key_from_der_limbs(struct rsa_public_key *pub,
+			      unsigned limit,
+			      mp_size_t limbs_size, mp_limb_t *limbs,
+			      struct asn1_der_iterator *i);
+
+/* Loads a bundle of concatenated RSAPublicKey objects, using
+ * rsa_public_key_from_der_limbs with consecutive parts of LIMBS. On
+ * input, *NKEYS, *LIMBS_SIZE and *LENGTH are the space in KEYS, the
+ * space in LIMBS, and the input length. On return, they are the
+ * number of keys loaded, limbs used and input octets consumed.
+ * Returns 1 on success, and 0 if the next object is invalid. Loading
+ * stops early, with success, when KEYS or LIMBS is full. */
+int
+rsa_public_keys_from_der(size_t *nkeys, struct rsa_public_key *keys,
+			 mp_size_t *limbs_size, mp_limb_t *limbs,
+			 unsigned limit,
+			 size_t *length, const uint8_t *data);
+
 /* OpenPGP format. Experimental interface, subject to change. */
 int
 rsa_keypair_to_openpgp(struct nettle_buffer *buffer,
@@ -0,0 +1,350 @@
+/* sexp-index.c
+
+   Index for random access to canonical s-expressions.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "sexp.h"
+#include "sexp-internal.h"
+
+#define NO_NODE ((size_t) -1)
+
+void
+sexp_index_init(struct sexp_index *index,
+		void *realloc_ctx, nettle_realloc_func *realloc)
+{
+  index->length = 0;
+  index->buffer = NULL;
+  index->nnodes = index->nodes_alloc = 0;
+  index->nodes = NULL;
+  index->nkeys = index->keys_alloc = 0;
+  index->keys = NULL;
+  index->realloc_ctx = realloc_ctx;
+  index->realloc = realloc;
+}
+
+void
+sexp_index_clear(struct sexp_index *index)
+{
+  if (index->nodes)
+    index->realloc(index->realloc_ctx, index->nodes, 0);
+  if (index->keys)
+    index->realloc(index->realloc_ctx, index->keys, 0);
+
+  sexp_index_init(index, index->realloc_ctx, index->realloc);
+}
+
+static int
+sexp_index_add_node(struct sexp_index *index,
+		    size_t start, size_t end, size_t parent)
+{
+  struct sexp_index_node *node;
+
+  if (index->nnodes == index->nodes_alloc)
+    {
+      size_t alloc = index->nodes_alloc * 2 + 100;
+      void *p = index->realloc(index->realloc_ctx, index->nodes,
+			       alloc * sizeof(*index->nodes));
+      if (!p)
+	return 0;
+      index->nodes = p;
+      index->nodes_alloc = alloc;
+    }
+  node = &index->nodes[index->nnodes++];
+  node->start = start;
+  node->end = end;
+  node->parent = parent;
+  return 1;
+}
+
+static int
+sexp_index_add_key(struct sexp_index *index, size_t list,
+		   size_t key_length, const uint8_t *key)
+{
+  struct sexp_index_key *entry;
+
+  if (index->nkeys == index->keys_alloc)
+    {
+      size_t alloc = index->keys_alloc * 2 + 100;
+      void *p = index->realloc(index->realloc_ctx, index->keys,
+			       alloc * sizeof(*index->keys));
+      if (!p)
+	return 0;
+      index->keys = p;
+      index->keys_alloc = alloc;
+    }
+  entry = &index->keys[index->nkeys++];
+  entry->parent = index->nodes[list].parent;
+  entry->list = list;
+  entry->key_length = key_length;
+  entry->key = key;
+  return 1;
+}
+
+/* Orders the key table on the enclosing list, then the key, and
+   last the position. */
+static int
+sexp_index_compare_key(size_t parent, size_t key_length, const uint8_t *key,
+		       const struct sexp_index_key *entry)
+{
+  if (parent != entry->parent)
+    return parent < entry->parent ? -1 : 1;
+  if (key_length != entry->key_length)
+    return key_length < entry->key_length ? -1 : 1;
+  return memcmp(key, entry->key, key_length);
+}
+
+static int
+sexp_index_sort_cmp(const void *ap, const void *bp)
+{
+  const struct sexp_index_key *a = ap;
+  const struct sexp_index_key *b = bp;
+  int res = sexp_index_compare_key(a->parent, a->key_length, a->key, b);
+  if (res)
+    return res;
+  return a->list < b->list ? -1 : a->list > b->list;
+}
+
+int
+sexp_index_build(struct sexp_index *index,
+		 size_t length, const uint8_t *input)
+{
+  struct sexp_iterator iterator;
+  /* Innermost list not yet closed. */
+  size_t open = NO_NODE;
+
+  index->length = length;
+  index->buffer = input;
+  index->nnodes = index->nkeys = 0;
+
+  /* The ordinary iterator does all the parsing. It never has to
+     skip anything, so each character is looked at once. */
+  if (!sexp_iterator_first(&iterator, length, input))
+    return 0;
+
+  for (;;)
+    switch (iterator.type)
+      {
+      case SEXP_ATOM:
+	if (!sexp_index_add_node(index, iterator.start, iterator.pos, open)
+	    || !sexp_iterator_next(&iterator))
+	  return 0;
+	break;
+
+      case SEXP_LIST:
+	if (!sexp_index_add_node(index, iterator.start, 0, open)
+	    || !sexp_iterator_enter_list(&iterator))
+	  return 0;
+	open = index->nnodes - 1;
+
+	if (iterator.type == SEXP_ATOM && !iterator.display
+	    && !sexp_index_add_key(index, open,
+				   iterator.atom_length, iterator.atom))
+	  return 0;
+	break;
+
+      case SEXP_END:
+	if (!iterator.level)
+	  goto done;
+
+	/* The closing parenthesis is already consumed. */
+	index->nodes[open].end = iterator.pos;
+	open = index->nodes[open].parent;
+	if (!sexp_iterator_exit_list(&iterator))
+	  return 0;
+	break;
+
+      default:
+	abort();
+      }
+ done:
+  if (index->nkeys > 1)
+    qsort(index->keys, index->nkeys, sizeof(*index->keys),
+	  sexp_index_sort_cmp);
+  return 1;
+}
+
+/* Finds the node starting at the given offset. Nodes are numbered in
+   the order they occur, so their start offsets are increasing. */
+static size_t
+sexp_index_find(const struct sexp_index *index,
+		const struct sexp_iterator *iterator)
+{
+  size_t lo, hi;
+
+  if (iterator->buffer != index->buffer)
+    return NO_NODE;
+
+  for (lo = 0, hi = index->nnodes; lo < hi; )
+    {
+      size_t mid = lo + (hi - lo) / 2;
+      if (index->nodes[mid].start < iterator->start)
+	lo = mid + 1;
+      else if (index->nodes[mid].start > iterator->start)
+	hi = mid;
+      else
+	return mid;
+    }
+  return NO_NODE;
+}
+
+int
+sexp_index_next(const struct sexp_index *index,
+		struct sexp_iterator *iterator)
+{
+  size_t node;
+
+  if (iterator->type != SEXP_LIST)
+    return sexp_iterator_next(iterator);
+
+  node = sexp_index_find(index, iterator);
+  if (node == NO_NODE)
+    return 0;
+
+  iterator->pos = index->nodes[node].end;
+  return _sexp_iterator_parse(iterator);
+}
+
+int
+sexp_index_exit_list(const struct sexp_index *index,
+		     struct sexp_iterator *iterator)
+{
+  size_t node;
+
+  if (!iterator->level)
+    return 0;
+
+  /* Already at the closing parenthesis. */
+  if (iterator->type == SEXP_END)
+    return sexp_iterator_exit_list(iterator);
+
+  node = sexp_index_find(index, iterator);
+  if (node == NO_NODE)
+    return 0;
+
+  iterator->pos = index->nodes[index->nodes[node].parent].end;
+  iterator->level--;
+  return _sexp_iterator_parse(iterator);
+}
+
+const uint8_t *
+sexp_index_subexpr(const struct sexp_index *index,
+		   struct sexp_iterator *iterator,
+		   size_t *length)
+{
+  size_t start = iterator->start;
+  if (!sexp_index_next(index, iterator))
+    return 0;
+
+  *length = iterator->start - start;
+  return iterator->buffer + start;
+}
+
+int
+sexp_index_assoc(const struct sexp_index *index,
+		 struct sexp_iterator *iterator,
+		 unsigned nkeys,
+		 const char * const *keys,
+		 struct sexp_iterator *values)
+{
+  size_t parent;
+  size_t node;
+  unsigned i;
+
+  if (!iterator->level)
+    return 0;
+
+  if (iterator->type == SEXP_END)
+    return sexp_iterator_assoc(iterator, nkeys, keys, values);
+
+  node = sexp_index_find(index, iterator);
+  if (node == NO_NODE)
+    return 0;
+
+  parent = index->nodes[node].parent;
+
+  for (i = 0; i < nkeys; i++)
+    {
+      size_t key_length = strlen(keys[i]);
+      const uint8_t *key = (const uint8_t *) keys[i];
+      size_t found = NO_NODE;
+      size_t lo, hi;
+      unsigned j;
+
+      /* Like sexp_iterator_assoc, a key listed twice can never be
+	 found for both. */
+      for (j = 0; j < i; j++)
+	if (!strcmp(keys[i], keys[j]))
+	  return 0;
+
+      /* Find the first entry for this key in the enclosing list. */
+      for (lo = 0, hi = index->nkeys; lo < hi; )
+	{
+	  size_t mid = lo + (hi - lo) / 2;
+	  if (sexp_index_compare_key(parent, key_length, key,
+				     &index->keys[mid]) > 0)
+	    lo = mid + 1;
+	  else
+	    hi = mid;
+	}
+
+      for (; lo < index->nkeys
+	     && !sexp_index_compare_key(parent, key_length, key,
+					&index->keys[lo]); lo++)
+	{
+	  size_t list = index->keys[lo].list;
+	  if (index->nodes[list].start < iterator->start)
+	    continue;
+	  if (found != NO_NODE)
+	    /* We don't allow duplicates */
+	    return 0;
+	  found = list;
+	}
+      if (found == NO_NODE)
+	return 0;
+
+      /* Point at the element following the key atom. */
+      values[i] = *iterator;
+      values[i].level++;
+      values[i].pos = index->nodes[found + 1].end;
+      if (!_sexp_iterator_parse(&values[i]))
+	return 0;
+    }
+
+  iterator->pos = index->nodes[parent].end;
+  iterator->level--;
+  return _sexp_iterator_parse(iterator);
+}
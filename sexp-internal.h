@@ -0,0 +1,45 @@
+/* sexp-internal.h
+
+   Internal s-expression parsing functions.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_SEXP_INTERNAL_H_INCLUDED
+#define NETTLE_SEXP_INTERNAL_H_INCLUDED
+
+#include "sexp.h"
+
+#define _sexp_iterator_parse _nettle_sexp_iterator_parse
+
+/* Parses the expression at iterator->pos, setting iterator->type. */
+int
+_sexp_iterator_parse(struct sexp_iterator *iterator);
+
+#endif /* NETTLE_SEXP_INTERNAL_H_INCLUDED */
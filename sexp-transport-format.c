@@ -96,3 +96,46 @@ sexp_transport_format(struct nettle_buffer *buffer,
   
   return done;
 }
+
+void
+sexp_transport_encode_init(struct sexp_transport_encode_ctx *ctx)
+{
+  base64_encode_init(&ctx->base64);
+  ctx->started = 0;
+}
+
+size_t
+sexp_transport_encode_update(struct sexp_transport_encode_ctx *ctx,
+			     uint8_t *dst,
+			     size_t length,
+			     const uint8_t *src)
+{
+  size_t done = 0;
+
+  if (!ctx->started)
+    {
+      dst[done++] = '{';
+      ctx->started = 1;
+    }
+
+  return done + base64_encode_update(&ctx->base64, (char *) (dst + done),
+				     length, src);
+}
+
+size_t
+sexp_transport_encode_final(struct sexp_transport_encode_ctx *ctx,
+			    uint8_t *dst)
+{
+  size_t done = 0;
+
+  if (!ctx->started)
+    {
+      dst[done++] = '{';
+      ctx->started = 1;
+    }
+
+  done += base64_encode_final(&ctx->base64, (char *) (dst + done));
+  dst[done++] = '}';
+
+  return done;
+}
@@ -35,101 +35,145 @@
 # include "config.h"
 #endif
 
-#include <assert.h>
+#include <stdlib.h>
 #include <string.h>
 
 #include "sexp.h"
 
 #include "base64.h"
 
-/* NOTE: Decodes the input string in place */
-int
-sexp_transport_iterator_first(struct sexp_iterator *iterator,
-			      size_t length, uint8_t *input)
+enum sexp_transport_state
+  {
+    /* White space and comments, outside of any {...} group. */
+    SEXP_TRANSPORT_SPACE,
+    SEXP_TRANSPORT_COMMENT,
+    SEXP_TRANSPORT_BASE64,
+    /* Rest of input is in canonical encoding. */
+    SEXP_TRANSPORT_CANONICAL
+  };
+
+void
+sexp_transport_decode_init(struct sexp_transport_decode_ctx *ctx)
 {
-  /* We first base64 decode any transport encoded sexp at the start of
-   * the input. */
+  ctx->state = SEXP_TRANSPORT_SPACE;
+}
 
+int
+sexp_transport_decode_update(struct sexp_transport_decode_ctx *ctx,
+			     size_t *dst_length,
+			     uint8_t *dst,
+			     size_t src_length,
+			     const uint8_t *src)
+{
   size_t in = 0;
   size_t out = 0;
 
-  while (in < length)
-    switch(input[in])
+  /* Output never gets ahead of input, so that decoding in place
+   * works. */
+  while (in < src_length)
+    switch (ctx->state)
       {
-      case ' ':  /* SPC, TAB, LF, CR */
-      case '\t':
-      case '\n':
-      case '\r':
-	in++;
+      case SEXP_TRANSPORT_SPACE:
+	switch (src[in])
+	  {
+	  case ' ':  /* SPC, TAB, LF, CR */
+	  case '\t':
+	  case '\n':
+	  case '\r':
+	    in++;
+	    break;
+
+	  case ';':  /* Comments */
+	    in++;
+	    ctx->state = SEXP_TRANSPORT_COMMENT;
+	    break;
+
+	  case '{':
+	    /* Found transport encoding */
+	    in++;
+	    base64_decode_init(&ctx->base64);
+	    ctx->state = SEXP_TRANSPORT_BASE64;
+	    break;
+
+	  default:
+	    /* Expression isn't in transport encoding. Rest of the
+	     * input should be in canonical encoding. */
+	    ctx->state = SEXP_TRANSPORT_CANONICAL;
+	    break;
+	  }
 	break;
-	  
-      case ';':  /* Comments */
-	while (++in < length && input[in] != '\n')
-	  ;
-	break;
-	  
-      case '{':
+
+      case SEXP_TRANSPORT_COMMENT:
 	{
-	  /* Found transport encoding */
-	  struct base64_decode_ctx ctx;
-	  size_t coded_length;
-	  size_t end;
+	  const uint8_t *p = memchr(src + in, '\n', src_length - in);
+	  if (p)
+	    {
+	      in = p - src;
+	      ctx->state = SEXP_TRANSPORT_SPACE;
+	    }
+	  else
+	    in = src_length;
+	  break;
+	}
 
-	  for (end = ++in; end < length && input[end] != '}'; end++)
-	    ;
+      case SEXP_TRANSPORT_BASE64:
+	{
+	  /* Decode everything up to the closing brace in one call. */
+	  const uint8_t *p = memchr(src + in, '}', src_length - in);
+	  size_t end = p ? (size_t) (p - src) : src_length;
+	  size_t done;
 
-	  if (end == length)
+	  if (!base64_decode_update(&ctx->base64, &done, dst + out,
+				    end - in, (const char *) (src + in)))
 	    return 0;
-	    
-	  base64_decode_init(&ctx);
-	  
-	  if (base64_decode_update(&ctx, &coded_length, input + out,
-				   end - in, (const char*) (input + in))
-	      && base64_decode_final(&ctx))
-	    {	  
-	      out += coded_length;
-	      in = end + 1;
+
+	  out += done;
+	  in = end;
+
+	  if (p)
+	    {
+	      if (!base64_decode_final(&ctx->base64))
+		return 0;
+	      in++;
+	      ctx->state = SEXP_TRANSPORT_SPACE;
 	    }
-	  else
-	    return 0;
-	  
 	  break;
 	}
+
+      case SEXP_TRANSPORT_CANONICAL:
+	if (dst + out != src + in)
+	  memmove(dst + out, src + in, src_length - in);
+	out += src_length - in;
+	in = src_length;
+	break;
+
       default:
-	/* Expression isn't in transport encoding. Rest of the input
-	 * should be in canonical encoding. */
-	goto transport_done;
+	abort();
       }
-  
- transport_done:
-
-  /* Here, we have two, possibly empty, input parts in canonical
-   * encoding:
-   *
-   * 0...out-1,  in...length -1
-   *
-   * If the input was already in canonical encoding, out = 0 and in =
-   * amount of leading space.
-   *
-   * If all input was in transport encoding, in == length.
-   */
-  if (!out)
-    {
-      input += in;
-      length -= in;
-    }
-  else if (in == length)
-    length = out;
-  else if (out == in)
-    /* Unusual case, nothing happens */
-    ;
-  else
-    {
-      /* Both parts non-empty */
-      assert(out < in);
-      memmove(input + out, input + in, length - in);
-      length -= (in - out);
-    }
+
+  *dst_length = out;
+  return 1;
+}
+
+int
+sexp_transport_decode_final(struct sexp_transport_decode_ctx *ctx)
+{
+  return ctx->state != SEXP_TRANSPORT_BASE64;
+}
+
+/* NOTE: Decodes the input string in place */
+int
+sexp_transport_iterator_first(struct sexp_iterator *iterator,
+			      size_t length, uint8_t *input)
+{
+  struct sexp_transport_decode_ctx ctx;
+
+  /* Any canonical data following the transport encoded part is
+   * moved down, to follow the decoded data. */
+  sexp_transport_decode_init(&ctx);
+  if (!sexp_transport_decode_update(&ctx, &length, input, length, input)
+      || !sexp_transport_decode_final(&ctx))
+    return 0;
 
   return sexp_iterator_first(iterator, length, input);
 }
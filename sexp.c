@@ -39,6 +39,7 @@
 #include <string.h>
 
 #include "sexp.h"
+#include "sexp-internal.h"
 
 #include "macros.h"
 #include "nettle-internal.h"
@@ -108,8 +109,8 @@ sexp_iterator_simple(struct sexp_iterator *iterator,
 /* Look at the current position in the data. Sets iterator->type, and
  * ignores the old value. */
 
-static int
-sexp_iterator_parse(struct sexp_iterator *iterator)
+int
+_sexp_iterator_parse(struct sexp_iterator *iterator)
 {
   iterator->start = iterator->pos;
   
@@ -167,7 +168,7 @@ sexp_iterator_first(struct sexp_iterator *iterator,
 		    size_t length, const uint8_t *input)
 {
   sexp_iterator_init(iterator, length, input);
-  return sexp_iterator_parse(iterator);
+  return _sexp_iterator_parse(iterator);
 }
 
 int
@@ -184,7 +185,7 @@ sexp_iterator_next(struct sexp_iterator *iterator)
     case SEXP_ATOM:
       /* iterator->pos should already point at the start of the next
        * element. */
-      return sexp_iterator_parse(iterator);
+      return _sexp_iterator_parse(iterator);
     }
   /* If we get here, we have a bug. */
   abort();
@@ -203,7 +204,7 @@ sexp_iterator_enter_list(struct sexp_iterator *iterator)
 
   iterator->level++;
 
-  return sexp_iterator_parse(iterator);
+  return _sexp_iterator_parse(iterator);
 }
 
 /* Skips the rest of the current list */
@@ -219,7 +220,7 @@ sexp_iterator_exit_list(struct sexp_iterator *iterator)
       
   iterator->level--;
 
-  return sexp_iterator_parse(iterator);
+  return _sexp_iterator_parse(iterator);
 }
 
 #if 0
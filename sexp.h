@@ -35,6 +35,7 @@
 
 #include <stdarg.h>
 #include "nettle-types.h"
+#include "base64.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -43,6 +44,12 @@ extern "C" {
 /* Name mangling */
 #define sexp_iterator_first nettle_sexp_iterator_first
 #define sexp_transport_iterator_first nettle_sexp_transport_iterator_first
+#define sexp_transport_decode_init nettle_sexp_transport_decode_init
+#define sexp_transport_decode_update nettle_sexp_transport_decode_update
+#define sexp_transport_decode_final nettle_sexp_transport_decode_final
+#define sexp_transport_encode_init nettle_sexp_transport_encode_init
+#define sexp_transport_encode_update nettle_sexp_transport_encode_update
+#define sexp_transport_encode_final nettle_sexp_transport_encode_final
 #define sexp_iterator_next nettle_sexp_iterator_next
 #define sexp_iterator_enter_list nettle_sexp_iterator_enter_list
 #define sexp_iterator_exit_list nettle_sexp_iterator_exit_list
@@ -56,6 +63,13 @@ extern "C" {
 #define sexp_transport_format nettle_sexp_transport_format
 #define sexp_transport_vformat nettle_sexp_transport_vformat
 #define sexp_token_chars nettle_sexp_token_chars
+#define sexp_index_init nettle_sexp_index_init
+#define sexp_index_clear nettle_sexp_index_clear
+#define sexp_index_build nettle_sexp_index_build
+#define sexp_index_next nettle_sexp_index_next
+#define sexp_index_exit_list nettle_sexp_index_exit_list
+#define sexp_index_subexpr nettle_sexp_index_subexpr
+#define sexp_index_assoc nettle_sexp_index_assoc
 
 enum sexp_type
   { SEXP_ATOM, SEXP_LIST, SEXP_END };
@@ -152,6 +166,92 @@ sexp_iterator_assoc(struct sexp_iterator *iterator,
 		    const char * const *keys,
 		    struct sexp_iterator *values);
 
+
+/* Index over a canonical s-expression, built in one pass, for random
+ * access to large documents. Each list and atom gets a node,
+ * recording where it starts and ends, and its enclosing list. Lists
+ * starting with a plain atom, (key rest...), are also entered into a
+ * table sorted on the enclosing list and the key.
+ *
+ * The sexp_index_* functions below take an ordinary iterator over
+ * the same buffer, and leave it in the same state as the
+ * corresponding sexp_iterator_* function, so the two can be mixed
+ * freely. Skipping or leaving a list takes O(log n) time, and
+ * sexp_index_assoc takes O(log n) time per key, independent of the
+ * size of the skipped subexpressions. */
+
+struct sexp_index_node
+{
+  /* Offsets of the first character, and one past the last. */
+  size_t start;
+  size_t end;
+  /* Node number of the enclosing list, or -1 at top level. */
+  size_t parent;
+};
+
+struct sexp_index_key
+{
+  /* Node numbers of the enclosing list, and of the (key rest...)
+   * list. The key atom is node list + 1. */
+  size_t parent;
+  size_t list;
+  size_t key_length;
+  const uint8_t *key;
+};
+
+struct sexp_index
+{
+  size_t length;
+  const uint8_t *buffer;
+
+  size_t nnodes;
+  size_t nodes_alloc;
+  struct sexp_index_node *nodes;
+
+  size_t nkeys;
+  size_t keys_alloc;
+  struct sexp_index_key *keys;
+
+  void *realloc_ctx;
+  nettle_realloc_func *realloc;
+};
+
+void
+sexp_index_init(struct sexp_index *index,
+		void *realloc_ctx, nettle_realloc_func *realloc);
+
+void
+sexp_index_clear(struct sexp_index *index);
+
+/* Parses all of the input, which must stay valid as long as the
+ * index is used. Fails on syntax errors and out of memory. */
+int
+sexp_index_build(struct sexp_index *index,
+		 size_t length, const uint8_t *input);
+
+/* The iterator must be over the indexed buffer. */
+int
+sexp_index_next(const struct sexp_index *index,
+		struct sexp_iterator *iterator);
+
+int
+sexp_index_exit_list(const struct sexp_index *index,
+		     struct sexp_iterator *iterator);
+
+const uint8_t *
+sexp_index_subexpr(const struct sexp_index *index,
+		   struct sexp_iterator *iterator,
+		   size_t *length);
+
+/* Like sexp_iterator_assoc. Only elements at or after the current
+ * one are considered. */
+int
+sexp_index_assoc(const struct sexp_index *index,
+		 struct sexp_iterator *iterator,
+		 unsigned nkeys,
+		 const char * const *keys,
+		 struct sexp_iterator *values);
+
 
 /* Output functions. What is a reasonable API for this? It seems
  * ugly to have to reimplement string streams. */
@@ -206,6 +306,72 @@ size_t
 sexp_transport_vformat(struct nettle_buffer *buffer,
 		       const char *format, va_list args);
 
+/* Incremental transport encoding and decoding, for expressions that
+ * don't fit in memory. */
+
+/* Converts transport encoded input to canonical form. Like
+ * sexp_transport_iterator_first, it decodes any {...} groups, and
+ * skips white space and comments between them. The first character
+ * outside of a group that isn't white space or a comment starts
+ * canonical data, and all following input is copied unchanged. */
+struct sexp_transport_decode_ctx
+{
+  struct base64_decode_ctx base64;
+  unsigned state;
+};
+
+/* Maximum output of sexp_transport_decode_update. Decoding never
+ * expands the data, and may be done in place. */
+#define SEXP_TRANSPORT_DECODE_LENGTH(length) (length)
+
+void
+sexp_transport_decode_init(struct sexp_transport_decode_ctx *ctx);
+
+/* Returns 1 on success, 0 on error. DST should point to an area of
+ * size at least SEXP_TRANSPORT_DECODE_LENGTH(src_length), and may
+ * equal SRC. The amount of data generated is returned in
+ * *DST_LENGTH. */
+int
+sexp_transport_decode_update(struct sexp_transport_decode_ctx *ctx,
+			     size_t *dst_length,
+			     uint8_t *dst,
+			     size_t src_length,
+			     const uint8_t *src);
+
+/* Fails if the input ended inside a {...} group. */
+int
+sexp_transport_decode_final(struct sexp_transport_decode_ctx *ctx);
+
+/* Produces a single {...} group, with the base64 encoding of all the
+ * canonical data passed to sexp_transport_encode_update. */
+struct sexp_transport_encode_ctx
+{
+  struct base64_encode_ctx base64;
+  int started;
+};
+
+#define SEXP_TRANSPORT_ENCODE_LENGTH(length) \
+  (BASE64_ENCODE_LENGTH(length) + 1)
+#define SEXP_TRANSPORT_ENCODE_FINAL_LENGTH \
+  (BASE64_ENCODE_FINAL_LENGTH + 2)
+
+void
+sexp_transport_encode_init(struct sexp_transport_encode_ctx *ctx);
+
+/* Returns the number of output characters. DST should point to an
+ * area of size at least SEXP_TRANSPORT_ENCODE_LENGTH(length). */
+size_t
+sexp_transport_encode_update(struct sexp_transport_encode_ctx *ctx,
+			     uint8_t *dst,
+			     size_t length,
+			     const uint8_t *src);
+
+/* DST should point to an area of size at least
+ * SEXP_TRANSPORT_ENCODE_FINAL_LENGTH. */
+size_t
+sexp_transport_encode_final(struct sexp_transport_encode_ctx *ctx,
+			    uint8_t *dst);
+
 #ifdef __cplusplus
 }
 #endif
@@ -42,6 +42,25 @@
 void
 _nettle_sha256_compress(uint32_t *state, const uint8_t *data, const uint32_t *k);
 
+/* Like _nettle_sha256_compress, with the standard constants. For
+   code outside of sha256.c which does its own padding. */
+void
+_nettle_sha256_compress_block(uint32_t *state, const uint8_t *data);
+
+/* The standard constants, defined in sha256.c. */
+extern const uint32_t _nettle_sha256_k[64];
+
+/* Number of blocks processed in parallel by
+   _nettle_sha256_compress_lanes. */
+#define _SHA256_LANES 8
+
+/* Compresses _SHA256_LANES independent blocks. The state is stored
+   lane-wise, with word i of lane j in state[i][j], and DATA[j] points
+   to the block for lane j. */
+void
+_nettle_sha256_compress_lanes(uint32_t state[][_SHA256_LANES],
+			      const uint8_t **data);
+
 /* Internal compression function. STATE points to 8 uint64_t words,
    DATA points to 128 bytes of input data, possibly unaligned, and K
    points to the table of constants. */
@@ -49,8 +49,8 @@
 #include "nettle-write.h"
 
 /* Generated by the shadata program. */
-static const uint32_t
-K[64] =
+const uint32_t
+_nettle_sha256_k[64] =
 {
   0x428a2f98UL, 0x71374491UL, 0xb5c0fbcfUL, 0xe9b5dba5UL, 
   0x3956c25bUL, 0x59f111f1UL, 0x923f82a4UL, 0xab1c5ed5UL, 
@@ -70,8 +70,16 @@ K[64] =
   0x90befffaUL, 0xa4506cebUL, 0xbef9a3f7UL, 0xc67178f2UL, 
 };
 
+#define K _nettle_sha256_k
+
 #define COMPRESS(ctx, data) (_nettle_sha256_compress((ctx)->state, (data), K))
 
+void
+_nettle_sha256_compress_block(uint32_t *state, const uint8_t *data)
+{
+  _nettle_sha256_compress(state, data, K);
+}
+
 /* Initialize the SHA values */
 
 void
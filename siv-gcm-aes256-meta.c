@@ -0,0 +1,48 @@
+/* siv-gcm-aes256-meta.c
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "nettle-meta.h"
+
+#include "siv-gcm.h"
+
+const struct nettle_aead_message
+nettle_siv_gcm_aes256 =
+  { "siv_gcm_aes256", sizeof(struct aes256_ctx),
+    AES256_KEY_SIZE, SIV_GCM_NONCE_SIZE, SIV_GCM_DIGEST_SIZE,
+    (nettle_set_key_func *) aes256_set_encrypt_key,
+    (nettle_set_key_func *) aes256_set_encrypt_key,
+    (nettle_encrypt_message_func *) siv_gcm_aes256_encrypt_message,
+    (nettle_decrypt_message_func *) siv_gcm_aes256_decrypt_message
+  };
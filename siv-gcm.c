@@ -0,0 +1,246 @@
+/* siv-gcm.c
+
+   AES-GCM-SIV, RFC 8452
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "siv-gcm.h"
+
+#include "ctr-internal.h"
+#include "gcm-internal.h"
+#include "macros.h"
+#include "memops.h"
+#include "memxor.h"
+
+/* Number of blocks byte reversed at a time for POLYVAL. */
+#define POLYVAL_BATCH 32
+
+#define MIN(a,b) (((a) < (b)) ? (a) : (b))
+
+/* POLYVAL is computed using GHASH, as described in RFC 8452, Appendix
+   A. The blocks and the state are byte reversed, and the key is also
+   multiplied by x. */
+static void
+block16_reverse (union nettle_block16 *dst, const uint8_t *src)
+{
+  uint64_t hi = LE_READ_UINT64 (src + 8);
+  uint64_t lo = LE_READ_UINT64 (src);
+  WRITE_UINT64 (dst->b, hi);
+  WRITE_UINT64 (dst->b + 8, lo);
+}
+
+/* Multiplication by x, in GHASH's bit order. */
+static void
+ghash_mulx (union nettle_block16 *x)
+{
+  uint64_t hi = READ_UINT64 (x->b);
+  uint64_t lo = READ_UINT64 (x->b + 8);
+  uint64_t mask = -(lo & 1);
+
+  lo = (lo >> 1) | (hi << 63);
+  hi = (hi >> 1) ^ (mask & ((uint64_t) 0xE1 << 56));
+
+  WRITE_UINT64 (x->b, hi);
+  WRITE_UINT64 (x->b + 8, lo);
+}
+
+static void
+polyval_set_key (struct gcm_key *key, const uint8_t *h)
+{
+  union nettle_block16 b;
+
+  block16_reverse (&b, h);
+  ghash_mulx (&b);
+  _ghash_set_key (key, &b);
+}
+
+/* Processes data zero padded to a multiple of the block size. */
+static void
+polyval_update (const struct gcm_key *key, union nettle_block16 *x,
+		size_t length, const uint8_t *data)
+{
+  union nettle_block16 buffer[POLYVAL_BATCH];
+  size_t blocks = length / SIV_GCM_BLOCK_SIZE;
+
+  while (blocks > 0)
+    {
+      size_t n = MIN (blocks, POLYVAL_BATCH);
+      size_t i;
+
+      for (i = 0; i < n; i++, data += SIV_GCM_BLOCK_SIZE)
+	block16_reverse (&buffer[i], data);
+      _ghash_update (key, x, n * SIV_GCM_BLOCK_SIZE, buffer[0].b);
+
+      blocks -= n;
+    }
+
+  length %= SIV_GCM_BLOCK_SIZE;
+  if (length > 0)
+    {
+      uint8_t block[SIV_GCM_BLOCK_SIZE];
+      memcpy (block, data, length);
+      memset (block + length, 0, SIV_GCM_BLOCK_SIZE - length);
+      block16_reverse (&buffer[0], block);
+      _ghash_update (key, x, SIV_GCM_BLOCK_SIZE, buffer[0].b);
+    }
+}
+
+/* Derives the per-nonce authentication key, and sets up ctr_ctx with
+   the per-nonce encryption key. */
+static void
+siv_gcm_derive_keys (const struct nettle_cipher *nc, const void *ctx,
+		     void *ctr_ctx, const uint8_t *nonce,
+		     struct gcm_key *auth_key)
+{
+  union nettle_block16 block[6];
+  uint8_t keys[6 * 8];
+  unsigned n, i;
+
+  assert (nc->block_size == SIV_GCM_BLOCK_SIZE);
+  assert (nc->key_size == 16 || nc->key_size == 32);
+
+  n = 2 + nc->key_size / 8;
+  for (i = 0; i < n; i++)
+    {
+      LE_WRITE_UINT32 (block[i].b, i);
+      memcpy (block[i].b + 4, nonce, SIV_GCM_NONCE_SIZE);
+    }
+  nc->encrypt (ctx, n * SIV_GCM_BLOCK_SIZE, block[0].b, block[0].b);
+
+  /* The first half of each block is used. */
+  for (i = 0; i < n; i++)
+    memcpy (keys + 8*i, block[i].b, 8);
+
+  polyval_set_key (auth_key, keys);
+  nc->set_encrypt_key (ctr_ctx, keys + SIV_GCM_BLOCK_SIZE);
+}
+
+static void
+siv_gcm_authenticate (const struct nettle_cipher *nc, const void *ctr_ctx,
+		      const struct gcm_key *auth_key, const uint8_t *nonce,
+		      size_t alength, const uint8_t *adata,
+		      size_t mlength, const uint8_t *mdata,
+		      uint8_t *tag)
+{
+  union nettle_block16 x;
+  union nettle_block16 block;
+
+  memset (x.b, 0, sizeof(x));
+  polyval_update (auth_key, &x, alength, adata);
+  polyval_update (auth_key, &x, mlength, mdata);
+
+  LE_WRITE_UINT64 (block.b, (uint64_t) alength * 8);
+  LE_WRITE_UINT64 (block.b + 8, (uint64_t) mlength * 8);
+  polyval_update (auth_key, &x, SIV_GCM_BLOCK_SIZE, block.b);
+
+  block16_reverse (&block, x.b);
+  memxor (block.b, nonce, SIV_GCM_NONCE_SIZE);
+  block.b[SIV_GCM_BLOCK_SIZE - 1] &= 0x7f;
+
+  nc->encrypt (ctr_ctx, SIV_GCM_BLOCK_SIZE, tag, block.b);
+}
+
+/* The counter is the first 32 bits, little endian. */
+static nettle_fill16_func siv_gcm_fill;
+static void
+siv_gcm_fill (uint8_t *ctr, size_t blocks, union nettle_block16 *buffer)
+{
+  uint32_t c;
+
+  c = LE_READ_UINT32 (ctr);
+
+  for (; blocks-- > 0; buffer++, c++)
+    {
+      LE_WRITE_UINT32 (buffer->b, c);
+      memcpy (buffer->b + 4, ctr + 4, SIV_GCM_BLOCK_SIZE - 4);
+    }
+
+  LE_WRITE_UINT32 (ctr, c);
+}
+
+static void
+siv_gcm_crypt (const struct nettle_cipher *nc, const void *ctr_ctx,
+	       const uint8_t *tag, size_t length,
+	       uint8_t *dst, const uint8_t *src)
+{
+  uint8_t ctr[SIV_GCM_BLOCK_SIZE];
+
+  memcpy (ctr, tag, SIV_GCM_BLOCK_SIZE);
+  ctr[SIV_GCM_BLOCK_SIZE - 1] |= 0x80;
+
+  _ctr_crypt16 (ctr_ctx, nc->encrypt, siv_gcm_fill, ctr, length, dst, src);
+}
+
+void
+siv_gcm_encrypt_message (const struct nettle_cipher *nc,
+			 const void *ctx, void *ctr_ctx,
+			 size_t nlength, const uint8_t *nonce,
+			 size_t alength, const uint8_t *adata,
+			 size_t clength, uint8_t *dst, const uint8_t *src)
+{
+  struct gcm_key auth_key;
+  size_t mlength;
+
+  assert (nlength == SIV_GCM_NONCE_SIZE);
+  assert (clength >= SIV_GCM_DIGEST_SIZE);
+  mlength = clength - SIV_GCM_DIGEST_SIZE;
+
+  siv_gcm_derive_keys (nc, ctx, ctr_ctx, nonce, &auth_key);
+  siv_gcm_authenticate (nc, ctr_ctx, &auth_key, nonce, alength, adata,
+			mlength, src, dst + mlength);
+  siv_gcm_crypt (nc, ctr_ctx, dst + mlength, mlength, dst, src);
+}
+
+int
+siv_gcm_decrypt_message (const struct nettle_cipher *nc,
+			 const void *ctx, void *ctr_ctx,
+			 size_t nlength, const uint8_t *nonce,
+			 size_t alength, const uint8_t *adata,
+			 size_t mlength, uint8_t *dst, const uint8_t *src)
+{
+  struct gcm_key auth_key;
+  uint8_t tag[SIV_GCM_DIGEST_SIZE];
+
+  assert (nlength == SIV_GCM_NONCE_SIZE);
+
+  siv_gcm_derive_keys (nc, ctx, ctr_ctx, nonce, &auth_key);
+  siv_gcm_crypt (nc, ctr_ctx, src + mlength, mlength, dst, src);
+  siv_gcm_authenticate (nc, ctr_ctx, &auth_key, nonce, alength, adata,
+			mlength, dst, tag);
+
+  return memeql_sec (tag, src + mlength, SIV_GCM_DIGEST_SIZE);
+}
@@ -1,6 +1,27 @@
 #include "testutils.h"
 #include "base16.h"
 
+static void
+test_decode(const char *ascii, int ok, size_t data_length, const char *data)
+{
+  struct base16_decode_ctx ctx;
+  uint8_t buffer[20];
+  size_t done;
+  int res;
+
+  base16_decode_init(&ctx);
+  res = base16_decode_update(&ctx, &done, buffer, strlen(ascii), ascii)
+    && base16_decode_final(&ctx);
+  ASSERT (res == ok);
+  if (ok)
+    {
+      ASSERT (done == data_length);
+      ASSERT (MEMEQ (data_length, buffer, data));
+    }
+  ASSERT (nettle_armor_decode (&nettle_base16, &done, buffer,
+			       strlen(ascii), ascii) == ok);
+}
+
 void
 test_main(void)
 {
@@ -21,5 +42,19 @@ test_main(void)
   test_armor(&nettle_base16, LDATA("Hell"), "48656c6c");
   test_armor(&nettle_base16, LDATA("Hello"), "48656c6c6f");
   test_armor(&nettle_base16, LDATA("Hello\0"), "48656c6c6f00");
+  test_armor(&nettle_base16,
+	     47, H("00112233445566778899aabbccddeeff"
+		   "0123456789abcdef1032547698badcfe"
+		   "fedcba9876543210f0e1d2c3b4a596"),
+	     "00112233445566778899aabbccddeeff"
+	     "0123456789abcdef1032547698badcfe"
+	     "fedcba9876543210f0e1d2c3b4a596");
+
+  test_decode("48656C6c6F", 1, 5, "Hello");
+  test_decode("48 65\n6c\t6c 6f ", 1, 5, "Hello");
+  test_decode("4 86 5", 1, 2, "He");
+  test_decode("48656c6c6", 0, 0, NULL);
+  test_decode("48656g6c6f", 0, 0, NULL);
+  test_decode("4865\2006c", 0, 0, NULL);
 }
   
@@ -66,6 +66,79 @@ test_fuzz(void)
     }
 }
 
+/* Decodes one character at a time, as a reference for
+   base64_decode_update. */
+static int
+decode_single_ref (struct base64_decode_ctx *ctx, size_t *dst_length,
+		   uint8_t *dst, size_t src_length, const char *src)
+{
+  size_t done, i;
+  for (i = done = 0; i < src_length; i++)
+    {
+      int res = base64_decode_single (ctx, dst + done, src[i]);
+      if (res < 0)
+	return 0;
+      done += res;
+    }
+  *dst_length = done;
+  return 1;
+}
+
+static void
+test_decode_mixed(void)
+{
+  /* Mostly alphabet characters, with some white space, padding and
+     invalid characters, so that both the group-at-a-time path and
+     the character-at-a-time path of base64_decode_update are used. */
+  static const char chars[] =
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789"
+    "+/-_ \n\r\t=*";
+  struct knuth_lfib_ctx rand_ctx;
+  unsigned i;
+
+  knuth_lfib_init(&rand_ctx, 17);
+
+  for (i = 0; i < 20000; i++)
+    {
+      char src[100];
+      uint8_t dst[100], ref[100];
+      uint8_t r[100];
+      struct base64_decode_ctx ctx, ref_ctx;
+      size_t length = i % sizeof(src);
+      size_t dst_length, ref_length;
+      unsigned rare = 10 + i % 50;
+      size_t j;
+      int res;
+
+      knuth_lfib_random(&rand_ctx, length, r);
+      for (j = 0; j < length; j++)
+	src[j] = chars[r[j] < rare ? 124 + r[j] % 10 : r[j] % 124];
+
+      if (i & 1)
+	{
+	  base64_decode_init(&ctx);
+	  base64_decode_init(&ref_ctx);
+	}
+      else
+	{
+	  base64url_decode_init(&ctx);
+	  base64url_decode_init(&ref_ctx);
+	}
+      res = base64_decode_update(&ctx, &dst_length, dst, length, src);
+      ASSERT (res == decode_single_ref(&ref_ctx, &ref_length, ref,
+				       length, src));
+      if (res)
+	{
+	  ASSERT (dst_length == ref_length);
+	  ASSERT (MEMEQ (dst_length, dst, ref));
+	  ASSERT (ctx.bits == ref_ctx.bits);
+	  ASSERT (ctx.padding == ref_ctx.padding);
+	  ASSERT (base64_decode_final(&ctx) == base64_decode_final(&ref_ctx));
+	}
+    }
+}
+
 static inline void
 base64_encode_in_place (size_t length, uint8_t *data)
 {
@@ -136,4 +209,5 @@ test_main(void)
     ASSERT(MEMEQ(9, buffer, "HelloG8=x"));
   }
   test_fuzz ();
+  test_decode_mixed ();
 }
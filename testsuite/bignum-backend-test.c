@@ -0,0 +1,144 @@
+#include "testutils.h"
+
+#include "bignum-backend.h"
+
+#define MAX_SIZE 40
+#define COUNT 20
+
+static void
+check_result (const char *op, const struct bignum_backend *backend,
+	      const mp_limb_t *rp, mp_size_t rn, const mpz_t ref)
+{
+  mpz_t r;
+  mp_size_t n;
+
+  for (n = rn; n > 0 && rp[n-1] == 0; n--)
+    ;
+  if (mpz_limbs_cmp (ref, rp, n) == 0)
+    return;
+
+  mpz_init (r);
+  mpz_set_n (r, rp, rn);
+  fprintf (stderr, "%s failed for backend %s, size %u:\n got: ",
+	   op, backend->name, (unsigned) rn);
+  mpz_out_str (stderr, 16, r);
+  fprintf (stderr, "\n ref: ");
+  mpz_out_str (stderr, 16, ref);
+  fprintf (stderr, "\n");
+  abort ();
+}
+
+static void
+test_backend (const struct bignum_backend *backend,
+	      gmp_randstate_t rands)
+{
+  mp_limb_t *rp = xalloc_limbs (2*MAX_SIZE);
+  mp_limb_t *ap = xalloc_limbs (2*MAX_SIZE);
+  mp_limb_t *bp = xalloc_limbs (MAX_SIZE);
+  mp_limb_t *mp = xalloc_limbs (MAX_SIZE);
+  mp_limb_t *scratch;
+  mp_size_t itch;
+  mpz_t a, b, e, m, ref;
+  mp_size_t n;
+
+  mpz_init (a);
+  mpz_init (b);
+  mpz_init (e);
+  mpz_init (m);
+  mpz_init (ref);
+
+  itch = backend->sec_powm_itch (MAX_SIZE, 2 * MAX_SIZE * GMP_NUMB_BITS,
+				 MAX_SIZE);
+  if (backend->sec_invert_itch (MAX_SIZE) > itch)
+    itch = backend->sec_invert_itch (MAX_SIZE);
+  scratch = xalloc_limbs (itch);
+
+  for (n = 1; n <= MAX_SIZE; n++)
+    {
+      unsigned j;
+      for (j = 0; j < COUNT; j++)
+	{
+	  mp_bitcnt_t ebn;
+	  mp_size_t bn;
+
+	  /* Odd modulus of exactly n limbs. */
+	  do
+	    {
+	      if (j & 1)
+		mpz_rrandomb (m, rands, n * GMP_NUMB_BITS);
+	      else
+		mpz_urandomb (m, rands, n * GMP_NUMB_BITS);
+	      mpz_setbit (m, 0);
+	    }
+	  while (mpz_size (m) < (size_t) n || mpz_cmp_ui (m, 1) == 0);
+	  mpz_limbs_copy (mp, m, n);
+
+	  /* sec_powm, with small, large, and 1-bit exponents, and bases
+	     which may exceed m. */
+	  switch (j % 4)
+	    {
+	    case 0:
+	      mpz_set_ui (e, 65537);
+	      break;
+	    case 1:
+	      mpz_set_ui (e, 1);
+	      break;
+	    default:
+	      mpz_urandomb (e, rands, 1 + j * n * GMP_NUMB_BITS / COUNT);
+	      if (mpz_sgn (e) == 0)
+		mpz_set_ui (e, 3);
+	    }
+	  ebn = mpz_sizeinbase (e, 2);
+	  bn = 1 + (j / 2) % n;
+	  mpz_urandomb (b, rands, bn * GMP_NUMB_BITS);
+	  mpz_limbs_copy (bp, b, bn);
+	  mpz_limbs_copy (ap, e, mpz_size (e));
+	  ASSERT (backend->sec_powm_itch (bn, ebn, n) <= itch);
+	  backend->sec_powm (rp, bp, bn, ap, ebn, mp, n, scratch);
+	  mpz_powm (ref, b, e, m);
+	  check_result ("sec_powm", backend, rp, n, ref);
+
+	  /* sec_invert */
+	  mpz_urandomb (a, rands, n * GMP_NUMB_BITS);
+	  if (j % 5 == 4)
+	    {
+	      /* Make a share a factor with m. */
+	      mpz_gcd (ref, a, m);
+	      if (mpz_cmp_ui (ref, 1) == 0)
+		mpz_set (a, m);
+	    }
+	  mpz_limbs_copy (ap, a, n);
+	  if (backend->sec_invert (rp, ap, mp, n, 2 * n * GMP_NUMB_BITS,
+				   scratch))
+	    {
+	      ASSERT (mpz_invert (ref, a, m));
+	      check_result ("sec_invert", backend, rp, n, ref);
+	    }
+	  else
+	    ASSERT (!mpz_invert (ref, a, m));
+	}
+    }
+
+  mpz_clear (a);
+  mpz_clear (b);
+  mpz_clear (e);
+  mpz_clear (m);
+  mpz_clear (ref);
+  free (rp);
+  free (ap);
+  free (bp);
+  free (mp);
+  free (scratch);
+}
+
+void
+test_main (void)
+{
+  gmp_randstate_t rands;
+
+  gmp_randinit_default (rands);
+
+  test_backend (BIGNUM_BACKEND, rands);
+
+  gmp_randclear (rands);
+}
@@ -43,6 +43,29 @@ test_size(long x, unsigned size)
   ASSERT(nettle_mpz_sizeinbase_256_s(t) == size);
   mpz_clear(t);
 }
+
+static void
+test_base256_in_place(mp_size_t n)
+{
+  size_t length = n * sizeof(mp_limb_t);
+  mp_limb_t *xp = xalloc_limbs(n);
+  mp_limb_t *ref = xalloc_limbs(n);
+  uint8_t *octets = xalloc(length);
+  size_t i;
+
+  for (i = 0; i < length; i++)
+    octets[i] = 17 * i + 3 * n;
+
+  memcpy(xp, octets, length);
+  mpn_set_base256_in_place(xp, n);
+  mpn_set_base256(ref, n, octets, length);
+  ASSERT(mpn_cmp(xp, ref, n) == 0);
+
+  mpn_get_base256_in_place(xp, n);
+  ASSERT(MEMEQ(length, xp, octets));
+
+  free(xp); free(ref); free(octets);
+}
 #endif /* WITH_HOGWEED */
 
 
@@ -86,6 +109,12 @@ test_main(void)
   test_bignum("-7fff", SHEX(  "8001"));
   test_bignum("-8000", SHEX(  "8000"));
   test_bignum("-8001", SHEX("ff7fff"));
+
+  test_base256_in_place(1);
+  test_base256_in_place(2);
+  test_base256_in_place(3);
+  test_base256_in_place(8);
+  test_base256_in_place(9);
   
 #else /* !WITH_HOGWEED */
   SKIP();
@@ -0,0 +1,188 @@
+#include "testutils.h"
+#include "blake2.h"
+
+/* Input i mod 251 for byte i, as used in the BLAKE2 and BLAKE3 test
+   vectors. */
+static const struct tstring *
+pattern(size_t length)
+{
+  struct tstring *s = tstring_alloc (length);
+  size_t i;
+  for (i = 0; i < length; i++)
+    s->data[i] = i % 251;
+  return s;
+}
+
+/* The last block is kept until more input arrives, so check that
+   splitting the input at various places gives the same result. */
+static void
+test_split(const struct nettle_hash *hash, void *ctx,
+	   const struct tstring *msg, const struct tstring *digest)
+{
+  static const size_t steps[] = { 1, 63, 64, 65, 127, 128, 129 };
+  uint8_t buffer[BLAKE2B_DIGEST_SIZE];
+  unsigned i;
+
+  for (i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+    {
+      size_t done;
+      for (done = 0; done < msg->length; done += steps[i])
+	{
+	  size_t n = msg->length - done;
+	  if (n > steps[i])
+	    n = steps[i];
+	  hash->update (ctx, n, msg->data + done);
+	}
+      hash->digest (ctx, digest->length, buffer);
+      ASSERT (MEMEQ (digest->length, buffer, digest->data));
+    }
+}
+
+static void
+test_blake2b(size_t key_length, const uint8_t *key,
+	     const struct tstring *msg, const struct tstring *digest)
+{
+  struct blake2b_ctx ctx;
+
+  blake2b_init_key (&ctx, digest->length, key_length, key);
+  test_split (&nettle_blake2b_512, &ctx, msg, digest);
+}
+
+static void
+test_blake2s(size_t key_length, const uint8_t *key,
+	     const struct tstring *msg, const struct tstring *digest)
+{
+  struct blake2s_ctx ctx;
+
+  blake2s_init_key (&ctx, digest->length, key_length, key);
+  test_split (&nettle_blake2s_256, &ctx, msg, digest);
+}
+
+void
+test_main(void)
+{
+  uint8_t key[BLAKE2B_KEY_SIZE];
+  unsigned i;
+
+  for (i = 0; i < sizeof(key); i++)
+    key[i] = i;
+
+  /* From RFC 7693 */
+  test_hash (&nettle_blake2b_512, SDATA("abc"),
+	     SHEX("BA80A53F981C4D0D6A2797B69F12F6E9"
+		  "4C212F14685AC4B74B12BB6FDBFFA2D1"
+		  "7D87C5392AAB792DC252D5DE4533CC95"
+		  "18D38AA8DBF1925AB92386EDD4009923"));
+  test_hash (&nettle_blake2s_256, SDATA("abc"),
+	     SHEX("508C5E8C327C14E2E1A72BA34EEB452F"
+		  "37458B209ED63A294D999B4C86675982"));
+  test_hash (&nettle_blake2b_512, pattern(0),
+	     SHEX("786a02f742015903c6c6fd852552d272"
+		  "912f4740e15847618a86e217f71f5419"
+		  "d25e1031afee585313896444934eb04b"
+		  "903a685b1448b755d56f701afe9be2ce"));
+  test_hash (&nettle_blake2s_256, pattern(0),
+	     SHEX("69217a3079908094e11121d042354a7c"
+		  "1f55b6482ca1a51e1b250dfd1ed0eef9"));
+  test_hash (&nettle_blake2b_512, pattern(3),
+	     SHEX("40a374727302d9a4769c17b5f409ff32"
+		  "f58aa24ff122d7603e4fda1509e919d4"
+		  "107a52c57570a6d94e50967aea573b11"
+		  "f86f473f537565c66f7039830a85d186"));
+  test_hash (&nettle_blake2s_256, pattern(3),
+	     SHEX("e8f91c6ef232a041452ab0e149070cdd"
+		  "7dd1769e75b3a5921be37876c45c9900"));
+  test_hash (&nettle_blake2b_512, pattern(64),
+	     SHEX("2fc6e69fa26a89a5ed269092cb9b2a44"
+		  "9a4409a7a44011eecad13d7c4b045660"
+		  "2d402fa5844f1a7a758136ce3d5d8d0e"
+		  "8b86921ffff4f692dd95bdc8e5ff0052"));
+  test_hash (&nettle_blake2s_256, pattern(64),
+	     SHEX("56f34e8b96557e90c1f24b52d0c89d51"
+		  "086acf1b00f634cf1dde9233b8eaaa3e"));
+  test_hash (&nettle_blake2b_512, pattern(127),
+	     SHEX("b6292669ccd38d5f01caae96ba272c76"
+		  "a879a45743afa0725d83b9ebb26665b7"
+		  "31f1848c52f11972b6644f554c064fa9"
+		  "0780dbbbf3a89d4fc31f67df3e5857ef"));
+  test_hash (&nettle_blake2s_256, pattern(127),
+	     SHEX("f18417b39d617ab1c18fdf91ebd0fc6d"
+		  "5516bb34cf39364037bce81fa04cecb1"));
+  test_hash (&nettle_blake2b_512, pattern(128),
+	     SHEX("2319e3789c47e2daa5fe807f61bec2a1"
+		  "a6537fa03f19ff32e87eecbfd64b7e0e"
+		  "8ccff439ac333b040f19b0c4ddd11a61"
+		  "e24ac1fe0f10a039806c5dcc0da3d115"));
+  test_hash (&nettle_blake2s_256, pattern(128),
+	     SHEX("1fa877de67259d19863a2a34bcc6962a"
+		  "2b25fcbf5cbecd7ede8f1fa36688a796"));
+  test_hash (&nettle_blake2b_512, pattern(129),
+	     SHEX("f59711d44a031d5f97a9413c065d1e61"
+		  "4c417ede998590325f49bad2fd444d3e"
+		  "4418be19aec4e11449ac1a57207898bc"
+		  "57d76a1bcf3566292c20c683a5c4648f"));
+  test_hash (&nettle_blake2s_256, pattern(129),
+	     SHEX("5bd169e67c82c2c2e98ef7008bdf261f"
+		  "2ddf30b1c00f9e7f275bb3e8a28dc9a2"));
+  test_hash (&nettle_blake2b_512, pattern(1000),
+	     SHEX("c11e1c0340bd7e5a1b275f1230c962fa"
+		  "d215ecb1391486e74e31b960a2f29963"
+		  "81a5fad092da06841d5f26e38f6ecfea"
+		  "f441acbcd1c2de61aef121e7927175f5"));
+  test_hash (&nettle_blake2s_256, pattern(1000),
+	     SHEX("1c067a5e746fb0f6734efac9a8cdb0e1"
+		  "1061f0077f255184365c690115392501"));
+
+  /* Keyed, with the maximum key size */
+  test_blake2b (BLAKE2B_KEY_SIZE, key, pattern(0),
+		SHEX("10ebb67700b1868efb4417987acf4690"
+		     "ae9d972fb7a590c2f02871799aaa4786"
+		     "b5e996e8f0f4eb981fc214b005f42d2f"
+		     "f4233499391653df7aefcbc13fc51568"));
+  test_blake2s (BLAKE2S_KEY_SIZE, key, pattern(0),
+		SHEX("48a8997da407876b3d79c0d92325ad3b"
+		     "89cbb754d86ab71aee047ad345fd2c49"));
+  test_blake2b (BLAKE2B_KEY_SIZE, key, pattern(1),
+		SHEX("961f6dd1e4dd30f63901690c512e78e4"
+		     "b45e4742ed197c3c5e45c549fd25f2e4"
+		     "187b0bc9fe30492b16b0d0bc4ef9b0f3"
+		     "4c7003fac09a5ef1532e69430234cebd"));
+  test_blake2s (BLAKE2S_KEY_SIZE, key, pattern(1),
+		SHEX("40d15fee7c328830166ac3f918650f80"
+		     "7e7e01e177258cdc0a39b11f598066f1"));
+  test_blake2b (BLAKE2B_KEY_SIZE, key, pattern(255),
+		SHEX("8e1e2c579262b7c01966c3133c2bb704"
+		     "a165be2308ff8925a2f070dec7275740"
+		     "fa9fe004ee25c8e1a3dd57317065ee74"
+		     "4f0821c4e911eee8e484e770f21dd958"));
+  test_blake2s (BLAKE2S_KEY_SIZE, key, pattern(255),
+		SHEX("1198d1da21a1ef3056099ef664dd9c6b"
+		     "06c482674dc334dbafd1627be358bfb5"));
+
+  /* Smaller digest sizes are distinct functions, not truncations. */
+  test_blake2b (0, NULL, SDATA("abc"),
+		SHEX("bddd813c634239723171ef3fee98579b"
+		     "94964e3bb1cb3e427262c8c068d52319"));
+  test_blake2s (3, (const uint8_t *) "key", SDATA("abc"),
+		SHEX("94fdf6f35b9999920dcdcaee361ad435"));
+
+  for (i = 0; i < 130; i++)
+    {
+      const struct tstring *msg = pattern(i);
+      struct blake2b_ctx b;
+      struct blake2s_ctx s;
+      uint8_t digest[BLAKE2B_DIGEST_SIZE];
+
+      blake2b_512_init (&b);
+      blake2b_update (&b, msg->length, msg->data);
+      blake2b_digest (&b, BLAKE2B_DIGEST_SIZE, digest);
+      test_split (&nettle_blake2b_512, &b, msg,
+		  tstring_data (BLAKE2B_DIGEST_SIZE, digest));
+
+      blake2s_256_init (&s);
+      blake2s_update (&s, msg->length, msg->data);
+      blake2s_digest (&s, BLAKE2S_DIGEST_SIZE, digest);
+      test_split (&nettle_blake2s_256, &s, msg,
+		  tstring_data (BLAKE2S_DIGEST_SIZE, digest));
+    }
+}
@@ -0,0 +1,170 @@
+#include "testutils.h"
+#include "blake3.h"
+
+/* Input i mod 251 for byte i, as in the official BLAKE3 test
+   vectors. */
+static const struct tstring *
+pattern(size_t length)
+{
+  struct tstring *s = tstring_alloc (length);
+  size_t i;
+  for (i = 0; i < length; i++)
+    s->data[i] = i % 251;
+  return s;
+}
+
+/* Hashes msg in pieces of various sizes, to exercise both the
+   buffering and the multi-chunk path. */
+static void
+test_blake3(struct blake3_ctx *ctx,
+	    const struct tstring *msg, const struct tstring *digest)
+{
+  static const size_t steps[] = { 1, 63, 64, 65, 1023, 1024, 1025, 8192, 9000 };
+  uint8_t *buffer = xalloc (digest->length);
+  unsigned i;
+
+  for (i = 0; i < sizeof(steps) / sizeof(steps[0]); i++)
+    {
+      size_t done;
+      for (done = 0; done < msg->length; done += steps[i])
+	{
+	  size_t n = msg->length - done;
+	  if (n > steps[i])
+	    n = steps[i];
+	  blake3_update (ctx, n, msg->data + done);
+	}
+      blake3_digest (ctx, digest->length, buffer);
+      ASSERT (MEMEQ (digest->length, buffer, digest->data));
+    }
+  free (buffer);
+}
+
+static void
+test_plain(const struct tstring *msg, const struct tstring *digest)
+{
+  struct blake3_ctx ctx;
+
+  test_hash (&nettle_blake3_256, msg, digest);
+  blake3_init (&ctx);
+  test_blake3 (&ctx, msg, digest);
+}
+
+void
+test_main(void)
+{
+  static const char key[] = "whats the Elvish word for friend";
+  static const char context[]
+    = "BLAKE3 2019-12-27 16:29:52 test vectors context";
+  struct blake3_ctx ctx;
+
+  test_hash (&nettle_blake3_256, SDATA("abc"),
+	     SHEX("6437b3ac38465133ffb63b75273a8db5"
+		  "48c558465d79db03fd359c6cd5bd9d85"));
+
+  /* From the official test vectors */
+  test_plain (pattern(0),
+	      SHEX("af1349b9f5f9a1a6a0404dea36dcc949"
+		   "9bcb25c9adc112b7cc9a93cae41f3262"));
+  test_plain (pattern(1),
+	      SHEX("2d3adedff11b61f14c886e35afa03673"
+		   "6dcd87a74d27b5c1510225d0f592e213"));
+  test_plain (pattern(1023),
+	      SHEX("10108970eeda3eb932baac1428c7a216"
+		   "3b0e924c9a9e25b35bba72b28f70bd11"));
+  test_plain (pattern(1024),
+	      SHEX("42214739f095a406f3fc83deb889744a"
+		   "c00df831c10daa55189b5d121c855af7"));
+  test_plain (pattern(1025),
+	      SHEX("d00278ae47eb27b34faecf67b4fe263f"
+		   "82d5412916c1ffd97c8cb7fb814b8444"));
+  test_plain (pattern(2048),
+	      SHEX("e776b6028c7cd22a4d0ba182a8bf6220"
+		   "5d2ef576467e838ed6f2529b85fba24a"));
+  test_plain (pattern(2049),
+	      SHEX("5f4d72f40d7a5f82b15ca2b2e44b1de3"
+		   "c2ef86c426c95c1af0b6879522563030"));
+  test_plain (pattern(3072),
+	      SHEX("b98cb0ff3623be03326b373de6b90952"
+		   "18513e64f1ee2edd2525c7ad1e5cffd2"));
+  test_plain (pattern(3073),
+	      SHEX("7124b49501012f81cc7f11ca069ec922"
+		   "6cecb8a2c850cfe644e327d22d3e1cd3"));
+  test_plain (pattern(4096),
+	      SHEX("015094013f57a5277b59d8475c050104"
+		   "2c0b642e531b0a1c8f58d2163229e969"));
+  test_plain (pattern(4097),
+	      SHEX("9b4052b38f1c5fc8b1f9ff7ac7b27cd2"
+		   "42487b3d890d15c96a1c25b8aa0fb995"));
+  test_plain (pattern(5120),
+	      SHEX("9cadc15fed8b5d854562b26a9536d970"
+		   "7cadeda9b143978f319ab34230535833"));
+  test_plain (pattern(5121),
+	      SHEX("628bd2cb2004694adaab7bbd778a25df"
+		   "25c47b9d4155a55f8fbd79f2fe154cff"));
+  test_plain (pattern(6144),
+	      SHEX("3e2e5b74e048f3add6d21faab3f83aa4"
+		   "4d3b2278afb83b80b3c35164ebeca205"));
+  test_plain (pattern(6145),
+	      SHEX("f1323a8631446cc50536a9f705ee5cb6"
+		   "19424d46887f3c376c695b70e0f0507f"));
+  test_plain (pattern(7168),
+	      SHEX("61da957ec2499a95d6b8023e2b0e604e"
+		   "c7f6b50e80a9678b89d2628e99ada77a"));
+  test_plain (pattern(7169),
+	      SHEX("a003fc7a51754a9b3c7fae0367ab3d78"
+		   "2dccf28855a03d435f8cfe74605e7817"));
+  test_plain (pattern(8192),
+	      SHEX("aae792484c8efe4f19e2ca7d371d8c46"
+		   "7ffb10748d8a5a1ae579948f718a2a63"));
+  test_plain (pattern(8193),
+	      SHEX("bab6c09cb8ce8cf459261398d2e7aef3"
+		   "5700bf488116ceb94a36d0f5f1b7bc3b"));
+  test_plain (pattern(16384),
+	      SHEX("f875d6646de28985646f34ee13be9a57"
+		   "6fd515f76b5b0a26bb324735041ddde4"));
+  test_plain (pattern(31744),
+	      SHEX("62b6960e1a44bcc1eb1a611a8d6235b6"
+		   "b4b78f32e7abc4fb4c6cdcce94895c47"));
+  test_plain (pattern(102400),
+	      SHEX("bc3e3d41a1146b069abffad3c0d44860"
+		   "cf664390afce4d9661f7902e7943e085"));
+
+  /* Extended output */
+  blake3_init (&ctx);
+  test_blake3 (&ctx, pattern(1025),
+	       SHEX("d00278ae47eb27b34faecf67b4fe263f"
+		    "82d5412916c1ffd97c8cb7fb814b8444"
+		    "f4c4a22b4b399155358a994e52bf255d"
+		    "e60035742ec71bd08ac275a1b51cc6bf"
+		    "e332b0ef84b409108cda080e6269ed4b"
+		    "3e2c3f7d722aa4cdc98d16deb554e562"
+		    "7be8f955c98e1d5f9565a9194cad0c42"
+		    "85f93700062d9595adb992ae68ff1280"
+		    "0ab67a"));
+
+  /* Keyed hashing and key derivation */
+  blake3_init_key (&ctx, (const uint8_t *) key);
+  test_blake3 (&ctx, pattern(0),
+	       SHEX("92b2b75604ed3c761f9d6f62392c8a92"
+		    "27ad0ea3f09573e783f1498a4ed60d26"));
+  blake3_init_derive_key (&ctx, strlen (context), (const uint8_t *) context);
+  test_blake3 (&ctx, pattern(0),
+	       SHEX("2cc39783c223154fea8dfb7c1b1660f2"
+		    "ac2dcbd1c1de8277b0b0dd39b7e50d7d"));
+  blake3_init_key (&ctx, (const uint8_t *) key);
+  test_blake3 (&ctx, pattern(1025),
+	       SHEX("357dc55de0c7e382c900fd6e320acc04"
+		    "146be01db6a8ce7210b7189bd664ea69"));
+  blake3_init_derive_key (&ctx, strlen (context), (const uint8_t *) context);
+  test_blake3 (&ctx, pattern(1025),
+	       SHEX("effaa245f065fbf82ac186839a249707"
+		    "c3bddf6d3fdda22d1b95a3c970379bcb"));
+  blake3_init_key (&ctx, (const uint8_t *) key);
+  test_blake3 (&ctx, pattern(8193),
+	       SHEX("954a2a75420c8d6547e3ba5b98d963e6"
+		    "fa6491addc8c023189cc519821b4a1f5"));
+  blake3_init_derive_key (&ctx, strlen (context), (const uint8_t *) context);
+  test_blake3 (&ctx, pattern(8193),
+	       SHEX("af1e0346e389b17c23200270a64aa4e1"
+		    "ead98c61695d917de7d5b00491c9b0f1"));
+}
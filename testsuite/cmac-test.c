@@ -80,6 +80,85 @@ test_cmac_hash (nettle_set_key_func *set_key,
   free (ctx);
 }
 
+/* Compares cmac_aes128_many to cmac_aes128_digest, for all batch
+   sizes up to a few groups of lanes, and messages of mixed
+   lengths. */
+static void
+test_cmac_aes128_many (void)
+{
+  struct cmac_aes128_ctx ctx;
+  const uint8_t *messages[20];
+  size_t lengths[20];
+  uint8_t data[120];
+  uint8_t digests[20 * 16 + 1];
+  uint8_t digest[16];
+  unsigned i, n;
+
+  for (i = 0; i < sizeof(data); i++)
+    data[i] = i * 13 + 1;
+
+  for (i = 0; i < 20; i++)
+    {
+      messages[i] = data + i;
+      lengths[i] = (i * 23) % 100;
+    }
+  lengths[2] = 16;
+  lengths[3] = 32;
+
+  cmac_aes128_set_key (&ctx, data);
+  for (n = 0; n <= 20; n++)
+    {
+      size_t length = n % 2 ? 16 : 8;
+      digests[n * length] = 17;
+      cmac_aes128_many (&ctx, n, lengths, messages, length, digests);
+      ASSERT (digests[n * length] == 17);
+
+      for (i = 0; i < n; i++)
+	{
+	  cmac_aes128_update (&ctx, lengths[i], messages[i]);
+	  cmac_aes128_digest (&ctx, length, digest);
+	  ASSERT (MEMEQ (length, digests + i * length, digest));
+	}
+    }
+}
+
+/* Runs the RFC 4493 messages, under the AES-256 key of the
+   cmac_aes256 tests, through cmac_aes256_many, each vector several
+   times so that the batch spans more than one group of lanes. */
+static void
+test_cmac_aes256_many (void)
+{
+  static const size_t vector_lengths[4] = { 0, 16, 40, 64 };
+  const struct tstring *key
+    = SHEX("603deb1015ca71be2b73aef0857d77811f352c073b6108d72d9810a30914dff4");
+  const struct tstring *msg
+    = SHEX("6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e51"
+	   "30c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710");
+  const struct tstring *tags
+    = SHEX("028962f61b7bf89efc6b551f4667d983"
+	   "28a7023f452e8f82bd4bf28d8c37c35c"
+	   "aaf3d8f1de5640c232f5b169b9c911e6"
+	   "e1992190549f6ed5696a2c056c315410");
+  struct cmac_aes256_ctx ctx;
+  const uint8_t *messages[3 * CMAC128_LANES + 1];
+  size_t lengths[3 * CMAC128_LANES + 1];
+  uint8_t digests[(3 * CMAC128_LANES + 1) * 16];
+  unsigned i, n;
+
+  n = 3 * CMAC128_LANES + 1;
+  for (i = 0; i < n; i++)
+    {
+      messages[i] = msg->data;
+      lengths[i] = vector_lengths[i % 4];
+    }
+
+  cmac_aes256_set_key (&ctx, key->data);
+  cmac_aes256_many (&ctx, n, lengths, messages, 16, digests);
+
+  for (i = 0; i < n; i++)
+    ASSERT (MEMEQ (16, digests + i * 16, tags->data + (i % 4) * 16));
+}
+
 void
 test_main(void)
 {
@@ -144,4 +223,6 @@ test_main(void)
 		  SHEX("6bc1bee22e409f96e93d7e117393172aae2d8a571e03ac9c9eb76fac45af8e5130c81c46a35ce411e5fbc1191a0a52eff69f2445df4f9b17ad2b417be66c3710"),
 		  SHEX("e1992190549f6ed5696a2c056c315410"));
 
+  test_cmac_aes128_many ();
+  test_cmac_aes256_many ();
 }
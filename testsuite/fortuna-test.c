@@ -0,0 +1,125 @@
+#include "testutils.h"
+#include "fortuna.h"
+
+/* ChaCha20 output for the given key, with zero nonce and counter. */
+static void
+keystream(const uint8_t *key, size_t length, uint8_t *dst)
+{
+  static const uint8_t nonce[CHACHA_NONCE_SIZE];
+  struct chacha_ctx ctx;
+
+  chacha_set_key (&ctx, key);
+  chacha_set_nonce (&ctx, nonce);
+  memset (dst, 0, length);
+  chacha_crypt (&ctx, length, dst, dst);
+}
+
+static void
+test_generator(void)
+{
+  static const uint8_t zero_key[CHACHA_KEY_SIZE];
+  struct fortuna_ctx ctx;
+  struct sha256_ctx hash;
+  uint8_t key[CHACHA_KEY_SIZE];
+  uint8_t stream[30 * CHACHA_BLOCK_SIZE];
+  uint8_t out[2000];
+
+  fortuna_init (&ctx, 0, NULL);
+  ASSERT (!fortuna_is_seeded (&ctx));
+  fortuna_seed (&ctx, 4, (const uint8_t *) "seed");
+  ASSERT (fortuna_is_seeded (&ctx));
+
+  sha256_init (&hash);
+  sha256_update (&hash, sizeof(zero_key), zero_key);
+  sha256_update (&hash, 4, (const uint8_t *) "seed");
+  sha256_digest (&hash, sizeof(key), key);
+
+  /* The first CHACHA_KEY_SIZE octets of each buffer are the next key. */
+  keystream (key, FORTUNA_BUFFER_SIZE, stream);
+  memcpy (key, stream, sizeof(key));
+
+  fortuna_random (&ctx, 100, out);
+  ASSERT (MEMEQ (100, out, stream + 32));
+  fortuna_random (&ctx, 1000, out);
+  ASSERT (MEMEQ (636, out, stream + 132));
+
+  keystream (key, FORTUNA_BUFFER_SIZE, stream);
+  memcpy (key, stream, sizeof(key));
+  ASSERT (MEMEQ (364, out + 636, stream + 32));
+
+  /* Large requests bypass the buffer, using block 0 as the next key. */
+  fortuna_random (&ctx, 2000, out);
+  ASSERT (MEMEQ (372, out, stream + 396));
+
+  keystream (key, 26 * CHACHA_BLOCK_SIZE, stream);
+  memcpy (key, stream, sizeof(key));
+  ASSERT (MEMEQ (1600, out + 372, stream + CHACHA_BLOCK_SIZE));
+
+  keystream (key, FORTUNA_BUFFER_SIZE, stream);
+  ASSERT (MEMEQ (28, out + 1972, stream + 32));
+}
+
+static void
+test_pools(void)
+{
+  struct fortuna_source sources[2];
+  struct fortuna_source other_sources[2];
+  struct fortuna_ctx ctx;
+  struct fortuna_ctx other;
+  uint8_t out[100];
+  uint8_t other_out[100];
+  unsigned i;
+
+  /* Until seeded, samples go to pool 0. */
+  fortuna_init (&ctx, 2, sources);
+  ASSERT (fortuna_update (&ctx, 0, 50, 16, (const uint8_t *) "0123456789abcdef") == 0);
+  ASSERT (fortuna_update (&ctx, 1, 50, 16, (const uint8_t *) "0123456789abcdef") == 0);
+  ASSERT (!fortuna_is_seeded (&ctx));
+  /* The estimate is limited to 4 bits per octet. */
+  ASSERT (fortuna_update (&ctx, 1, 50, 5, (const uint8_t *) "01234") == 0);
+  ASSERT (sources[1].pool0_estimate == 70);
+  ASSERT (fortuna_update (&ctx, 0, 10, 5, (const uint8_t *) "01234") == 1);
+  ASSERT (fortuna_is_seeded (&ctx));
+  ASSERT (sources[0].pool0_estimate == 0);
+  ASSERT (sources[0].total_estimate == 60);
+
+  /* Then each source cycles through the pools. */
+  for (i = 0; i < FORTUNA_POOLS; i++)
+    ASSERT (fortuna_update (&ctx, 0, 0, 1, (const uint8_t *) "a") == 0);
+
+  other = ctx;
+  memcpy (other_sources, sources, sizeof(sources));
+  other.sources = other_sources;
+
+  /* Pool 2 differs. Reseed 4 is the first to use it. */
+  ASSERT (ctx.reseed_count == 1);
+  for (i = 0; i < 2; i++)
+    {
+      ASSERT (fortuna_update (&ctx, 0, 0, 1, (const uint8_t *) "x") == 0);
+      ASSERT (fortuna_update (&other, 0, 0, 1, (const uint8_t *) "x") == 0);
+    }
+  ASSERT (fortuna_update (&ctx, 0, 0, 1, (const uint8_t *) "y") == 0);
+  ASSERT (fortuna_update (&other, 0, 0, 1, (const uint8_t *) "z") == 0);
+
+  for (i = 2; i < 4; i++)
+    {
+      fortuna_reseed (&ctx);
+      fortuna_reseed (&other);
+      fortuna_random (&ctx, sizeof(out), out);
+      fortuna_random (&other, sizeof(other_out), other_out);
+      ASSERT (MEMEQ (sizeof(out), out, other_out));
+    }
+
+  fortuna_reseed (&ctx);
+  fortuna_reseed (&other);
+  fortuna_random (&ctx, sizeof(out), out);
+  fortuna_random (&other, sizeof(other_out), other_out);
+  ASSERT (!MEMEQ (sizeof(out), out, other_out));
+}
+
+void
+test_main(void)
+{
+  test_generator ();
+  test_pools ();
+}
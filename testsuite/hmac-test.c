@@ -13,6 +13,74 @@
     ASSERT(digest[mac->length] == 17);			\
   } while (0)
 
+/* Checks the prepared key functions, including reuse of the context
+   after a digest. */
+#define HMAC_SHA256_KEY_TEST(key, msg, mac)			\
+  do {								\
+    struct hmac_sha256_key k;					\
+    struct hmac_sha256_ctx ctx;					\
+								\
+    hmac_sha256_key_set(&k, key->length, key->data);		\
+    digest[mac->length] = 17;					\
+    hmac_sha256(&k, msg->length, msg->data, mac->length, digest); \
+    ASSERT(MEMEQ (mac->length, digest, mac->data));		\
+    ASSERT(digest[mac->length] == 17);				\
+								\
+    hmac_sha256_load_key(&ctx, &k);				\
+    hmac_sha256_update(&ctx, 1, (const uint8_t *) "x");	\
+    hmac_sha256_digest(&ctx, mac->length, digest);		\
+    hmac_sha256_update(&ctx, msg->length, msg->data);		\
+    hmac_sha256_digest(&ctx, mac->length, digest);		\
+    ASSERT(MEMEQ (mac->length, digest, mac->data));		\
+    ASSERT(digest[mac->length] == 17);				\
+  } while (0)
+
+/* Compares the batch function to hmac_sha256, for all batch sizes
+   up to a few groups of lanes, and messages of mixed lengths. */
+static void
+test_hmac_sha256_many(void)
+{
+  struct hmac_sha256_key keys[20];
+  const struct hmac_sha256_key *key_ptrs[20];
+  const uint8_t *messages[20];
+  size_t lengths[20];
+  uint8_t data[300];
+  uint8_t digests[20 * SHA256_DIGEST_SIZE + 1];
+  uint8_t digest[SHA256_DIGEST_SIZE];
+  unsigned i, n;
+
+  for (i = 0; i < sizeof(data); i++)
+    data[i] = i * 17 + 5;
+
+  for (i = 0; i < 20; i++)
+    {
+      hmac_sha256_key_set (&keys[i], 1 + i * 7, data + i);
+      key_ptrs[i] = &keys[i];
+      messages[i] = data + i;
+      lengths[i] = (i * 37) % 200;
+    }
+  /* Exercise the padding boundaries. */
+  lengths[3] = 55;
+  lengths[4] = 56;
+  lengths[5] = 64;
+
+  for (n = 0; n <= 20; n++)
+    {
+      size_t digest_length = n % 2 ? SHA256_DIGEST_SIZE : 12;
+      digests[n * digest_length] = 17;
+      hmac_sha256_many (n, key_ptrs, lengths, messages,
+			digest_length, digests);
+      ASSERT (digests[n * digest_length] == 17);
+
+      for (i = 0; i < n; i++)
+	{
+	  hmac_sha256 (&keys[i], lengths[i], messages[i],
+		       digest_length, digest);
+	  ASSERT (MEMEQ (digest_length, digests + i * digest_length, digest));
+	}
+    }
+}
+
 void
 test_main(void)
 {
@@ -628,6 +696,44 @@ test_main(void)
 	    SHEX("c89a7039a62985ff813fe4509b918a43"
 		 "6d7b1ffd8778e2c24dec464849fb6128"));
 
+  /* Prepared sha256 keys and one-shot hmac_sha256, with some of the
+     vectors above: a short key, an empty message, a truncated digest,
+     and a key and message larger than the block size. */
+  HMAC_SHA256_KEY_TEST(
+	    SHEX("0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b"
+		 "0b0b0b0b"),
+	    SDATA("Hi There"),
+	    SHEX("b0344c61d8db38535ca8afceaf0bf12b"
+		 "881dc200c9833da726e9376c2e32cff7"));
+
+  HMAC_SHA256_KEY_TEST(
+	    SDATA("monkey monkey monkey monkey"),
+	    SDATA(""),
+	    SHEX("5c780648c90d121c50091c3a0c3afc1f"
+		 "4ab847528005d99d9821ad3f341b651a"));
+
+  HMAC_SHA256_KEY_TEST(
+	    SHEX("0c0c0c0c0c0c0c0c 0c0c0c0c0c0c0c0c 0c0c0c0c"),
+	    SDATA("Test With Truncation"),
+	    SHEX("a3b6167473100ee06e0c796c2955552b"));
+
+  HMAC_SHA256_KEY_TEST(
+	    SHEX("aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+		 "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+		 "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+		 "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+		 "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+		 "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+		 "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+		 "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+		 "aaaaaa"),
+	    SDATA("This is a test using a larger than block-size ke"
+		  "y and a larger than block-size data. The key nee"
+		  "ds to be hashed before being used by the HMAC al"
+		  "gorithm."),
+	    SHEX("9b09ffa71b942fcb27635fbcd5b0e944"
+		 "bfdc63644f0713938a7f51535c3a35e2"));
+
   /* Test vectors for sha384, from RFC 4231 */
   HMAC_TEST(sha384,
 	    SHEX("0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b0b"
@@ -894,4 +1000,6 @@ test_main(void)
 		 "b1ff68a1de45509fbe4da9a433922655"));
 
   /* Test case AUTH512-3 from same document seems broken. */
+
+  test_hmac_sha256_many ();
 }
@@ -1,4 +1,5 @@
 #include "testutils.h"
+#include "knuth-lfib.h"
 #include "memxor.h"
 
 #define MAX_SIZE 256
@@ -113,6 +114,86 @@ test_memxor3 (const uint8_t *ain, const uint8_t *bin, const uint8_t *c,
   ASSERT (dst[size] == 17);
 }
 
+/* Larger sizes and alignments, exercising the loops of vectorized
+   implementations. The largest size is big enough to use non-temporal
+   stores. */
+static void
+test_memxor_large (void)
+{
+  static const size_t size[] = {
+    255, 256, 257, 511, 512, 1000, 4096, 4159, (1 << 24) + 333, 0
+  };
+  struct knuth_lfib_ctx rand;
+  size_t max = (1 << 24) + 333 + 128;
+  uint8_t *a = xalloc (max);
+  uint8_t *b = xalloc (max);
+  uint8_t *dst = xalloc (max);
+  uint8_t *ref = xalloc (max);
+  unsigned i;
+
+  knuth_lfib_init (&rand, 17);
+  knuth_lfib_random (&rand, max, a);
+  knuth_lfib_random (&rand, max, b);
+
+  for (i = 0; size[i]; i++)
+    {
+      unsigned align;
+      for (align = 0; align < 128; align += (size[i] > 5000 ? 37 : 1))
+	{
+	  size_t n = size[i];
+	  size_t j;
+	  for (j = 0; j < n; j++)
+	    ref[j] = a[j] ^ b[j + 64];
+
+	  memset (dst, 0, align);
+	  dst[align + n] = 17;
+	  memxor3 (dst + align, a, b + 64, n);
+	  ASSERT (MEMEQ (n, dst + align, ref));
+	  ASSERT (dst[align + n] == 17);
+
+	  memcpy (dst + align, a, n);
+	  memxor (dst + align, b + align % 64, n);
+	  for (j = 0; j < n; j++)
+	    ref[j] = a[j] ^ b[j + align % 64];
+	  ASSERT (MEMEQ (n, dst + align, ref));
+	  ASSERT (dst[align + n] == 17);
+	}
+    }
+  free (a);
+  free (b);
+  free (dst);
+  free (ref);
+}
+
+/* The overlap used by cbc_decrypt, with b ending block_size octets
+   after the start of dst. */
+static void
+test_memxor3_overlap (void)
+{
+  static const unsigned block_size[] = { 8, 16, 0 };
+  uint8_t a[1100];
+  uint8_t buf[1100];
+  uint8_t ref[1100];
+  struct knuth_lfib_ctx rand;
+  unsigned i, j;
+  size_t n;
+
+  knuth_lfib_init (&rand, 4711);
+  knuth_lfib_random (&rand, sizeof(a), a);
+
+  for (i = 0; block_size[i]; i++)
+    for (n = 0; n < 1000; n += 61)
+      {
+	unsigned bs = block_size[i];
+	knuth_lfib_random (&rand, bs + n, buf);
+	for (j = 0; j < n; j++)
+	  ref[j] = a[j] ^ buf[j];
+
+	memxor3 (buf + bs, a, buf, n);
+	ASSERT (MEMEQ (n, buf + bs, ref));
+      }
+}
+
 void
 test_main(void)
 {
@@ -182,4 +263,6 @@ test_main(void)
 	  for (align_b = 0; align_b < ALIGN_SIZE; align_b++)
 	    test_memxor3 (a, b, c, size[i], align_dst, align_a, align_b);
 	}
+  test_memxor_large ();
+  test_memxor3_overlap ();
 }
@@ -9,9 +9,15 @@ const char* aeads[] = {
   "gcm_camellia128",
   "gcm_camellia256",
   "eax_aes128",
+  "ocb_aes128",
   "chacha_poly1305",
 };
 
+const char* aead_messages[] = {
+  "siv_gcm_aes128",
+  "siv_gcm_aes256",
+};
+
 void
 test_main(void)
 {
@@ -28,5 +34,18 @@ test_main(void)
   while (NULL != nettle_aeads[j])
     j++;
   ASSERT(j == count); /* we are not missing testing any aeads */
+
+  count = sizeof(aead_messages)/sizeof(*aead_messages);
+  for (i = 0; i < count; i++) {
+    for (j = 0; NULL != nettle_aead_messages[j]; j++) {
+      if (0 == strcmp(aead_messages[i], nettle_aead_messages[j]->name))
+        break;
+    }
+    ASSERT(NULL != nettle_aead_messages[j]);
+  }
+  j = 0;
+  while (NULL != nettle_aead_messages[j])
+    j++;
+  ASSERT(j == count);
 }
   
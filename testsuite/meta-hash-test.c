@@ -2,7 +2,7 @@
 #include "nettle-internal.h"
 #include "nettle-meta.h"
 /* For NETTLE_MAX_HASH_CONTEXT_SIZE */
-#include "sha3.h"
+#include "blake3.h"
 
 const char* hashes[] = {
   "md2",
@@ -18,6 +18,9 @@ const char* hashes[] = {
   "sha3_256",
   "sha3_384",
   "sha3_512",
+  "blake2b_512",
+  "blake2s_256",
+  "blake3_256",
 };
 
 void
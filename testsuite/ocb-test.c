@@ -0,0 +1,301 @@
+#include "testutils.h"
+#include "nettle-internal.h"
+#include "macros.h"
+#include "ocb.h"
+
+/* The ciphertext argument includes the tag, as in RFC 7253. */
+static void
+test_ocb_aes128 (const struct tstring *key,
+		 const struct tstring *nonce,
+		 const struct tstring *authtext,
+		 const struct tstring *cleartext,
+		 const struct tstring *ciphertext)
+{
+  ASSERT (ciphertext->length == cleartext->length + OCB_DIGEST_SIZE);
+  test_aead (&nettle_ocb_aes128, (nettle_hash_update_func *) ocb_aes128_set_nonce,
+	     key, authtext, cleartext,
+	     tstring_data (cleartext->length, ciphertext->data),
+	     nonce,
+	     tstring_data (OCB_DIGEST_SIZE,
+			   ciphertext->data + cleartext->length));
+}
+
+/* Generic interface, for other tag lengths. */
+static void
+test_ocb_tag (const struct tstring *key,
+	      const struct tstring *nonce,
+	      const struct tstring *authtext,
+	      const struct tstring *cleartext,
+	      const struct tstring *ciphertext)
+{
+  struct ocb_key ocb_key;
+  struct ocb_ctx ctx;
+  struct aes128_ctx encrypt;
+  struct aes128_ctx decrypt;
+  size_t tag_length = ciphertext->length - cleartext->length;
+  uint8_t *data = xalloc (ciphertext->length);
+
+  aes128_set_encrypt_key (&encrypt, key->data);
+  aes128_invert_key (&decrypt, &encrypt);
+  ocb_set_key (&ocb_key, &encrypt, (nettle_cipher_func *) aes128_encrypt);
+
+  ocb_set_nonce (&ctx, &encrypt, (nettle_cipher_func *) aes128_encrypt,
+		 tag_length, nonce->length, nonce->data);
+  ocb_update (&ctx, &ocb_key, &encrypt, (nettle_cipher_func *) aes128_encrypt,
+	      authtext->length, authtext->data);
+  ocb_encrypt (&ctx, &ocb_key, &encrypt, (nettle_cipher_func *) aes128_encrypt,
+	       cleartext->length, data, cleartext->data);
+  ocb_digest (&ctx, &ocb_key, &encrypt, (nettle_cipher_func *) aes128_encrypt,
+	      tag_length, data + cleartext->length);
+  ASSERT (MEMEQ (ciphertext->length, data, ciphertext->data));
+
+  ocb_set_nonce (&ctx, &encrypt, (nettle_cipher_func *) aes128_encrypt,
+		 tag_length, nonce->length, nonce->data);
+  ocb_update (&ctx, &ocb_key, &encrypt, (nettle_cipher_func *) aes128_encrypt,
+	      authtext->length, authtext->data);
+  ocb_decrypt (&ctx, &ocb_key,
+	       &encrypt, (nettle_cipher_func *) aes128_encrypt,
+	       &decrypt, (nettle_cipher_func *) aes128_decrypt,
+	       cleartext->length, data, data);
+  ocb_digest (&ctx, &ocb_key, &encrypt, (nettle_cipher_func *) aes128_encrypt,
+	      tag_length, data + cleartext->length);
+  ASSERT (MEMEQ (cleartext->length, data, cleartext->data));
+  ASSERT (MEMEQ (tag_length, data + cleartext->length,
+		 ciphertext->data + cleartext->length));
+
+  free (data);
+}
+
+/* The iterated test of RFC 7253, Appendix A, covering tag lengths and
+   many combinations of message and associated data lengths. */
+static void
+test_ocb_iterated (size_t tag_length, const struct tstring *ref)
+{
+  struct ocb_key ocb_key;
+  struct ocb_ctx ctx;
+  struct aes128_ctx aes;
+  uint8_t key[AES128_KEY_SIZE];
+  uint8_t nonce[12];
+  uint8_t zeros[128];
+  /* Two messages of each length i < 128, and 3 * 128 tags */
+  size_t size = 127 * 128 + 3 * 128 * tag_length;
+  uint8_t *c = xalloc (size);
+  uint8_t *p;
+  uint8_t tag[OCB_DIGEST_SIZE];
+  unsigned i, j;
+
+  memset (key, 0, sizeof(key));
+  key[AES128_KEY_SIZE - 1] = tag_length * 8;
+  memset (zeros, 0, sizeof(zeros));
+  aes128_set_encrypt_key (&aes, key);
+  ocb_set_key (&ocb_key, &aes, (nettle_cipher_func *) aes128_encrypt);
+
+  memset (nonce, 0, sizeof(nonce));
+  for (i = 0, p = c; i < 128; i++)
+    for (j = 0; j < 3; j++)
+      {
+	size_t a = j == 1 ? 0 : i;
+	size_t m = j == 2 ? 0 : i;
+
+	WRITE_UINT32 (nonce + 8, 3*i + j + 1);
+	ocb_set_nonce (&ctx, &aes, (nettle_cipher_func *) aes128_encrypt,
+		       tag_length, sizeof(nonce), nonce);
+	ocb_update (&ctx, &ocb_key, &aes,
+		    (nettle_cipher_func *) aes128_encrypt, a, zeros);
+	ocb_encrypt (&ctx, &ocb_key, &aes,
+		     (nettle_cipher_func *) aes128_encrypt, m, p, zeros);
+	p += m;
+	ocb_digest (&ctx, &ocb_key, &aes,
+		    (nettle_cipher_func *) aes128_encrypt, tag_length, p);
+	p += tag_length;
+      }
+  ASSERT ((size_t) (p - c) == size);
+
+  WRITE_UINT32 (nonce + 8, 385);
+  ocb_set_nonce (&ctx, &aes, (nettle_cipher_func *) aes128_encrypt,
+		 tag_length, sizeof(nonce), nonce);
+  ocb_update (&ctx, &ocb_key, &aes,
+	      (nettle_cipher_func *) aes128_encrypt, size, c);
+  ocb_digest (&ctx, &ocb_key, &aes,
+	      (nettle_cipher_func *) aes128_encrypt, tag_length, tag);
+  ASSERT (MEMEQ (tag_length, tag, ref->data));
+
+  free (c);
+}
+
+/* Checks that processing a long message in pieces, crossing the
+   batch size and the precomputed offsets, gives the same result. */
+static void
+test_ocb_pieces (void)
+{
+  struct ocb_aes128_ctx ctx;
+  uint8_t key[AES128_KEY_SIZE];
+  uint8_t nonce[OCB_NONCE_SIZE];
+  size_t length = 300 * OCB_BLOCK_SIZE + 5;
+  uint8_t *clear = xalloc (length);
+  uint8_t *c1 = xalloc (length);
+  uint8_t *c2 = xalloc (length);
+  uint8_t tag1[OCB_DIGEST_SIZE];
+  uint8_t tag2[OCB_DIGEST_SIZE];
+  size_t i, done;
+
+  for (i = 0; i < sizeof(key); i++)
+    key[i] = i;
+  memset (nonce, 0x5a, sizeof(nonce));
+  for (i = 0; i < length; i++)
+    clear[i] = i * 7;
+
+  ocb_aes128_set_encrypt_key (&ctx, key);
+  ocb_aes128_set_nonce (&ctx, sizeof(nonce), nonce);
+  ocb_aes128_update (&ctx, length, clear);
+  ocb_aes128_encrypt (&ctx, length, c1, clear);
+  ocb_aes128_digest (&ctx, sizeof(tag1), tag1);
+
+  ocb_aes128_set_nonce (&ctx, sizeof(nonce), nonce);
+  for (done = 0, i = 1; length - done > i * OCB_BLOCK_SIZE; i += 3)
+    {
+      ocb_aes128_update (&ctx, i * OCB_BLOCK_SIZE, clear + done);
+      done += i * OCB_BLOCK_SIZE;
+    }
+  ocb_aes128_update (&ctx, length - done, clear + done);
+  for (done = 0, i = 1; length - done > i * OCB_BLOCK_SIZE; i += 5)
+    {
+      ocb_aes128_encrypt (&ctx, i * OCB_BLOCK_SIZE, c2 + done, clear + done);
+      done += i * OCB_BLOCK_SIZE;
+    }
+  ocb_aes128_encrypt (&ctx, length - done, c2 + done, clear + done);
+  ocb_aes128_digest (&ctx, sizeof(tag2), tag2);
+
+  ASSERT (MEMEQ (length, c1, c2));
+  ASSERT (MEMEQ (sizeof(tag1), tag1, tag2));
+
+  ocb_aes128_set_decrypt_key (&ctx, key);
+  ocb_aes128_set_nonce (&ctx, sizeof(nonce), nonce);
+  ocb_aes128_update (&ctx, length, clear);
+  ocb_aes128_decrypt (&ctx, length, c2, c2);
+  ocb_aes128_digest (&ctx, sizeof(tag2), tag2);
+
+  ASSERT (MEMEQ (length, c2, clear));
+  ASSERT (MEMEQ (sizeof(tag1), tag1, tag2));
+
+  free (clear);
+  free (c1);
+  free (c2);
+}
+
+void
+test_main(void)
+{
+  /* From RFC 7253, Appendix A */
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA99887766554433221100"),
+		   SHEX(""),
+		   SHEX(""),
+		   SHEX("785407BFFFC8AD9EDCC5520AC9111EE6"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA99887766554433221101"),
+		   SHEX("0001020304050607"),
+		   SHEX("0001020304050607"),
+		   SHEX("6820B3657B6F615A5725BDA0D3B4EB3A257C9AF1F8F03009"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA99887766554433221102"),
+		   SHEX("0001020304050607"),
+		   SHEX(""),
+		   SHEX("81017F8203F081277152FADE694A0A00"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA99887766554433221103"),
+		   SHEX(""),
+		   SHEX("0001020304050607"),
+		   SHEX("45DD69F8F5AAE72414054CD1F35D82760B2CD00D2F99BFA9"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA99887766554433221104"),
+		   SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("571D535B60B277188BE5147170A9A22C"
+			"3AD7A4FF3835B8C5701C1CCEC8FC3358"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA99887766554433221105"),
+		   SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX(""),
+		   SHEX("8CF761B6902EF764462AD86498CA6B97"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA99887766554433221106"),
+		   SHEX(""),
+		   SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("5CE88EC2E0692706A915C00AEB8B2396"
+			"F40E1C743F52436BDF06D8FA1ECA343D"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA99887766554433221107"),
+		   SHEX("000102030405060708090A0B0C0D0E0F1011121314151617"),
+		   SHEX("000102030405060708090A0B0C0D0E0F1011121314151617"),
+		   SHEX("1CA2207308C87C010756104D8840CE19"
+			"52F09673A448A122C92C62241051F573"
+			"56D7F3C90BB0E07F"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA99887766554433221108"),
+		   SHEX("000102030405060708090A0B0C0D0E0F1011121314151617"),
+		   SHEX(""),
+		   SHEX("6DC225A071FC1B9F7C69F93B0F1E10DE"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA99887766554433221109"),
+		   SHEX(""),
+		   SHEX("000102030405060708090A0B0C0D0E0F1011121314151617"),
+		   SHEX("221BD0DE7FA6FE993ECCD769460A0AF2"
+			"D6CDED0C395B1C3CE725F32494B9F914"
+			"D85C0B1EB38357FF"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA9988776655443322110A"),
+		   SHEX("000102030405060708090A0B0C0D0E0F"
+			"101112131415161718191A1B1C1D1E1F"),
+		   SHEX("000102030405060708090A0B0C0D0E0F"
+			"101112131415161718191A1B1C1D1E1F"),
+		   SHEX("BD6F6C496201C69296C11EFD138A467A"
+			"BD3C707924B964DEAFFC40319AF5A485"
+			"40FBBA186C5553C68AD9F592A79A4240"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA9988776655443322110B"),
+		   SHEX("000102030405060708090A0B0C0D0E0F"
+			"101112131415161718191A1B1C1D1E1F"),
+		   SHEX(""),
+		   SHEX("FE80690BEE8A485D11F32965BC9D2A32"));
+
+  test_ocb_aes128 (SHEX("000102030405060708090A0B0C0D0E0F"),
+		   SHEX("BBAA9988776655443322110C"),
+		   SHEX(""),
+		   SHEX("000102030405060708090A0B0C0D0E0F"
+			"101112131415161718191A1B1C1D1E1F"),
+		   SHEX("2942BFC773BDA23CABC6ACFD9BFD5835"
+			"BD300F0973792EF46040C53F1432BCDF"
+			"B5E1DDE3BC18A5F840B52E653444D5DF"));
+
+  /* 96-bit tag */
+  test_ocb_tag (SHEX("0F0E0D0C0B0A09080706050403020100"),
+		SHEX("BBAA9988776655443322110D"),
+		SHEX("000102030405060708090A0B0C0D0E0F"
+		     "101112131415161718191A1B1C1D1E1F"
+		     "2021222324252627"),
+		SHEX("000102030405060708090A0B0C0D0E0F"
+		     "101112131415161718191A1B1C1D1E1F"
+		     "2021222324252627"),
+		SHEX("1792A4E31E0755FB03E31B22116E6C2D"
+		     "DF9EFD6E33D536F1A0124B0A55BAE884"
+		     "ED93481529C76B6AD0C515F4D1CDD4FD"
+		     "AC4F02AA"));
+
+  test_ocb_iterated (16, SHEX("67E944D23256C5E0B6C61FA22FDF1EA2"));
+  test_ocb_iterated (12, SHEX("77A3D8E73589158D25D01209"));
+  test_ocb_iterated (8, SHEX("192C9B7BD90BA06A"));
+
+  test_ocb_pieces ();
+}
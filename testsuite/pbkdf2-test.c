@@ -110,4 +110,20 @@ test_main (void)
   PBKDF2_HMAC_TEST(pbkdf2_hmac_sha256, LDATA("passwd"), 1, LDATA("salt"),
 		   SHEX("55ac046e56e3089fec1691c22544b605"));
 
+  PBKDF2_HMAC_TEST(pbkdf2_hmac_sha1, LDATA("password"), 4096, LDATA("salt"),
+		   SHEX("4b007901b765489abead49d926f721d065a429c1"));
+
+  PBKDF2_HMAC_TEST(pbkdf2_hmac_sha1, LDATA("passwordPASSWORDpassword"), 4096,
+		   LDATA("saltSALTsaltSALTsaltSALTsaltSALTsalt"),
+		   SHEX("3d2eec4fe41c849b80c8d83662c0e44a8b291a964cf2f07038"));
+
+  /* Multi-block output, from RFC 7914. */
+  PBKDF2_HMAC_TEST(pbkdf2_hmac_sha256, LDATA("passwd"), 1, LDATA("salt"),
+		   SHEX("55ac046e56e3089fec1691c22544b605f94185216dde0465e68b9d57c20dacbc"
+			"49ca9cccf179b645991664b39d77ef317c71b845b1e30bd509112041d3a19783"));
+
+  PBKDF2_HMAC_TEST(pbkdf2_hmac_sha256, LDATA("Password"), 80000, LDATA("NaCl"),
+		   SHEX("4ddcd8f60b98be21830cee5ef22701f9641a4418d04c0414aeff08876b34ab56"
+			"a1d425a1225833549adb841b51c9b3176a272bdebba1d078478f62b397f33c8d"));
+
 }
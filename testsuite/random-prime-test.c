@@ -1,6 +1,7 @@
 #include "testutils.h"
 
 #include "knuth-lfib.h"
+#include "hogweed-internal.h"
 
 void
 test_main(void)
@@ -24,5 +25,19 @@ test_main(void)
       ASSERT (mpz_probab_prime_p(p, 25));
     }
 
+  for (bits = 21; bits < 1000; bits = bits + 1 + bits/20)
+    {
+      if (verbose)
+	fprintf(stderr, "sieve, bits = %d\n", bits);
+
+      _nettle_random_prime_sieve(p, bits, bits & 1,
+				 &lfib, (nettle_random_func *) knuth_lfib_random,
+				 NULL, NULL);
+      ASSERT (mpz_sizeinbase (p, 2) == bits);
+      if (bits & 1)
+	ASSERT (mpz_tstbit (p, bits - 2));
+      ASSERT (mpz_probab_prime_p(p, 25));
+    }
+
   mpz_clear(p);
 }
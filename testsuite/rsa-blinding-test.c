@@ -0,0 +1,155 @@
+#include "testutils.h"
+#include "knuth-lfib.h"
+
+#define MSG1 "None so blind as those who will not see"
+
+/* Number of signatures, enough to exhaust a full pool. */
+#define COUNT (RSA_BLINDING_POOL_SIZE * RSA_BLINDING_MAX_USES + 5)
+
+void
+test_main(void)
+{
+  struct rsa_public_key pub;
+  struct rsa_private_key key;
+  struct rsa_blinding_pool pool;
+  struct knuth_lfib_ctx lfib;
+  mpz_t m, x, expected;
+  mp_limb_t *scratch;
+  unsigned i;
+
+  rsa_private_key_init(&key);
+  rsa_public_key_init(&pub);
+  rsa_blinding_pool_init(&pool);
+
+  mpz_init(m);
+  mpz_init(x);
+  mpz_init(expected);
+
+  test_rsa_set_key_1(&pub, &key);
+
+  knuth_lfib_init(&lfib, 1111);
+
+  ASSERT (rsa_blinding_pool_uses(&pool) == 0);
+
+  /* An empty pool falls back to fresh blinding factors. */
+  nettle_mpz_random(m, &lfib, (nettle_random_func *) knuth_lfib_random,
+		    pub.n);
+  rsa_compute_root(&key, expected, m);
+  ASSERT (rsa_compute_root_pool(&pub, &key, &pool,
+				&lfib, (nettle_random_func *) knuth_lfib_random,
+				x, m));
+  ASSERT (mpz_cmp(x, expected) == 0);
+
+  rsa_blinding_pool_refill(&pool, &pub,
+			   &lfib, (nettle_random_func *) knuth_lfib_random);
+  ASSERT (rsa_blinding_pool_uses(&pool)
+	  == RSA_BLINDING_POOL_SIZE * RSA_BLINDING_MAX_USES);
+
+  /* Each use updates the entry by squaring, which must still give
+     correct results. Pass no randomness, so that the test fails if
+     the pool isn't used. */
+  for (i = 0; i < RSA_BLINDING_POOL_SIZE * RSA_BLINDING_MAX_USES; i++)
+    {
+      nettle_mpz_random(m, &lfib, (nettle_random_func *) knuth_lfib_random,
+			pub.n);
+      rsa_compute_root(&key, expected, m);
+      ASSERT (rsa_compute_root_pool(&pub, &key, &pool, NULL, NULL, x, m));
+      if (mpz_cmp(x, expected) != 0)
+	{
+	  fprintf(stderr, "rsa_compute_root_pool failed, i = %u\n", i);
+	  abort();
+	}
+    }
+  ASSERT (rsa_blinding_pool_uses(&pool) == 0);
+
+  /* Refilling an entry, and signing. */
+  rsa_blinding_pool_refill(&pool, &pub,
+			   &lfib, (nettle_random_func *) knuth_lfib_random);
+  ASSERT (rsa_pkcs1_sign(&key, LDATA(MSG1), expected));
+
+  scratch = xalloc_limbs (rsa_sec_itch (&pub, &key));
+  for (i = 0; i < COUNT; i++)
+    {
+      mpz_set_ui(x, 17);
+      ASSERT (rsa_pkcs1_sign_pool_scratch(&pub, &key, &pool,
+					  &lfib, (nettle_random_func *) knuth_lfib_random,
+					  LDATA(MSG1), x, scratch));
+      ASSERT (mpz_cmp(x, expected) == 0);
+    }
+  ASSERT (rsa_blinding_pool_uses(&pool) == 0);
+  free (scratch);
+
+  rsa_blinding_pool_refill(&pool, &pub,
+			   &lfib, (nettle_random_func *) knuth_lfib_random);
+  ASSERT (rsa_pkcs1_sign_pool(&pub, &key, &pool, NULL, NULL,
+			      LDATA(MSG1), x));
+  ASSERT (mpz_cmp(x, expected) == 0);
+  ASSERT (rsa_pkcs1_verify(&pub, LDATA(MSG1), x));
+
+  /* A pool filled for another key, of the same size or larger, is
+     not used. Refilling it for a new key discards the old
+     entries. */
+  for (i = 0; i < 2; i++)
+    {
+      struct rsa_public_key pub2;
+      struct rsa_private_key key2;
+      unsigned uses;
+
+      rsa_public_key_init(&pub2);
+      rsa_private_key_init(&key2);
+      mpz_set_ui(pub2.e, 65537);
+      ASSERT (rsa_generate_keypair(&pub2, &key2,
+				   &lfib, (nettle_random_func *) knuth_lfib_random,
+				   NULL, NULL,
+				   mpz_sizeinbase(pub.n, 2) + 64 * i, 0));
+
+      rsa_blinding_pool_refill(&pool, &pub2,
+			       &lfib, (nettle_random_func *) knuth_lfib_random);
+      uses = rsa_blinding_pool_uses(&pool);
+      ASSERT (uses == RSA_BLINDING_POOL_SIZE * RSA_BLINDING_MAX_USES);
+
+      ASSERT (rsa_pkcs1_sign_pool(&pub, &key, &pool,
+				  &lfib, (nettle_random_func *) knuth_lfib_random,
+				  LDATA(MSG1), x));
+      ASSERT (mpz_cmp(x, expected) == 0);
+
+      scratch = xalloc_limbs (rsa_sec_itch (&pub, &key));
+      mpz_set_ui(x, 17);
+      ASSERT (rsa_pkcs1_sign_pool_scratch(&pub, &key, &pool,
+					  &lfib, (nettle_random_func *) knuth_lfib_random,
+					  LDATA(MSG1), x, scratch));
+      ASSERT (mpz_cmp(x, expected) == 0);
+      free (scratch);
+      ASSERT (rsa_blinding_pool_uses(&pool) == uses);
+
+      /* Use up one entry for the new key, then refill for the old
+	 key, which must replace all entries. */
+      ASSERT (rsa_pkcs1_sign_pool(&pub2, &key2, &pool, NULL, NULL,
+				  LDATA(MSG1), x));
+      ASSERT (rsa_pkcs1_verify(&pub2, LDATA(MSG1), x));
+      ASSERT (rsa_blinding_pool_uses(&pool) == uses - 1);
+
+      rsa_blinding_pool_refill(&pool, &pub,
+			       &lfib, (nettle_random_func *) knuth_lfib_random);
+      ASSERT (rsa_blinding_pool_uses(&pool) == uses);
+      ASSERT (rsa_pkcs1_sign_pool(&pub, &key, &pool, NULL, NULL,
+				  LDATA(MSG1), x));
+      ASSERT (mpz_cmp(x, expected) == 0);
+
+      rsa_public_key_clear(&pub2);
+      rsa_private_key_clear(&key2);
+    }
+
+  /* Bad private key is detected, also with the pool. */
+  mpz_add_ui(key.p, key.p, 2);
+  ASSERT (!rsa_pkcs1_sign_pool(&pub, &key, &pool, NULL, NULL,
+			       LDATA(MSG1), x));
+  mpz_sub_ui(key.p, key.p, 2);
+
+  rsa_blinding_pool_clear(&pool);
+  rsa_private_key_clear(&key);
+  rsa_public_key_clear(&pub);
+  mpz_clear(m);
+  mpz_clear(x);
+  mpz_clear(expected);
+}
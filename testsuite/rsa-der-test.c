@@ -0,0 +1,126 @@
+#include "testutils.h"
+#include "asn1.h"
+
+#define LIMB_BITS (8 * sizeof(mp_limb_t))
+
+static mp_size_t
+load_key(struct rsa_public_key *pub, unsigned limit,
+	 mp_size_t limbs_size, mp_limb_t *limbs,
+	 const struct tstring *der)
+{
+  struct asn1_der_iterator i;
+
+  ASSERT(asn1_der_iterator_first(&i, der->length, der->data)
+	 == ASN1_ITERATOR_CONSTRUCTED);
+  return rsa_public_key_from_der_limbs(pub, limit, limbs_size, limbs, &i);
+}
+
+void
+test_main(void)
+{
+  /* The public key used in pkcs1-conv-test. */
+  const struct tstring *key1
+    = SHEX("30818902818100b7efdd9b06043f99cf1a60e15a2c42444bf262a6"
+	   "62c07958339e86ff56bcef75cc7e6e5e8bea04e985cb54f53a0e2c"
+	   "2d38f5d6585b70c9e77a305266d082a074bef2d38ccf65192130e2"
+	   "85cbae9ef1fd7568fdf64c51c456ab91fc67497a2803571f071572"
+	   "c8e3a8f049e960ff22cde8f6b6f9f0653d19972c30ed99a21f33eb"
+	   "0203010001");
+  const struct tstring *key2
+    = SHEX("3012020d00c5a3e1f0d2b4968778695a4b020103");
+  struct rsa_public_key ref;
+  struct rsa_public_key pub;
+  struct rsa_public_key keys[3];
+  mp_limb_t limbs[100];
+  uint8_t bundle[400];
+  size_t bundle_length;
+  size_t nkeys;
+  size_t length;
+  mp_size_t limbs_size;
+  mp_size_t used;
+  mp_size_t used2;
+
+  rsa_public_key_init(&ref);
+  ASSERT(rsa_keypair_from_der(&ref, NULL, 0, key1->length, key1->data));
+
+  used = load_key(&pub, 0, RSA_PUBLIC_KEY_DER_LIMBS(key1->length),
+		  limbs, key1);
+  ASSERT(used == (1024 + LIMB_BITS - 1) / LIMB_BITS + 1);
+  ASSERT(mpz_cmp(pub.n, ref.n) == 0);
+  ASSERT(mpz_cmp(pub.e, ref.e) == 0);
+  ASSERT(pub.size == ref.size);
+
+  ASSERT(!load_key(&pub, 0, used - 1, limbs, key1));
+  ASSERT(!load_key(&pub, 1023, used, limbs, key1));
+  ASSERT(load_key(&pub, 1024, used, limbs, key1) == used);
+
+  used2 = load_key(&pub, 0, 10, limbs, key2);
+  ASSERT(used2 == (96 + LIMB_BITS - 1) / LIMB_BITS + 1);
+  ASSERT(mpz_cmp_ui(pub.e, 3) == 0);
+  ASSERT(pub.size == 12);
+
+  /* Negative exponent */
+  ASSERT(!load_key(&pub, 0, 10, limbs,
+		   SHEX("3012020d00c5a3e1f0d2b4968778695a4b0201fd")));
+  /* Non-minimal exponent */
+  ASSERT(!load_key(&pub, 0, 10, limbs,
+		   SHEX("3013020d00c5a3e1f0d2b4968778695a4b02020003")));
+  /* Even modulus */
+  ASSERT(!load_key(&pub, 0, 10, limbs,
+		   SHEX("3012020d00c5a3e1f0d2b4968778695a4a020103")));
+  /* Trailing data */
+  ASSERT(!load_key(&pub, 0, 10, limbs,
+		   SHEX("3014020d00c5a3e1f0d2b4968778695a4b0201030500")));
+
+  /* A bundle of four keys. */
+  bundle_length = 0;
+  memcpy(bundle + bundle_length, key1->data, key1->length);
+  bundle_length += key1->length;
+  memcpy(bundle + bundle_length, key2->data, key2->length);
+  bundle_length += key2->length;
+  memcpy(bundle + bundle_length, key1->data, key1->length);
+  bundle_length += key1->length;
+  memcpy(bundle + bundle_length, key2->data, key2->length);
+  bundle_length += key2->length;
+
+  nkeys = 3;
+  limbs_size = 100;
+  length = bundle_length;
+  ASSERT(rsa_public_keys_from_der(&nkeys, keys, &limbs_size, limbs, 0,
+				  &length, bundle));
+  ASSERT(nkeys == 3);
+  ASSERT(length == 2 * key1->length + key2->length);
+  ASSERT(limbs_size == 2 * used + used2);
+  ASSERT(mpz_cmp(keys[0].n, ref.n) == 0);
+  ASSERT(mpz_cmp_ui(keys[1].e, 3) == 0);
+  ASSERT(mpz_cmp(keys[2].n, ref.n) == 0);
+  ASSERT(mpz_cmp(keys[2].e, ref.e) == 0);
+
+  /* Continue with the rest. */
+  nkeys = 3;
+  limbs_size = 100;
+  length = bundle_length - length;
+  ASSERT(rsa_public_keys_from_der(&nkeys, keys, &limbs_size, limbs, 0,
+				  &length, bundle + bundle_length - length));
+  ASSERT(nkeys == 1 && length == key2->length
+	 && limbs_size == used2);
+
+  /* Stops when the limbs are full. */
+  nkeys = 3;
+  limbs_size = RSA_PUBLIC_KEY_DER_LIMBS(key1->length - 3);
+  length = bundle_length;
+  ASSERT(rsa_public_keys_from_der(&nkeys, keys, &limbs_size, limbs, 0,
+				  &length, bundle));
+  ASSERT(nkeys == 1 && length == key1->length && limbs_size == used);
+
+  /* Fails at an invalid object, after loading the preceding keys. */
+  memcpy(bundle + key1->length + key2->length, "\x05\x00", 2);
+  nkeys = 3;
+  limbs_size = 100;
+  length = key1->length + key2->length + 2;
+  ASSERT(!rsa_public_keys_from_der(&nkeys, keys, &limbs_size, limbs, 0,
+				   &length, bundle));
+  ASSERT(nkeys == 2 && length == key1->length + key2->length);
+
+  rsa_public_key_clear(&ref);
+}
@@ -17,6 +17,7 @@ test_main(void)
   uint8_t *decrypted;
   size_t decrypted_length;
   uint8_t after;
+  mp_limb_t *scratch;
 
   mpz_t gibberish;
 
@@ -78,6 +79,30 @@ test_main(void)
   ASSERT(MEMEQ(msg_length, msg, decrypted));
   ASSERT(decrypted[msg_length] == after);
 
+  /* test variant with caller supplied scratch space */
+  scratch = xalloc_limbs (rsa_sec_itch (&pub, &key));
+
+  knuth_lfib_random (&lfib, msg_length + 1, decrypted);
+  after = decrypted[msg_length];
+
+  decrypted_length = msg_length;
+  ASSERT(rsa_decrypt_tr_scratch(&pub, &key,
+				&lfib, (nettle_random_func *) knuth_lfib_random,
+				&decrypted_length, decrypted, gibberish,
+				scratch));
+  ASSERT(decrypted_length == msg_length);
+  ASSERT(MEMEQ(msg_length, msg, decrypted));
+  ASSERT(decrypted[msg_length] == after);
+
+  knuth_lfib_random (&lfib, msg_length + 1, decrypted);
+  after = decrypted[msg_length];
+
+  ASSERT(rsa_sec_decrypt_scratch(&pub, &key,
+				 &lfib, (nettle_random_func *) knuth_lfib_random,
+				 msg_length, decrypted, gibberish, scratch));
+  ASSERT(MEMEQ(msg_length, msg, decrypted));
+  ASSERT(decrypted[msg_length] == after);
+
   /* test side channel resistant variant */
   knuth_lfib_random (&lfib, msg_length + 1, decrypted);
   after = decrypted[msg_length];
@@ -113,5 +138,6 @@ test_main(void)
   rsa_public_key_clear(&pub);
   mpz_clear(gibberish);
   free(decrypted);
+  free(scratch);
 }
   
@@ -17,8 +17,10 @@ test_main(void)
   struct knuth_lfib_ctx lfib;
 
   mpz_t expected;
+  mpz_t n, d, c, e;
   
   mpz_init(expected);
+  mpz_init(e);
   
   rsa_private_key_init(&key);
   rsa_public_key_init(&pub);
@@ -70,8 +72,64 @@ test_main(void)
 	      "fd040793c487588d" "6218" , 16);
 
   test_rsa_sha1(&pub, &key, expected);
+
+  /* Sieved generation, 1024 bit key with random e */
+  knuth_lfib_init(&lfib, 13);
+
+  ASSERT (rsa_generate_keypair_sieve(&pub, &key,
+				     &lfib,
+				     (nettle_random_func *) knuth_lfib_random,
+				     NULL, verbose ? progress : NULL,
+				     1024, 50));
+  test_rsa_key(&pub, &key);
+  ASSERT (mpz_probab_prime_p(key.p, 25));
+  ASSERT (mpz_probab_prime_p(key.q, 25));
+
+  /* 2001 bit key with fixed e, with p and q generated separately */
+  knuth_lfib_init(&lfib, 17);
+
+  mpz_set_ui(pub.e, 65537);
+  rsa_generate_prime(key.p, 1001, pub.e,
+		     &lfib, (nettle_random_func *) knuth_lfib_random,
+		     NULL, verbose ? progress : NULL);
+  rsa_generate_prime(key.q, 1000, pub.e,
+		     &lfib, (nettle_random_func *) knuth_lfib_random,
+		     NULL, verbose ? progress : NULL);
+  ASSERT (rsa_keypair_from_primes(&pub, &key, NULL, NULL, NULL, NULL,
+				  2001, 0));
+  test_rsa_key(&pub, &key);
+  ASSERT (mpz_probab_prime_p(key.p, 25));
+  ASSERT (mpz_probab_prime_p(key.q, 25));
+
+  /* Wrong size, a non-invertible e, and equal primes, must be
+     rejected, leaving the keys unmodified. */
+  mpz_init_set(n, pub.n);
+  mpz_init_set(d, key.d);
+  mpz_init_set(c, key.c);
+  ASSERT (!rsa_keypair_from_primes(&pub, &key, NULL, NULL, NULL, NULL,
+				   2000, 0));
+  ASSERT (mpz_cmp(pub.n, n) == 0 && mpz_cmp(key.c, c) == 0);
+
+  /* An odd factor of p-1. */
+  mpz_sub_ui(e, key.p, 1);
+  mpz_tdiv_q_2exp(e, e, mpz_scan1(e, 0));
+  mpz_swap(pub.e, e);
+  ASSERT (!rsa_keypair_from_primes(&pub, &key, NULL, NULL, NULL, NULL,
+				   2001, 0));
+  ASSERT (mpz_cmp(pub.n, n) == 0 && mpz_cmp(key.c, c) == 0
+	  && mpz_cmp(key.d, d) == 0);
+  mpz_swap(pub.e, e);
+
+  mpz_set(key.q, key.p);
+  ASSERT (!rsa_keypair_from_primes(&pub, &key, NULL, NULL, NULL, NULL,
+				   2002, 0));
+  ASSERT (mpz_cmp(pub.n, n) == 0 && mpz_cmp(key.c, c) == 0);
   
   rsa_private_key_clear(&key);
   rsa_public_key_clear(&pub);
   mpz_clear(expected);
+  mpz_clear(n);
+  mpz_clear(d);
+  mpz_clear(c);
+  mpz_clear(e);
 }
@@ -4,6 +4,42 @@
 #define MSG1 "None so blind as those who will not see"
 #define MSG2 "Fortune knocks once at every man's door"
 
+/* Counts allocations done via gmp's memory functions, which is where
+   TMP_GMP_ALLOC and mpz reallocations end up. */
+static unsigned alloc_count;
+
+static void *(*orig_alloc) (size_t);
+static void *(*orig_realloc) (void *, size_t, size_t);
+static void (*orig_free) (void *, size_t);
+
+static void *
+count_alloc (size_t n)
+{
+  alloc_count++;
+  return orig_alloc (n);
+}
+
+static void *
+count_realloc (void *p, size_t old_size, size_t new_size)
+{
+  alloc_count++;
+  return orig_realloc (p, old_size, new_size);
+}
+
+static void
+start_counting (void)
+{
+  mp_get_memory_functions (&orig_alloc, &orig_realloc, &orig_free);
+  mp_set_memory_functions (count_alloc, count_realloc, orig_free);
+  alloc_count = 0;
+}
+
+static void
+stop_counting (void)
+{
+  mp_set_memory_functions (orig_alloc, orig_realloc, orig_free);
+}
+
 static void
 test_rsa_sign_tr(struct rsa_public_key *pub,
 	     struct rsa_private_key *key,
@@ -13,6 +49,7 @@ test_rsa_sign_tr(struct rsa_public_key *pub,
 {
   mpz_t signature;
   struct knuth_lfib_ctx lfib;
+  mp_limb_t *scratch;
 
   knuth_lfib_init(&lfib, 1111);
 
@@ -45,6 +82,42 @@ test_rsa_sign_tr(struct rsa_public_key *pub,
 
   ASSERT (mpz_cmp(signature, expected) == 0);
 
+  /* Try the variant with caller supplied scratch space */
+  scratch = xalloc_limbs (rsa_sec_itch (pub, key));
+
+  mpz_set_ui (signature, 17);
+  mpz_add_ui(key->p, key->p, 2);
+
+  ASSERT(!rsa_pkcs1_sign_tr_scratch(pub, key,
+				    &lfib, (nettle_random_func *) knuth_lfib_random,
+				    di_length, di, signature, scratch));
+
+  mpz_sub_ui(key->p, key->p, 2);
+
+  ASSERT(!mpz_cmp_ui(signature, 17));
+
+  start_counting ();
+  ASSERT(rsa_pkcs1_sign_tr_scratch(pub, key,
+				   &lfib, (nettle_random_func *) knuth_lfib_random,
+				   di_length, di, signature, scratch));
+  stop_counting ();
+
+  ASSERT (mpz_cmp(signature, expected) == 0);
+
+  /* Now that signature is large enough, no further allocations are
+     needed. */
+  start_counting ();
+  ASSERT(rsa_pkcs1_sign_tr_scratch(pub, key,
+				   &lfib, (nettle_random_func *) knuth_lfib_random,
+				   di_length, di, signature, scratch));
+  stop_counting ();
+
+  ASSERT (mpz_cmp(signature, expected) == 0);
+#if !NETTLE_USE_MINI_GMP
+  ASSERT (alloc_count == 0);
+#endif
+  free (scratch);
+
   /* Try bad data */
   ASSERT (!rsa_pkcs1_verify(pub, 16, (void*)"The magick words", signature));
 
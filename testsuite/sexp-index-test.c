@@ -0,0 +1,183 @@
+#include "testutils.h"
+#include "sexp.h"
+#include "buffer.h"
+#include "realloc.h"
+
+static int
+same_position(const struct sexp_iterator *a, const struct sexp_iterator *b)
+{
+  return a->type == b->type && a->start == b->start
+    && a->pos == b->pos && a->level == b->level;
+}
+
+/* Walks the expression with both iterators, entering every list,
+   and skipping every list a second time from its start. */
+static void
+test_walk(const struct sexp_index *index, size_t length, const uint8_t *data)
+{
+  struct sexp_iterator i, j;
+
+  ASSERT(sexp_iterator_first(&i, length, data));
+  ASSERT(sexp_iterator_first(&j, length, data));
+
+  for (;;)
+    {
+      ASSERT(same_position(&i, &j));
+      switch (i.type)
+	{
+	case SEXP_LIST:
+	  {
+	    struct sexp_iterator k = i;
+	    struct sexp_iterator l = i;
+	    ASSERT(sexp_iterator_next(&k));
+	    ASSERT(sexp_index_next(index, &l));
+	    ASSERT(same_position(&k, &l));
+	  }
+	  ASSERT(sexp_iterator_enter_list(&i));
+	  ASSERT(sexp_iterator_enter_list(&j));
+	  if (i.type != SEXP_END)
+	    {
+	      struct sexp_iterator k = i;
+	      struct sexp_iterator l = i;
+	      ASSERT(sexp_iterator_exit_list(&k));
+	      ASSERT(sexp_index_exit_list(index, &l));
+	      ASSERT(same_position(&k, &l));
+	    }
+	  break;
+	case SEXP_ATOM:
+	  ASSERT(sexp_iterator_next(&i));
+	  ASSERT(sexp_index_next(index, &j));
+	  break;
+	case SEXP_END:
+	  if (!i.level)
+	    return;
+	  ASSERT(sexp_iterator_exit_list(&i));
+	  ASSERT(sexp_index_exit_list(index, &j));
+	  break;
+	}
+    }
+}
+
+void
+test_main(void)
+{
+  static const char * const keys[2] = { "n", "e" };
+  struct sexp_index index;
+  struct sexp_iterator i;
+  struct sexp_iterator v[2];
+  const uint8_t *p;
+  size_t length;
+
+  sexp_index_init(&index, NULL, nettle_realloc);
+
+  ASSERT(sexp_index_build(&index, LDATA("")));
+  ASSERT(index.nnodes == 0);
+
+  ASSERT(!sexp_index_build(&index, LDATA("(")));
+  ASSERT(!sexp_index_build(&index, LDATA("(3:fo)")));
+  ASSERT(!sexp_index_build(&index, LDATA(")")));
+
+  ASSERT(sexp_index_build(&index, LDATA("3:foo[3:bar]1:x()")));
+  ASSERT(index.nnodes == 3 && index.nkeys == 0);
+  ASSERT(index.nodes[1].start == 5 && index.nodes[1].end == 15);
+  ASSERT(index.nodes[2].start == 15 && index.nodes[2].end == 17);
+
+  {
+    static const char data[]
+      = "(7:private(3:rsa(1:n2:xx3:foo)[1:d]1:v(1:y)"
+      "(1:e(1:a)(1:b3:bar))())(1:z(1:n)))";
+    size_t data_length = sizeof(data) - 1;
+
+    ASSERT(sexp_index_build(&index, data_length, (const uint8_t *) data));
+    ASSERT(index.nkeys == 9);
+    test_walk(&index, data_length, (const uint8_t *) data);
+
+    /* Skip the rsa list, and get its text. */
+    ASSERT(sexp_iterator_first(&i, data_length, (const uint8_t *) data));
+    ASSERT(sexp_iterator_check_type(&i, "private"));
+    ASSERT(i.type == SEXP_LIST);
+    p = sexp_index_subexpr(&index, &i, &length);
+    ASSERT(p && length == 56 && p[0] == '(' && p[length-1] == ')');
+    ASSERT(i.type == SEXP_LIST && i.start == 66);
+
+    ASSERT(sexp_iterator_first(&i, data_length, (const uint8_t *) data));
+    ASSERT(sexp_iterator_check_type(&i, "private"));
+    ASSERT(sexp_iterator_check_type(&i, "rsa"));
+    ASSERT(sexp_index_assoc(&index, &i, 2, keys, v));
+
+    ASSERT(v[0].type == SEXP_ATOM
+	   && !v[0].display_length && !v[0].display
+	   && v[0].atom_length == 2 && MEMEQ(2, "xx", v[0].atom)
+
+	   && sexp_index_next(&index, &v[0]) && v[0].type == SEXP_ATOM
+	   && v[0].atom_length == 3 && MEMEQ(3, "foo", v[0].atom)
+
+	   && sexp_index_next(&index, &v[0]) && v[0].type == SEXP_END);
+
+    ASSERT(v[1].type == SEXP_LIST && v[1].level == 3
+	   && sexp_index_next(&index, &v[1]) && v[1].type == SEXP_LIST
+	   && sexp_index_next(&index, &v[1]) && v[1].type == SEXP_END);
+
+    /* Assoc exits the rsa list. */
+    ASSERT(i.type == SEXP_LIST && i.level == 1
+	   && sexp_iterator_check_type(&i, "z"));
+
+    /* Keys before the current element are not considered. */
+    ASSERT(sexp_iterator_first(&i, data_length, (const uint8_t *) data));
+    ASSERT(sexp_iterator_check_type(&i, "private"));
+    ASSERT(sexp_iterator_check_type(&i, "rsa"));
+    ASSERT(sexp_index_next(&index, &i));
+    ASSERT(!sexp_index_assoc(&index, &i, 2, keys, v));
+
+    /* Key asked for twice */
+    {
+      static const char * const twice[2] = { "e", "e" };
+      ASSERT(sexp_iterator_first(&i, data_length, (const uint8_t *) data));
+      ASSERT(sexp_iterator_check_type(&i, "private"));
+      ASSERT(sexp_iterator_check_type(&i, "rsa"));
+      ASSERT(!sexp_index_assoc(&index, &i, 2, twice, v));
+    }
+  }
+
+  {
+    static const char data[] = "((1:n)(1:n3:foo)(1:e))";
+    ASSERT(sexp_index_build(&index, sizeof(data) - 1,
+			    (const uint8_t *) data));
+    ASSERT(sexp_iterator_first(&i, sizeof(data) - 1,
+			       (const uint8_t *) data));
+    ASSERT(sexp_iterator_enter_list(&i));
+    ASSERT(!sexp_index_assoc(&index, &i, 2, keys, v));
+
+    ASSERT(sexp_iterator_first(&i, sizeof(data) - 1,
+			       (const uint8_t *) data));
+    ASSERT(sexp_iterator_enter_list(&i));
+    ASSERT(sexp_index_next(&index, &i));
+    ASSERT(sexp_index_assoc(&index, &i, 2, keys, v));
+    ASSERT(v[0].type == SEXP_ATOM && MEMEQ(3, "foo", v[0].atom));
+    ASSERT(v[1].type == SEXP_END);
+    ASSERT(i.type == SEXP_END && i.level == 0);
+  }
+
+  /* A deep and wide expression. */
+  {
+    struct nettle_buffer buffer;
+    unsigned k;
+
+    nettle_buffer_init(&buffer);
+    for (k = 0; k < 100; k++)
+      ASSERT(sexp_format(&buffer, "%((k%i)", k));
+    for (k = 0; k < 1000; k++)
+      ASSERT(sexp_format(&buffer, "(%i%0t%0s(%i))",
+			   k, "t", "x", k));
+    for (k = 0; k < 100; k++)
+      ASSERT(sexp_format(&buffer, "%)"));
+
+    ASSERT(sexp_index_build(&index, buffer.size, buffer.contents));
+    ASSERT(index.nnodes == 100 * 4 + 1000 * 5);
+    test_walk(&index, buffer.size, buffer.contents);
+
+    nettle_buffer_clear(&buffer);
+  }
+
+  sexp_index_clear(&index);
+}
@@ -1,6 +1,51 @@
 #include "testutils.h"
 #include "sexp.h"
 
+#include "buffer.h"
+
+/* Decodes the input in pieces of the given size. Returns the length
+   of the output, or -1 on failure. */
+static long
+transport_decode(size_t chunk, size_t length, const uint8_t *input,
+		 uint8_t *output)
+{
+  struct sexp_transport_decode_ctx ctx;
+  size_t in, out;
+
+  sexp_transport_decode_init(&ctx);
+  for (in = out = 0; in < length; )
+    {
+      size_t n = length - in < chunk ? length - in : chunk;
+      size_t done;
+      if (!sexp_transport_decode_update(&ctx, &done, output + out,
+					n, input + in))
+	return -1;
+      ASSERT(done <= SEXP_TRANSPORT_DECODE_LENGTH(n));
+      in += n;
+      out += done;
+    }
+  return sexp_transport_decode_final(&ctx) ? (long) out : -1;
+}
+
+static size_t
+transport_encode(size_t chunk, size_t length, const uint8_t *input,
+		 uint8_t *output)
+{
+  struct sexp_transport_encode_ctx ctx;
+  size_t in, out;
+
+  sexp_transport_encode_init(&ctx);
+  for (in = out = 0; in < length; in += chunk)
+    {
+      size_t n = length - in < chunk ? length - in : chunk;
+      size_t done = sexp_transport_encode_update(&ctx, output + out,
+						 n, input + in);
+      ASSERT(done <= SEXP_TRANSPORT_ENCODE_LENGTH(n));
+      out += done;
+    }
+  return out + sexp_transport_encode_final(&ctx, output + out);
+}
+
 void
 test_main(void)
 {
@@ -69,6 +114,67 @@ test_main(void)
 	 && sexp_iterator_next(&i) && i.type == SEXP_END);
 
   }
+  {
+    static const uint8_t transport[]
+      = "; comment\n {Mzpmb28=}\t{MDo=}\n"
+      "{WzM6Ym\nFyXTEyOnh4eHh4eHh4eHh4eA==}1:y";
+    static const uint8_t canonical[] = "3:foo0:[3:bar]12:xxxxxxxxxxxx1:y";
+    uint8_t out[sizeof(transport)];
+    size_t chunk;
+
+    /* Incremental decoding, split at every possible place. */
+    for (chunk = 1; chunk <= sizeof(transport); chunk++)
+      {
+	long length = transport_decode(chunk, sizeof(transport) - 1,
+				       transport, out);
+	ASSERT(length == sizeof(canonical) - 1);
+	ASSERT(MEMEQ(length, canonical, out));
+      }
+
+    ASSERT(transport_decode(3, LDATA("{Mzpmb28="), out) < 0);
+    ASSERT(transport_decode(3, LDATA("{Mzpm*b28=}"), out) < 0);
+    ASSERT(transport_decode(3, LDATA("{Mzpmb2}"), out) < 0);
+    ASSERT(transport_decode(3, LDATA("  ; only a comment"), out) == 0);
+
+    /* In place, with canonical data after the transport encoding. */
+    {
+      struct tstring *s = tstring_data(sizeof(transport) - 1, transport);
+      ASSERT(sexp_transport_iterator_first (&i, s->length, s->data));
+      ASSERT(i.type == SEXP_ATOM
+	     && i.atom_length == 3 && MEMEQ(3, "foo", i.atom)
+	     && sexp_iterator_next(&i) && sexp_iterator_next(&i)
+	     && sexp_iterator_next(&i) && i.type == SEXP_ATOM
+	     && i.atom_length == 1 && MEMEQ(1, "y", i.atom)
+	     && sexp_iterator_next(&i) && i.type == SEXP_END);
+    }
+  }
+  {
+    static const uint8_t canonical[] = "(3:foo(1:a1:b)4:\xff\x00\x10\x80)";
+    struct nettle_buffer buffer;
+    uint8_t encoded[SEXP_TRANSPORT_ENCODE_LENGTH(sizeof(canonical))
+		    + SEXP_TRANSPORT_ENCODE_FINAL_LENGTH];
+    uint8_t decoded[sizeof(encoded)];
+    size_t chunk;
+
+    nettle_buffer_init(&buffer);
+    ASSERT(sexp_transport_format(&buffer, "(foo(a b)%s)",
+				 (size_t) 4, "\xff\x00\x10\x80"));
+
+    for (chunk = 1; chunk <= sizeof(canonical); chunk++)
+      {
+	size_t length = transport_encode(chunk, sizeof(canonical) - 1,
+					 canonical, encoded);
+	ASSERT(length == buffer.size);
+	ASSERT(MEMEQ(length, buffer.contents, encoded));
+	ASSERT(transport_decode(chunk, length, encoded, decoded)
+	       == sizeof(canonical) - 1);
+	ASSERT(MEMEQ(sizeof(canonical) - 1, canonical, decoded));
+      }
+    ASSERT(transport_encode(1, 0, NULL, encoded) == 2
+	   && MEMEQ(2, "{}", encoded));
+
+    nettle_buffer_clear(&buffer);
+  }
   {
     static const char * const keys[2] = { "n", "e" };
     struct sexp_iterator v[2];
@@ -0,0 +1,141 @@
+#include "testutils.h"
+#include "nettle-internal.h"
+#include "siv-gcm.h"
+
+/* The ciphertext includes the tag, as in RFC 8452. */
+static void
+test_aead_message (const struct nettle_aead_message *aead,
+		   const struct tstring *key,
+		   const struct tstring *nonce,
+		   const struct tstring *adata,
+		   const struct tstring *message,
+		   const struct tstring *ciphertext)
+{
+  void *ctx = xalloc (aead->context_size);
+  uint8_t *buffer = xalloc (ciphertext->length + 1);
+
+  ASSERT (key->length == aead->key_size);
+  ASSERT (nonce->length == aead->nonce_size);
+  ASSERT (ciphertext->length == message->length + aead->digest_size);
+
+  aead->set_encrypt_key (ctx, key->data);
+  buffer[ciphertext->length] = 17;
+  aead->encrypt (ctx, nonce->length, nonce->data,
+		 adata->length, adata->data,
+		 ciphertext->length, buffer, message->data);
+  ASSERT (MEMEQ (ciphertext->length, buffer, ciphertext->data));
+  ASSERT (buffer[ciphertext->length] == 17);
+
+  aead->set_decrypt_key (ctx, key->data);
+  buffer[message->length] = 17;
+  ASSERT (aead->decrypt (ctx, nonce->length, nonce->data,
+			 adata->length, adata->data,
+			 message->length, buffer, ciphertext->data));
+  ASSERT (MEMEQ (message->length, buffer, message->data));
+  ASSERT (buffer[message->length] == 17);
+
+  /* In-place operation */
+  memcpy (buffer, message->data, message->length);
+  aead->encrypt (ctx, nonce->length, nonce->data,
+		 adata->length, adata->data,
+		 ciphertext->length, buffer, buffer);
+  ASSERT (MEMEQ (ciphertext->length, buffer, ciphertext->data));
+  ASSERT (aead->decrypt (ctx, nonce->length, nonce->data,
+			 adata->length, adata->data,
+			 message->length, buffer, buffer));
+  ASSERT (MEMEQ (message->length, buffer, message->data));
+
+  /* Invalid tag */
+  memcpy (buffer, ciphertext->data, ciphertext->length);
+  buffer[ciphertext->length - 1] ^= 1;
+  ASSERT (!aead->decrypt (ctx, nonce->length, nonce->data,
+			  adata->length, adata->data,
+			  message->length, buffer, buffer));
+
+  free (ctx);
+  free (buffer);
+}
+
+void
+test_main(void)
+{
+  /* From RFC 8452, Appendix C.1 */
+  test_aead_message (&nettle_siv_gcm_aes128,
+		     SHEX("01000000000000000000000000000000"),
+		     SHEX("030000000000000000000000"),
+		     SHEX(""),
+		     SHEX(""),
+		     SHEX("dc20e2d83f25705bb49e439eca56de25"));
+
+  test_aead_message (&nettle_siv_gcm_aes128,
+		     SHEX("01000000000000000000000000000000"),
+		     SHEX("030000000000000000000000"),
+		     SHEX(""),
+		     SHEX("0100000000000000"),
+		     SHEX("b5d839330ac7b786578782fff6013b81"
+			  "5b287c22493a364c"));
+
+  test_aead_message (&nettle_siv_gcm_aes128,
+		     SHEX("01000000000000000000000000000000"),
+		     SHEX("030000000000000000000000"),
+		     SHEX(""),
+		     SHEX("010000000000000000000000"),
+		     SHEX("7323ea61d05932260047d942a4978db3"
+			  "57391a0bc4fdec8b0d106639"));
+
+  test_aead_message (&nettle_siv_gcm_aes128,
+		     SHEX("01000000000000000000000000000000"),
+		     SHEX("030000000000000000000000"),
+		     SHEX(""),
+		     SHEX("01000000000000000000000000000000"),
+		     SHEX("743f7c8077ab25f8624e2e948579cf77"
+			  "303aaf90f6fe21199c6068577437a0c4"));
+
+  test_aead_message (&nettle_siv_gcm_aes128,
+		     SHEX("01000000000000000000000000000000"),
+		     SHEX("030000000000000000000000"),
+		     SHEX(""),
+		     SHEX("01000000000000000000000000000000"
+			  "02000000000000000000000000000000"),
+		     SHEX("84e07e62ba83a6585417245d7ec413a9"
+			  "fe427d6315c09b57ce45f2e3936a9445"
+			  "1a8e45dcd4578c667cd86847bf6155ff"));
+
+  test_aead_message (&nettle_siv_gcm_aes128,
+		     SHEX("01000000000000000000000000000000"),
+		     SHEX("030000000000000000000000"),
+		     SHEX("01"),
+		     SHEX("0200000000000000"),
+		     SHEX("1e6daba35669f4273b0a1a2560969cdf"
+			  "790d99759abd1508"));
+
+  /* From RFC 8452, Appendix C.2 */
+  test_aead_message (&nettle_siv_gcm_aes256,
+		     SHEX("01000000000000000000000000000000"
+			  "00000000000000000000000000000000"),
+		     SHEX("030000000000000000000000"),
+		     SHEX(""),
+		     SHEX(""),
+		     SHEX("07f5f4169bbf55a8400cd47ea6fd400f"));
+
+  test_aead_message (&nettle_siv_gcm_aes256,
+		     SHEX("01000000000000000000000000000000"
+			  "00000000000000000000000000000000"),
+		     SHEX("030000000000000000000000"),
+		     SHEX(""),
+		     SHEX("0100000000000000"),
+		     SHEX("c2ef328e5c71c83b843122130f7364b7"
+			  "61e0b97427e3df28"));
+
+  /* From RFC 8452, Appendix C.3, with a counter wrap around. */
+  test_aead_message (&nettle_siv_gcm_aes256,
+		     SHEX("00000000000000000000000000000000"
+			  "00000000000000000000000000000000"),
+		     SHEX("000000000000000000000000"),
+		     SHEX(""),
+		     SHEX("00000000000000000000000000000000"
+			  "4db923dc793ee6497c76dcc03a98e108"),
+		     SHEX("f3f80f2cf0cb2dd9c5984fcda908456c"
+			  "c537703b5ba70324a6793a7bf218d3ea"
+			  "ffffffff000000000000000000000000"));
+}
@@ -963,6 +963,20 @@ test_armor(const struct nettle_armor *armor,
   ASSERT (MEMEQ(data_length, check, data));
   ASSERT (0x55 == check[data_length]);
 
+  /* Whole buffer functions */
+  memset(buffer, 0x33, 1 + ascii_length);
+  memset(check, 0x55, 1 + data_length);
+
+  ASSERT(nettle_armor_encode(armor, buffer, data_length, data)
+	 == ascii_length);
+  ASSERT (MEMEQ(ascii_length, buffer, ascii));
+  ASSERT (0x33 == buffer[ascii_length]);
+
+  ASSERT(nettle_armor_decode(armor, &done, check, ascii_length, buffer));
+  ASSERT(done == data_length);
+  ASSERT (MEMEQ(data_length, check, data));
+  ASSERT (0x55 == check[data_length]);
+
   free(buffer);
   free(check);
   free(encode);
@@ -1016,7 +1030,7 @@ xalloc_limbs (mp_size_t n)
   return xalloc (n * sizeof (mp_limb_t));
 }
 
-/* Expects local variables pub, key, rstate, digest, signature */
+/* Expects local variables pub, key, rstate, digest, signature, scratch */
 #define SIGN(hash, msg, expected) do { \
   hash##_update(&hash, LDATA(msg));					\
   ASSERT(rsa_##hash##_sign(key, &hash, signature));			\
@@ -1043,6 +1057,13 @@ xalloc_limbs (mp_size_t n)
 				     (nettle_random_func *)knuth_lfib_random, \
 				     digest, signature));		\
   ASSERT(mpz_cmp (signature, expected) == 0);				\
+									\
+  scratch = xalloc_limbs (rsa_sec_itch (pub, key));			\
+  ASSERT(rsa_##hash##_sign_digest_tr_scratch(pub, key, &rstate,		\
+					     (nettle_random_func *)knuth_lfib_random, \
+					     digest, signature, scratch)); \
+  ASSERT(mpz_cmp (signature, expected) == 0);				\
+  free (scratch);							\
 } while(0)
 
 #define VERIFY(key, hash, msg, signature) (	\
@@ -1150,6 +1171,7 @@ test_rsa_md5(struct rsa_public_key *pub,
   struct knuth_lfib_ctx rstate;
   uint8_t digest[MD5_DIGEST_SIZE];
   mpz_t signature;
+  mp_limb_t *scratch;
 
   md5_init(&md5);
   mpz_init(signature);
@@ -1182,6 +1204,7 @@ test_rsa_sha1(struct rsa_public_key *pub,
   struct knuth_lfib_ctx rstate;
   uint8_t digest[SHA1_DIGEST_SIZE];
   mpz_t signature;
+  mp_limb_t *scratch;
 
   sha1_init(&sha1);
   mpz_init(signature);
@@ -1214,6 +1237,7 @@ test_rsa_sha256(struct rsa_public_key *pub,
   struct knuth_lfib_ctx rstate;
   uint8_t digest[SHA256_DIGEST_SIZE];
   mpz_t signature;
+  mp_limb_t *scratch;
 
   sha256_init(&sha256);
   mpz_init(signature);
@@ -1246,6 +1270,7 @@ test_rsa_sha512(struct rsa_public_key *pub,
   struct knuth_lfib_ctx rstate;
   uint8_t digest[SHA512_DIGEST_SIZE];
   mpz_t signature;
+  mp_limb_t *scratch;
 
   sha512_init(&sha512);
   mpz_init(signature);
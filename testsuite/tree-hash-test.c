@@ -0,0 +1,82 @@
+#include "testutils.h"
+#include "tree-hash.h"
+#include "nettle-internal.h"
+
+static void
+test_tree_hash(const struct nettle_hash *hash, size_t chunk_size,
+	       const struct tstring *msg,
+	       const struct tstring *digest)
+{
+  uint8_t buffer[NETTLE_MAX_HASH_DIGEST_SIZE];
+  ASSERT (digest->length == hash->digest_size);
+
+  tree_hash (hash, chunk_size, msg->length, msg->data,
+	     digest->length, buffer);
+  ASSERT (MEMEQ (digest->length, buffer, digest->data));
+}
+
+/* Computing the leaves in pieces and then the root must agree with
+   the sequential function, for every hash. */
+static void
+test_split(const struct nettle_hash *hash, size_t chunk_size,
+	   size_t length, const uint8_t *data)
+{
+  uint8_t expected[NETTLE_MAX_HASH_DIGEST_SIZE];
+  uint8_t digest[NETTLE_MAX_HASH_DIGEST_SIZE];
+  size_t count = tree_hash_leaf_count (chunk_size, length);
+  uint8_t *leaves = xalloc (count * hash->digest_size + 1);
+  size_t i;
+
+  tree_hash (hash, chunk_size, length, data, hash->digest_size, expected);
+
+  for (i = 0; i < count; i += 2)
+    {
+      size_t n = count - i < 2 ? count - i : 2;
+      tree_hash_leaves (hash, chunk_size, length, data,
+			i, n, leaves + i * hash->digest_size);
+    }
+  tree_hash_root (hash, chunk_size, length, leaves,
+		  hash->digest_size, digest);
+  ASSERT (MEMEQ (hash->digest_size, digest, expected));
+
+  /* Truncated output */
+  tree_hash_root (hash, chunk_size, length, leaves, 5, digest);
+  ASSERT (MEMEQ (5, digest, expected));
+
+  free (leaves);
+}
+
+void
+test_main(void)
+{
+  static const size_t lengths[] = { 0, 1, 63, 64, 65, 200 };
+  uint8_t data[200];
+  unsigned i, j;
+
+  ASSERT (tree_hash_leaf_count (4, 0) == 0);
+  ASSERT (tree_hash_leaf_count (4, 1) == 1);
+  ASSERT (tree_hash_leaf_count (4, 4) == 1);
+  ASSERT (tree_hash_leaf_count (4, 5) == 2);
+
+  test_tree_hash (&nettle_sha256, 4, SDATA("abcdefghij"),
+		  SHEX("6f68bb862facc7ebdf054f2b3b82355a"
+		       "e730c781a6c9457c3b0ca1f457266f16"));
+  test_tree_hash (&nettle_sha256, 4, SDATA("abcdefgh"),
+		  SHEX("8fa4d2d87c465eea38dd2074a73d544c"
+		       "c71847f7ca70bdfff0c40f364321e30d"));
+  test_tree_hash (&nettle_sha256, 1024, SDATA(""),
+		  SHEX("e7271319e70e930bbf3ebdb5b3c1708d"
+		       "872cf52c2978b4e40d129c805685fb8d"));
+  test_tree_hash (&nettle_sha1, 3, SDATA("abc"),
+		  SHEX("b02020a3ff3e627cbc8712d6e2e4ed23280ce93c"));
+
+  for (i = 0; i < sizeof(data); i++)
+    data[i] = i * 17;
+
+  for (i = 0; nettle_hashes[i]; i++)
+    for (j = 0; j < sizeof(lengths) / sizeof(lengths[0]); j++)
+      {
+	test_split (nettle_hashes[i], 64, lengths[j], data);
+	test_split (nettle_hashes[i], 7, lengths[j], data);
+      }
+}
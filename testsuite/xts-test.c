@@ -0,0 +1,287 @@
+#include "testutils.h"
+#include "knuth-lfib.h"
+#include "xts.h"
+
+static void
+test_xts_aes128 (const struct tstring *key,
+		 const struct tstring *tweak,
+		 const struct tstring *cleartext,
+		 const struct tstring *ciphertext)
+{
+  struct xts_aes128_key ctx;
+  size_t length = cleartext->length;
+  uint8_t *data = xalloc (length + 1);
+
+  ASSERT (key->length == XTS_AES128_KEY_SIZE);
+  ASSERT (tweak->length == XTS_BLOCK_SIZE);
+  ASSERT (ciphertext->length == length);
+
+  xts_aes128_set_encrypt_key (&ctx, key->data);
+  data[length] = 17;
+  xts_aes128_encrypt_message (&ctx, tweak->data, length,
+			      data, cleartext->data);
+  if (!MEMEQ (length, data, ciphertext->data))
+    {
+      fprintf (stderr, "XTS encrypt failed:\nInput:");
+      tstring_print_hex (cleartext);
+      fprintf (stderr, "\nOutput: ");
+      print_hex (length, data);
+      fprintf (stderr, "\nExpected:");
+      tstring_print_hex (ciphertext);
+      fprintf (stderr, "\n");
+      FAIL ();
+    }
+  ASSERT (data[length] == 17);
+
+  xts_aes128_set_decrypt_key (&ctx, key->data);
+  xts_aes128_decrypt_message (&ctx, tweak->data, length,
+			      data, data);
+  ASSERT (MEMEQ (length, data, cleartext->data));
+
+  /* In-place encryption */
+  xts_aes128_set_encrypt_key (&ctx, key->data);
+  xts_aes128_encrypt_message (&ctx, tweak->data, length,
+			      data, data);
+  ASSERT (MEMEQ (length, data, ciphertext->data));
+
+  free (data);
+}
+
+static void
+test_xts_aes256 (const struct tstring *key,
+		 const struct tstring *tweak,
+		 const struct tstring *cleartext,
+		 const struct tstring *ciphertext)
+{
+  struct xts_aes256_key ctx;
+  size_t length = cleartext->length;
+  uint8_t *data = xalloc (length + 1);
+
+  ASSERT (key->length == XTS_AES256_KEY_SIZE);
+  ASSERT (tweak->length == XTS_BLOCK_SIZE);
+  ASSERT (ciphertext->length == length);
+
+  xts_aes256_set_encrypt_key (&ctx, key->data);
+  data[length] = 17;
+  xts_aes256_encrypt_message (&ctx, tweak->data, length,
+			      data, cleartext->data);
+  if (!MEMEQ (length, data, ciphertext->data))
+    {
+      fprintf (stderr, "XTS encrypt failed:\nInput:");
+      tstring_print_hex (cleartext);
+      fprintf (stderr, "\nOutput: ");
+      print_hex (length, data);
+      fprintf (stderr, "\nExpected:");
+      tstring_print_hex (ciphertext);
+      fprintf (stderr, "\n");
+      FAIL ();
+    }
+  ASSERT (data[length] == 17);
+
+  xts_aes256_set_decrypt_key (&ctx, key->data);
+  xts_aes256_decrypt_message (&ctx, tweak->data, length,
+			      data, data);
+  ASSERT (MEMEQ (length, data, cleartext->data));
+
+  free (data);
+}
+
+/* Checks the sector functions against separate calls for each
+   sector, using sector sizes with and without a partial block. */
+static void
+test_xts_sectors (size_t sector_size, unsigned count)
+{
+  struct xts_aes256_key ctx;
+  struct knuth_lfib_ctx lfib;
+  uint8_t key[XTS_AES256_KEY_SIZE];
+  uint8_t tweak[XTS_BLOCK_SIZE];
+  size_t length = sector_size * count;
+  uint64_t first = ~(uint64_t) 1 - count;
+  uint8_t *clear = xalloc (length);
+  uint8_t *cipher = xalloc (length);
+  uint8_t *data = xalloc (length);
+  unsigned i;
+
+  knuth_lfib_init (&lfib, sector_size);
+  knuth_lfib_random (&lfib, sizeof (key), key);
+  knuth_lfib_random (&lfib, length, clear);
+
+  xts_aes256_set_encrypt_key (&ctx, key);
+  for (i = 0; i < count; i++)
+    {
+      uint64_t sector = first + i;
+      unsigned j;
+      for (j = 0; j < XTS_BLOCK_SIZE; j++, sector >>= 8)
+	tweak[j] = j < 8 ? sector & 0xff : 0;
+      xts_aes256_encrypt_message (&ctx, tweak, sector_size,
+				  cipher + i * sector_size,
+				  clear + i * sector_size);
+    }
+  xts_aes256_encrypt_sectors (&ctx, sector_size, first, length,
+			      data, clear);
+  ASSERT (MEMEQ (length, data, cipher));
+
+  xts_aes256_set_decrypt_key (&ctx, key);
+  xts_aes256_decrypt_sectors (&ctx, sector_size, first, length,
+			      data, data);
+  ASSERT (MEMEQ (length, data, clear));
+
+  free (clear);
+  free (cipher);
+  free (data);
+}
+
+void
+test_main(void)
+{
+  /* From IEEE P1619 */
+  test_xts_aes128 (SHEX("00000000000000000000000000000000"
+			"00000000000000000000000000000000"),
+		   SHEX("00000000000000000000000000000000"),
+		   SHEX("00000000000000000000000000000000"
+			"00000000000000000000000000000000"),
+		   SHEX("917cf69ebd68b2ec9b9fe9a3eadda692"
+			"cd43d2f59598ed858c02c2652fbf922e"));
+
+  test_xts_aes128 (SHEX("11111111111111111111111111111111"
+			"22222222222222222222222222222222"),
+		   SHEX("33333333330000000000000000000000"),
+		   SHEX("44444444444444444444444444444444"
+			"44444444444444444444444444444444"),
+		   SHEX("c454185e6a16936e39334038acef838b"
+			"fb186fff7480adc4289382ecd6d394f0"));
+
+  test_xts_aes128 (SHEX("fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0"
+			"22222222222222222222222222222222"),
+		   SHEX("33333333330000000000000000000000"),
+		   SHEX("44444444444444444444444444444444"
+			"44444444444444444444444444444444"),
+		   SHEX("af85336b597afc1a900b2eb21ec949d2"
+			"92df4c047e0b21532186a5971a227a89"));
+
+  /* Ciphertext stealing */
+  test_xts_aes128 (SHEX("fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0"
+			"bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0"),
+		   SHEX("9a785634120000000000000000000000"),
+		   SHEX("000102030405060708090a0b0c0d0e0f10"),
+		   SHEX("6c1625db4671522d3d7599601de7ca09ed"));
+
+  test_xts_aes128 (SHEX("fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0"
+			"bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0"),
+		   SHEX("9a785634120000000000000000000000"),
+		   SHEX("000102030405060708090a0b0c0d0e0f1011"),
+		   SHEX("d069444b7a7e0cab09e24447d24deb1fedbf"));
+
+  test_xts_aes128 (SHEX("fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0"
+			"bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0"),
+		   SHEX("9a785634120000000000000000000000"),
+		   SHEX("000102030405060708090a0b0c0d0e0f101112"),
+		   SHEX("e5df1351c0544ba1350b3363cd8ef4beedbf9d"));
+
+  test_xts_aes128 (SHEX("fffefdfcfbfaf9f8f7f6f5f4f3f2f1f0"
+			"bfbebdbcbbbab9b8b7b6b5b4b3b2b1b0"),
+		   SHEX("9a785634120000000000000000000000"),
+		   SHEX("000102030405060708090a0b0c0d0e0f10111213"),
+		   SHEX("9d84c813f719aa2c7be3f66171c7c5c2edbf9dac"));
+
+  /* IEEE P1619 vector 10, 512-byte data unit. */
+  test_xts_aes256 (SHEX("27182818284590452353602874713526"
+			"62497757247093699959574966967627"
+			"31415926535897932384626433832795"
+			"02884197169399375105820974944592"),
+		   SHEX("ff000000000000000000000000000000"),
+		   SHEX("000102030405060708090a0b0c0d0e0f"
+			"101112131415161718191a1b1c1d1e1f"
+			"202122232425262728292a2b2c2d2e2f"
+			"303132333435363738393a3b3c3d3e3f"
+			"404142434445464748494a4b4c4d4e4f"
+			"505152535455565758595a5b5c5d5e5f"
+			"606162636465666768696a6b6c6d6e6f"
+			"707172737475767778797a7b7c7d7e7f"
+			"808182838485868788898a8b8c8d8e8f"
+			"909192939495969798999a9b9c9d9e9f"
+			"a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+			"b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+			"c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+			"d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+			"e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+			"f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"
+			"000102030405060708090a0b0c0d0e0f"
+			"101112131415161718191a1b1c1d1e1f"
+			"202122232425262728292a2b2c2d2e2f"
+			"303132333435363738393a3b3c3d3e3f"
+			"404142434445464748494a4b4c4d4e4f"
+			"505152535455565758595a5b5c5d5e5f"
+			"606162636465666768696a6b6c6d6e6f"
+			"707172737475767778797a7b7c7d7e7f"
+			"808182838485868788898a8b8c8d8e8f"
+			"909192939495969798999a9b9c9d9e9f"
+			"a0a1a2a3a4a5a6a7a8a9aaabacadaeaf"
+			"b0b1b2b3b4b5b6b7b8b9babbbcbdbebf"
+			"c0c1c2c3c4c5c6c7c8c9cacbcccdcecf"
+			"d0d1d2d3d4d5d6d7d8d9dadbdcdddedf"
+			"e0e1e2e3e4e5e6e7e8e9eaebecedeeef"
+			"f0f1f2f3f4f5f6f7f8f9fafbfcfdfeff"),
+		   SHEX("1c3b3a102f770386e4836c99e370cf9b"
+			"ea00803f5e482357a4ae12d414a3e63b"
+			"5d31e276f8fe4a8d66b317f9ac683f44"
+			"680a86ac35adfc3345befecb4bb188fd"
+			"5776926c49a3095eb108fd1098baec70"
+			"aaa66999a72a82f27d848b21d4a741b0"
+			"c5cd4d5fff9dac89aeba122961d03a75"
+			"7123e9870f8acf1000020887891429ca"
+			"2a3e7a7d7df7b10355165c8b9a6d0a7d"
+			"e8b062c4500dc4cd120c0f7418dae3d0"
+			"b5781c34803fa75421c790dfe1de1834"
+			"f280d7667b327f6c8cd7557e12ac3a0f"
+			"93ec05c52e0493ef31a12d3d9260f79a"
+			"289d6a379bc70c50841473d1a8cc81ec"
+			"583e9645e07b8d9670655ba5bbcfecc6"
+			"dc3966380ad8fecb17b6ba02469a020a"
+			"84e18e8f84252070c13e9f1f289be54f"
+			"bc481457778f616015e1327a02b140f1"
+			"505eb309326d68378f8374595c849d84"
+			"f4c333ec4423885143cb47bd71c5edae"
+			"9be69a2ffeceb1bec9de244fbe15992b"
+			"11b77c040f12bd8f6a975a44a0f90c29"
+			"a9abc3d4d893927284c58754cce29452"
+			"9f8614dcd2aba991925fedc4ae74ffac"
+			"6e333b93eb4aff0479da9a410e4450e0"
+			"dd7ae4c6e2910900575da401fc07059f"
+			"645e8b7e9bfdef33943054ff84011493"
+			"c27b3429eaedb4ed5376441a77ed4385"
+			"1ad77f16f541dfd269d50d6a5f14fb0a"
+			"ab1cbb4c1550be97f7ab4066193c4caa"
+			"773dad38014bd2092fa755c824bb5e54"
+			"c4f36ffda9fcea70b9c6e693e148c151"));
+
+  /* Ciphertext stealing, with the key and tweak of vector 10. The
+     standard has no such AES-256 vectors; these were computed with
+     OpenSSL, which agrees with the vectors above. */
+  test_xts_aes256 (SHEX("27182818284590452353602874713526"
+			"62497757247093699959574966967627"
+			"31415926535897932384626433832795"
+			"02884197169399375105820974944592"),
+		   SHEX("ff000000000000000000000000000000"),
+		   SHEX("000102030405060708090a0b0c0d0e0f"
+			"10"),
+		   SHEX("990b3d5708499ecacac51584606f5d76"
+			"1c"));
+
+  test_xts_aes256 (SHEX("27182818284590452353602874713526"
+			"62497757247093699959574966967627"
+			"31415926535897932384626433832795"
+			"02884197169399375105820974944592"),
+		   SHEX("ff000000000000000000000000000000"),
+		   SHEX("000102030405060708090a0b0c0d0e0f"
+			"101112131415161718191a1b1c1d1e1f"
+			"202122232425262728292a2b2c"),
+		   SHEX("1c3b3a102f770386e4836c99e370cf9b"
+			"a8e74b9743b309053440ac0e771aff01"
+			"ea00803f5e482357a4ae12d414"));
+
+  test_xts_sectors (512, 3);
+  test_xts_sectors (4096, 2);
+  test_xts_sectors (4099, 2);
+  test_xts_sectors (17, 5);
+}
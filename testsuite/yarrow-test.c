@@ -1,6 +1,7 @@
 #include "testutils.h"
 #include "yarrow.h"
 #include "knuth-lfib.h"
+#include "ctr.h"
 
 #include "macros.h"
 
@@ -10,6 +11,12 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if HAVE_FORK
+# include <signal.h>
+# include <sys/wait.h>
+# include <unistd.h>
+#endif
+
 /* Lagged fibonacci sequence as described in Knuth 3.6 */
 
 struct knuth_lfib_ctx lfib;
@@ -58,6 +65,107 @@ open_file(const char *name)
   return fopen(name, "r");
 }
 
+/* Counter mode output from the given key, starting at counter. */
+static void
+local_keystream(const struct aes256_ctx *aes, const uint8_t *counter,
+		size_t length, uint8_t *dst)
+{
+  uint8_t ctr[AES_BLOCK_SIZE];
+
+  memcpy(ctr, counter, sizeof(ctr));
+  memset(dst, 0, length);
+  ctr_crypt(aes, (nettle_cipher_func *) aes256_encrypt,
+	    AES_BLOCK_SIZE, ctr, length, dst, dst);
+}
+
+static void
+test_local(const struct yarrow256_ctx *shared)
+{
+  struct yarrow256_ctx parent = *shared;
+  struct yarrow256_ctx child = *shared;
+  struct yarrow256_local_ctx local;
+  struct yarrow256_local_ctx other;
+  struct aes256_ctx next_key;
+  uint8_t stream[YARROW256_LOCAL_BUFFER_SIZE + AES256_KEY_SIZE];
+  uint8_t next[2 * YARROW256_LOCAL_BUFFER_SIZE + AES256_KEY_SIZE];
+  uint8_t out[1000];
+  uint8_t out2[1000];
+
+  yarrow256_local_init(&local);
+  ASSERT(yarrow256_local_seed(&local, &parent, 6,
+			      (const uint8_t *) "thread"));
+
+  /* The seed consumes output from the shared generator. */
+  ASSERT(!MEMEQ(sizeof(parent.counter), parent.counter, child.counter));
+
+  /* A buffer of output, then the next key. The counter is not reset
+     by the rekeying. */
+  local_keystream(&local.key, local.counter, sizeof(stream), stream);
+  aes256_set_encrypt_key(&next_key, stream + YARROW256_LOCAL_BUFFER_SIZE);
+  local_keystream(&next_key, local.counter, sizeof(next), next);
+  memmove(next, next + sizeof(stream), YARROW256_LOCAL_BUFFER_SIZE);
+
+  yarrow256_local_random(&local, 100, out);
+  ASSERT(MEMEQ(100, out, stream));
+  yarrow256_local_random(&local, 200, out);
+  ASSERT(MEMEQ(YARROW256_LOCAL_BUFFER_SIZE - 100, out, stream + 100));
+  ASSERT(MEMEQ(200 - (YARROW256_LOCAL_BUFFER_SIZE - 100),
+	       out + YARROW256_LOCAL_BUFFER_SIZE - 100, next));
+
+  /* Identical copies of the shared state and identical seed data, as
+     in the two processes after a fork, must still give different
+     output, thanks to the fresh entropy. */
+  parent = *shared;
+  child = *shared;
+  ASSERT(yarrow256_local_seed(&local, &parent, 5,
+			      (const uint8_t *) "child"));
+  yarrow256_local_init(&other);
+  ASSERT(yarrow256_local_seed(&other, &child, 5,
+			      (const uint8_t *) "child"));
+  ASSERT(MEMEQ(sizeof(parent.counter), parent.counter, child.counter));
+  yarrow256_local_random(&local, sizeof(out), out);
+  yarrow256_local_random(&other, sizeof(out2), out2);
+  ASSERT(!MEMEQ(sizeof(out), out, out2));
+
+  /* Large requests bypass the buffer. */
+  ASSERT(yarrow256_local_seed(&local, &parent, 0, NULL));
+  yarrow256_local_random(&local, sizeof(out), out);
+  yarrow256_local_random(&local, 3, out2);
+  ASSERT(!MEMEQ(3, out, out2));
+
+#if HAVE_FORK
+  {
+    /* A child process must seed the generator again before use. */
+    int status;
+    pid_t pid = fork();
+    ASSERT(pid >= 0);
+    if (!pid)
+      {
+	yarrow256_local_random(&local, 3, out2);
+	_exit(0);
+      }
+    ASSERT(waitpid(pid, &status, 0) == pid);
+    ASSERT(WIFSIGNALED(status) && WTERMSIG(status) == SIGABRT);
+
+    pid = fork();
+    ASSERT(pid >= 0);
+    if (!pid)
+      {
+	if (!yarrow256_local_seed(&local, &parent, 0, NULL))
+	  _exit(1);
+	yarrow256_local_random(&local, 3, out2);
+	_exit(0);
+      }
+    ASSERT(waitpid(pid, &status, 0) == pid);
+    ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+  }
+#endif
+
+  yarrow256_local_clear(&local);
+  ASSERT(!local.seeded);
+  yarrow256_local_clear(&other);
+}
+
 void
 test_main(void)
 {
@@ -209,4 +317,6 @@ test_main(void)
     }
   
   ASSERT (memcmp(digest, expected_output, sizeof(digest)) == 0);
+
+  test_local(&yarrow);
 }
@@ -38,66 +38,161 @@
 #include <stdlib.h>
 #include <string.h>
 
+#if HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+
 #include "input.h"
 
 void
 sexp_input_init(struct sexp_input *input, FILE *f)
 {
   input->f = f;
+  input->pos = input->end = 0;
   input->coding = NULL;
 }
 
+/* Reads the next block of raw input. Returns zero at end of file. */
+static int
+sexp_input_fill(struct sexp_input *input)
+{
+  assert(input->pos == input->end);
+
+#if HAVE_UNISTD_H
+  /* Unlike fread, read returns whatever is available, so that
+   * expressions arriving on a pipe are converted as they arrive. */
+  {
+    ssize_t res;
+    do
+      res = read(fileno(input->f), input->buffer, sizeof(input->buffer));
+    while (res < 0 && errno == EINTR);
+
+    if (res < 0)
+      die("Read error: %s\n", strerror(errno));
+
+    input->end = res;
+  }
+#else
+  input->end = fread(input->buffer, 1, sizeof(input->buffer), input->f);
+  if (ferror(input->f))
+    die("Read error: %s\n", strerror(errno));
+#endif
+  input->pos = 0;
+
+  return input->end > 0;
+}
+
 static void
 sexp_get_raw_char(struct sexp_input *input)
 {
-  int c = getc(input->f);
-  
-  if (c < 0)
-    {
-      if (ferror(input->f))
-	die("Read error: %s\n", strerror(errno));
-      
-      input->ctype = SEXP_EOF_CHAR;
-    }
+  if (input->pos == input->end && !sexp_input_fill(input))
+    input->ctype = SEXP_EOF_CHAR;
   else
     {
       input->ctype = SEXP_NORMAL_CHAR;
-      input->c = c;
+      input->c = input->buffer[input->pos++];
+    }
+}
+
+/* Decodes coded data up to the terminator, or as much as is
+ * buffered, whichever comes first. */
+static void
+sexp_input_decode(struct sexp_input *input)
+{
+  assert(input->decoded_pos == input->decoded_end);
+  assert(!input->coding_end);
+
+  input->decoded_pos = 0;
+  input->decoded_end = 0;
+
+  do
+    {
+      const uint8_t *src;
+      const uint8_t *terminator;
+      size_t length;
+
+      if (input->pos == input->end && !sexp_input_fill(input))
+	die("Unexpected end of file in coded data.\n");
+
+      src = input->buffer + input->pos;
+      length = input->end - input->pos;
+      terminator = memchr(src, input->terminator, length);
+      if (terminator)
+	length = terminator - src;
+
+      assert(input->coding->decode_length(length)
+	     <= sizeof(input->decoded));
+      if (!input->coding->decode_update(&input->state,
+					&input->decoded_end, input->decoded,
+					length, (const char *) src))
+	die("Invalid coded data.\n");
+
+      input->pos += length;
+      if (terminator)
+	{
+	  input->pos++;
+	  input->coding_end = 1;
+	}
     }
+  while (!input->decoded_end && !input->coding_end);
 }
 
 void
 sexp_get_char(struct sexp_input *input)
 {
   if (input->coding)
-    for (;;)
-      {
-	size_t done;
-
-	sexp_get_raw_char(input);
-	if (input->ctype == SEXP_EOF_CHAR)
-	  die("Unexpected end of file in coded data.\n");
-
-	if (input->c == input->terminator)
-	  {
-	    input->ctype = SEXP_END_CHAR;
-	    return;
-	  }
+    {
+      if (input->decoded_pos == input->decoded_end)
+	{
+	  if (input->coding_end)
+	    {
+	      input->ctype = SEXP_END_CHAR;
+	      return;
+	    }
+	  sexp_input_decode(input);
+	  if (!input->decoded_end)
+	    {
+	      input->ctype = SEXP_END_CHAR;
+	      return;
+	    }
+	}
+      input->ctype = SEXP_NORMAL_CHAR;
+      input->c = input->decoded[input->decoded_pos++];
+    }
+  else
+    sexp_get_raw_char(input);
+}
 
-	done = 1;
+/* Returns the characters following input->c which are available
+ * without further reading or decoding. */
+static const uint8_t *
+sexp_input_peek(struct sexp_input *input, size_t *length)
+{
+  if (input->coding)
+    {
+      *length = input->decoded_end - input->decoded_pos;
+      return input->decoded + input->decoded_pos;
+    }
+  else
+    {
+      *length = input->end - input->pos;
+      return input->buffer + input->pos;
+    }
+}
 
-	/* Decodes in place. Should always work, when we decode one
-	 * character at a time. */
-	if (!input->coding->decode_update(&input->state,
-					  &done, &input->c,
-					  1, (const char*) &input->c))
-	  die("Invalid coded data.\n");
-	
-	if (done)
-	  return;
-      }
+static void
+sexp_input_skip(struct sexp_input *input, size_t length)
+{
+  if (input->coding)
+    {
+      assert(length <= input->decoded_end - input->decoded_pos);
+      input->decoded_pos += length;
+    }
   else
-    sexp_get_raw_char(input);
+    {
+      assert(length <= input->end - input->pos);
+      input->pos += length;
+    }
 }
 
 static uint8_t
@@ -120,6 +215,25 @@ sexp_push_char(struct sexp_input *input,
     die("Virtual memory exhasuted.\n");
 }
 
+/* Appends up to LENGTH characters following input->c, as far as they
+ * are available, and returns the number of characters appended. */
+static size_t
+sexp_push_run(struct sexp_input *input, size_t length,
+	      struct nettle_buffer *string)
+{
+  size_t available;
+  const uint8_t *data = sexp_input_peek(input, &available);
+
+  if (length > available)
+    length = available;
+
+  if (!nettle_buffer_write(string, length, data))
+    die("Virtual memory exhasuted.\n");
+
+  sexp_input_skip(input, length);
+  return length;
+}
+
 static void
 sexp_input_start_coding(struct sexp_input *input,
 			const struct nettle_armor *coding,
@@ -130,12 +244,15 @@ sexp_input_start_coding(struct sexp_input *input,
   input->coding = coding;
   input->coding->decode_init(&input->state);
   input->terminator = terminator;
+  input->coding_end = 0;
+  input->decoded_pos = input->decoded_end = 0;
 }
 
 static void
 sexp_input_end_coding(struct sexp_input *input)
 {
   assert(input->coding);
+  assert(input->decoded_pos == input->decoded_end);
 
   if (!input->coding->decode_final(&input->state))
     die("Invalid coded data.\n");
@@ -198,7 +315,19 @@ sexp_get_token_string(struct sexp_input *input,
 
   do
     {
+      const uint8_t *data;
+      size_t available;
+      size_t length;
+
       sexp_push_char(input, string);
+
+      /* Copy the rest of the buffered run at once. */
+      data = sexp_input_peek(input, &available);
+      for (length = 0; length < available && TOKEN_CHAR(data[length]);
+	   length++)
+	;
+      sexp_push_run(input, length, string);
+
       sexp_get_char(input);
     }
   while (input->ctype == SEXP_NORMAL_CHAR && TOKEN_CHAR(input->c));
@@ -237,6 +366,7 @@ sexp_get_string(struct sexp_input *input,
 	    {
 	    case SEXP_NORMAL_CHAR:
 	      sexp_push_char(input, string);
+	      sexp_push_run(input, SIZE_MAX, string);
 	      break;
 	    case SEXP_EOF_CHAR:
 	      die("Unexpected end of file in coded string.\n");
@@ -288,10 +418,12 @@ sexp_get_string_length(struct sexp_input *input, enum sexp_mode mode,
 
   if (input->c == ':')
     /* Verbatim */
-    for (; length; length--)
+    while (length > 0)
       {
 	sexp_next_char(input);
 	sexp_push_char(input, string);
+	length--;
+	length -= sexp_push_run(input, length, string);
       }
 
   else if (mode != SEXP_ADVANCED)
@@ -320,10 +452,12 @@ sexp_get_string_length(struct sexp_input *input, enum sexp_mode mode,
 	sexp_input_start_coding(input, &nettle_base64, '|');
 
       decode:
-	for (; length; length--)
+	while (length > 0)
 	  {
 	    sexp_next_char(input);
 	    sexp_push_char(input, string);
+	    length--;
+	    length -= sexp_push_run(input, length, string);
 	  }
 	sexp_get_char(input);
 	if (input->ctype != SEXP_END_CHAR)
@@ -346,12 +480,24 @@ sexp_get_comment(struct sexp_input *input, struct nettle_buffer *string)
 {
   nettle_buffer_reset(string);
 
+  assert(!input->coding);
   assert(input->ctype == SEXP_NORMAL_CHAR);
   assert(input->c == ';');
 
   do
     {
+      const uint8_t *data;
+      const uint8_t *eol;
+      size_t length;
+
       sexp_push_char(input, string);
+
+      data = sexp_input_peek(input, &length);
+      eol = memchr(data, '\n', length);
+      if (eol)
+	length = eol - data;
+      sexp_push_run(input, length, string);
+
       sexp_get_raw_char(input);
     }
   while (input->ctype == SEXP_NORMAL_CHAR && input->c != '\n');
@@ -48,10 +48,19 @@ enum sexp_char_type
     SEXP_EOF_CHAR, SEXP_END_CHAR,
   };
 
+/* Size of the block buffer for raw input */
+#define SEXP_INPUT_BUFFER_SIZE 0x8000
+
 struct sexp_input
 {
   FILE *f;
 
+  /* Raw input is read a block at a time, and the unread part is
+   * buffer[pos, end). */
+  size_t pos;
+  size_t end;
+  uint8_t buffer[SEXP_INPUT_BUFFER_SIZE];
+
   /* Character stream, consisting of ordinary characters,
    * SEXP_EOF_CHAR, and SEXP_END_CHAR. */
   enum sexp_char_type ctype;
@@ -66,6 +75,15 @@ struct sexp_input
 
   /* Terminator for current coding */
   uint8_t terminator;
+
+  /* Coded data is decoded in runs, up to the terminator or the end
+   * of the buffered raw input. The unread part is
+   * decoded[decoded_pos, decoded_end), and coding_end is set when
+   * the terminator has been consumed. */
+  int coding_end;
+  size_t decoded_pos;
+  size_t decoded_end;
+  uint8_t decoded[BASE64_DECODE_LENGTH(SEXP_INPUT_BUFFER_SIZE)];
   
   /* Type of current token */
   enum sexp_token token;
@@ -40,13 +40,53 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include <sys/types.h>
+#include <sys/stat.h>
+#if HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+
+#if HAVE_SYS_MMAN_H && HAVE_MMAP
+# include <sys/mman.h>
+# define USE_MMAP 1
+#else
+# define USE_MMAP 0
+#endif
+
+#if HAVE_PTHREAD_H && HAVE_LIBPTHREAD
+# include <pthread.h>
+# define USE_THREADS 1
+#else
+# define USE_THREADS 0
+#endif
+
 #include "nettle-meta.h"
 #include "base16.h"
+#include "tree-hash.h"
 
 #include "getopt.h"
 #include "misc.h"
 
-#define BUFSIZE 16384
+/* Large reads, to keep the number of system calls down for pipes and
+   devices. fread copies directly into a buffer of this size. */
+#define BUFSIZE (1 << 18)
+
+/* Default chunk size for --tree. */
+#define TREE_CHUNK_SIZE (1 << 20)
+
+/* How each file is hashed and printed. */
+struct hash_mode
+{
+  const struct nettle_hash *alg;
+  /* Printed after the digest. */
+  const char *name;
+  unsigned digest_length;
+  int raw;
+  /* Chunk size for --tree, otherwise zero. */
+  size_t chunk_size;
+  /* Number of threads hashing the leaves of a single file. */
+  unsigned threads;
+};
 
 static void
 list_algorithms (void)
@@ -60,30 +100,265 @@ list_algorithms (void)
 	    alg->name, alg->digest_size, alg->block_size, alg->context_size);
 };
 
+#if USE_MMAP
+/* Maps a regular file, avoiding copies. Returns NULL if the file must
+   be read instead. */
+static uint8_t *
+map_file(FILE *f, size_t *size)
+{
+  struct stat st;
+  int fd = fileno (f);
+  void *p;
+
+  if (fstat (fd, &st) < 0 || !S_ISREG (st.st_mode) || st.st_size <= 0
+      || (uintmax_t) st.st_size > SIZE_MAX)
+    return NULL;
+
+  /* The mapping starts at the beginning of the file, so give up if
+     anything has been read already. */
+  if (ftell (f) != 0 || lseek (fd, 0, SEEK_CUR) != 0)
+    return NULL;
+
+  *size = st.st_size;
+  p = mmap (NULL, *size, PROT_READ, MAP_PRIVATE, fd, 0);
+  if (p == MAP_FAILED)
+    return NULL;
+
+#if HAVE_MADVISE && defined (MADV_SEQUENTIAL)
+  madvise (p, *size, MADV_SEQUENTIAL);
+#endif
+  return p;
+}
+
+static int
+hash_mapped_file(const struct nettle_hash *hash, void *ctx, FILE *f)
+{
+  size_t size;
+  uint8_t *p = map_file (f, &size);
+  if (!p)
+    return 0;
+
+  hash->update(ctx, size, p);
+  munmap (p, size);
+  return 1;
+}
+#endif
+
 /* Also in examples/io.c */
 static int
 hash_file(const struct nettle_hash *hash, void *ctx, FILE *f)
 {
+  uint8_t *buffer;
+
+#if USE_MMAP
+  if (hash_mapped_file (hash, ctx, f))
+    return 1;
+#endif
+
+  buffer = xalloc (BUFSIZE);
   for (;;)
     {
-      uint8_t buffer[BUFSIZE];
-      size_t res = fread(buffer, 1, sizeof(buffer), f);
+      size_t res = fread(buffer, 1, BUFSIZE, f);
       if (ferror(f))
-	return 0;
+	{
+	  free (buffer);
+	  return 0;
+	}
       
       hash->update(ctx, res, buffer);
       if (feof(f))
-	return 1;
+	{
+	  free (buffer);
+	  return 1;
+	}
+    }
+}
+
+#if USE_THREADS
+/* Leaves are handed out in runs of step leaves to the worker threads,
+   and the calling thread. */
+struct leaf_queue
+{
+  const struct hash_mode *mode;
+  size_t length;
+  const uint8_t *data;
+  uint8_t *leaves;
+
+  pthread_mutex_t lock;
+  size_t next;
+  size_t count;
+  size_t step;
+};
+
+static void *
+leaf_worker(void *arg)
+{
+  struct leaf_queue *queue = arg;
+  const struct nettle_hash *alg = queue->mode->alg;
+
+  for (;;)
+    {
+      size_t first;
+      size_t n;
+
+      pthread_mutex_lock (&queue->lock);
+      first = queue->next;
+      n = queue->count - first;
+      if (n > queue->step)
+	n = queue->step;
+      queue->next += n;
+      pthread_mutex_unlock (&queue->lock);
+
+      if (n == 0)
+	return NULL;
+
+      tree_hash_leaves (alg, queue->mode->chunk_size,
+			queue->length, queue->data, first, n,
+			queue->leaves + first * alg->digest_size);
     }
 }
 
+static void
+hash_leaves_parallel(const struct hash_mode *mode,
+		     size_t length, const uint8_t *data,
+		     size_t count, uint8_t *leaves)
+{
+  struct leaf_queue queue;
+  unsigned nthreads = mode->threads;
+  pthread_t *threads;
+  unsigned i;
+
+  if (nthreads > count)
+    nthreads = count;
+
+  queue.mode = mode;
+  queue.length = length;
+  queue.data = data;
+  queue.leaves = leaves;
+  pthread_mutex_init (&queue.lock, NULL);
+  queue.next = 0;
+  queue.count = count;
+  /* A few runs per thread, to even out the load. */
+  queue.step = (count + 4*nthreads - 1) / (4*nthreads);
+
+  threads = xalloc (nthreads * sizeof(*threads));
+  for (i = 1; i < nthreads; i++)
+    if (pthread_create (&threads[i], NULL, leaf_worker, &queue))
+      die ("Creating thread failed.\n");
+
+  leaf_worker (&queue);
+
+  for (i = 1; i < nthreads; i++)
+    pthread_join (threads[i], NULL);
+
+  free (threads);
+  pthread_mutex_destroy (&queue.lock);
+}
+#endif /* USE_THREADS */
+
+/* Computes the leaf digests of length octets, starting at a chunk
+   boundary. */
+static void
+hash_leaves(const struct hash_mode *mode,
+	    size_t length, const uint8_t *data, uint8_t *leaves)
+{
+  size_t count = tree_hash_leaf_count (mode->chunk_size, length);
+
+#if USE_THREADS
+  if (mode->threads > 1 && count > 1)
+    {
+      hash_leaves_parallel (mode, length, data, count, leaves);
+      return;
+    }
+#endif
+  tree_hash_leaves (mode->alg, mode->chunk_size, length, data,
+		    0, count, leaves);
+}
+
 static int
-digest_file(const struct nettle_hash *alg,
-	    unsigned digest_length, int raw,
-	    FILE *f)
+tree_digest_file(const struct hash_mode *mode, uint8_t *digest, FILE *f)
 {
+  size_t digest_size = mode->alg->digest_size;
+  size_t batch;
+  uint8_t *buffer;
+  uint8_t *leaves;
+  size_t count;
+  size_t alloc;
+  uint64_t length;
+
+#if USE_MMAP
+  buffer = map_file (f, &batch);
+  if (buffer)
+    {
+      leaves = xalloc (tree_hash_leaf_count (mode->chunk_size, batch)
+		       * digest_size);
+      hash_leaves (mode, batch, buffer, leaves);
+      munmap (buffer, batch);
+
+      tree_hash_root (mode->alg, mode->chunk_size, batch, leaves,
+		      mode->digest_length, digest);
+      free (leaves);
+      return 1;
+    }
+#endif
+
+  /* Read a few chunks per thread at a time. fread returns a short
+     count only at the end of the input, so all but the last batch
+     are whole chunks. */
+  batch = mode->chunk_size;
+  if (batch <= SIZE_MAX / (4 * mode->threads))
+    batch *= 4 * mode->threads;
+  buffer = xalloc (batch);
+  leaves = NULL;
+  count = alloc = 0;
+  length = 0;
+
+  for (;;)
+    {
+      size_t res = fread(buffer, 1, batch, f);
+      size_t n;
+      if (ferror(f))
+	{
+	  free (buffer);
+	  free (leaves);
+	  return 0;
+	}
+
+      n = tree_hash_leaf_count (mode->chunk_size, res);
+      if (n > 0)
+	{
+	  if (count + n > alloc)
+	    {
+	      alloc = 2*alloc + n;
+	      leaves = realloc (leaves, alloc * digest_size);
+	      if (!leaves)
+		die ("Virtual memory exhausted.\n");
+	    }
+	  hash_leaves (mode, res, buffer, leaves + count * digest_size);
+	  count += n;
+	  length += res;
+	}
+
+      if (feof(f))
+	break;
+    }
+
+  tree_hash_root (mode->alg, mode->chunk_size, length, leaves,
+		  mode->digest_length, digest);
+  free (buffer);
+  free (leaves);
+  return 1;
+}
+
+static int
+digest_file(const struct hash_mode *mode, uint8_t *digest, FILE *f)
+{
+  const struct nettle_hash *alg = mode->alg;
   void *ctx;
-  uint8_t *digest;
+
+  if (mode->chunk_size)
+    return tree_digest_file (mode, digest, f);
+
   ctx = xalloc(alg->context_size);
 
   alg->init(ctx);
@@ -94,11 +369,18 @@ digest_file(const struct nettle_hash *alg,
       return 0;
     }
 
-  digest = xalloc(digest_length);
-  alg->digest(ctx, digest_length, digest);
+  alg->digest(ctx, mode->digest_length, digest);
   free(ctx);
 
-  if (raw)
+  return 1;
+}
+
+static void
+print_digest(const struct hash_mode *mode, const uint8_t *digest)
+{
+  unsigned digest_length = mode->digest_length;
+
+  if (mode->raw)
     fwrite (digest, digest_length, 1, stdout);
 
   else
@@ -113,14 +395,136 @@ digest_file(const struct nettle_hash *alg,
 	}
       base16_encode_update(hex, digest_length - i, digest + i);
       hex[BASE16_ENCODE_LENGTH(digest_length - i)] = 0;
-      printf("%s %s\n", hex, alg->name);
+      printf("%s %s\n", hex, mode->name);
     }
-  
-  free(digest);
+}
 
-  return 1;
+/* One named file to hash. */
+struct hash_job
+{
+  const char *name;
+  enum { JOB_OK, JOB_OPEN_FAILED, JOB_READ_FAILED } status;
+  int error;
+  int done;
+  uint8_t *digest;
+};
+
+static void
+run_job(const struct hash_mode *mode, struct hash_job *job)
+{
+  FILE *f = fopen (job->name, "rb");
+  if (!f)
+    {
+      job->status = JOB_OPEN_FAILED;
+      job->error = errno;
+      return;
+    }
+  job->digest = xalloc (mode->digest_length);
+  if (digest_file (mode, job->digest, f))
+    job->status = JOB_OK;
+  else
+    {
+      job->status = JOB_READ_FAILED;
+      job->error = errno;
+    }
+  fclose (f);
 }
 
+static void
+report_job(const struct hash_mode *mode, struct hash_job *job)
+{
+  if (job->status == JOB_OPEN_FAILED)
+    die ("Cannot open `%s': %s\n", job->name, STRERROR(job->error));
+  printf("%s: ", job->name);
+  if (job->status == JOB_READ_FAILED)
+    die("Reading `%s' failed: %s\n", job->name, STRERROR(job->error));
+  print_digest (mode, job->digest);
+  free (job->digest);
+  job->digest = NULL;
+}
+
+#if USE_THREADS
+/* Files are handed out to the worker threads in order, and the main
+   thread prints the results in the same order. */
+struct hash_queue
+{
+  const struct hash_mode *mode;
+
+  pthread_mutex_t lock;
+  pthread_cond_t done;
+  unsigned next;
+  unsigned count;
+  struct hash_job *jobs;
+};
+
+static void *
+hash_worker(void *arg)
+{
+  struct hash_queue *queue = arg;
+  for (;;)
+    {
+      struct hash_job *job;
+
+      pthread_mutex_lock (&queue->lock);
+      if (queue->next == queue->count)
+	{
+	  pthread_mutex_unlock (&queue->lock);
+	  return NULL;
+	}
+      job = &queue->jobs[queue->next++];
+      pthread_mutex_unlock (&queue->lock);
+
+      run_job (queue->mode, job);
+
+      pthread_mutex_lock (&queue->lock);
+      job->done = 1;
+      pthread_cond_broadcast (&queue->done);
+      pthread_mutex_unlock (&queue->lock);
+    }
+}
+
+static void
+hash_parallel(const struct hash_mode *mode,
+	      unsigned nthreads, unsigned count, struct hash_job *jobs)
+{
+  struct hash_queue queue;
+  pthread_t *threads;
+  unsigned i;
+
+  queue.mode = mode;
+  pthread_mutex_init (&queue.lock, NULL);
+  pthread_cond_init (&queue.done, NULL);
+  queue.next = 0;
+  queue.count = count;
+  queue.jobs = jobs;
+
+  if (nthreads > count)
+    nthreads = count;
+
+  threads = xalloc (nthreads * sizeof(*threads));
+  for (i = 0; i < nthreads; i++)
+    if (pthread_create (&threads[i], NULL, hash_worker, &queue))
+      die ("Creating thread failed.\n");
+
+  for (i = 0; i < count; i++)
+    {
+      pthread_mutex_lock (&queue.lock);
+      while (!jobs[i].done)
+	pthread_cond_wait (&queue.done, &queue.lock);
+      pthread_mutex_unlock (&queue.lock);
+
+      report_job (mode, &jobs[i]);
+    }
+
+  for (i = 0; i < nthreads; i++)
+    pthread_join (threads[i], NULL);
+
+  free (threads);
+  pthread_cond_destroy (&queue.done);
+  pthread_mutex_destroy (&queue.lock);
+}
+#endif /* USE_THREADS */
+
 static void
 usage (FILE *f)
 {
@@ -131,6 +535,10 @@ usage (FILE *f)
 	  "  --list              List supported hash algorithms.\n"
 	  "  -a, --algorithm=ALG Hash algorithm to use.\n"
 	  "  -l, --length=LENGTH Desired digest length (octets)\n"
+	  "  -j, --jobs=N        Hash up to N files in parallel, or with\n"
+	  "                      --tree, the chunks of each file.\n"
+	  "  --tree[=SIZE]       Tree hash over chunks of SIZE octets\n"
+	  "                      (default 1048576).\n"
 	  "  --raw               Raw binary output.\n");
 }
 
@@ -141,12 +549,13 @@ int
 main (int argc, char **argv)
 {
   const char *alg_name = NULL;
-  const struct nettle_hash *alg;
+  struct hash_mode mode;
+  char *tree_name = NULL;
   unsigned length = 0;
-  int raw = 0;
+  unsigned jobs = 1;
   int c;
 
-  enum { OPT_HELP = 0x300, OPT_RAW, OPT_LIST };
+  enum { OPT_HELP = 0x300, OPT_RAW, OPT_LIST, OPT_TREE };
   static const struct option options[] =
     {
       /* Name, args, flag, val */
@@ -154,13 +563,18 @@ main (int argc, char **argv)
       { "version", no_argument, NULL, 'V' },
       { "algorithm", required_argument, NULL, 'a' },
       { "length", required_argument, NULL, 'l' },
+      { "jobs", required_argument, NULL, 'j' },
+      { "tree", optional_argument, NULL, OPT_TREE },
       { "list", no_argument, NULL, OPT_LIST },
       { "raw", no_argument, NULL, OPT_RAW },
 
       { NULL, 0, NULL, 0 }
     };
 
-  while ( (c = getopt_long(argc, argv, "Va:l:", options, NULL)) != -1)
+  mode.raw = 0;
+  mode.chunk_size = 0;
+
+  while ( (c = getopt_long(argc, argv, "Va:l:j:", options, NULL)) != -1)
     switch (c)
       {
       default:
@@ -186,8 +600,29 @@ main (int argc, char **argv)
 	  length = arg;
 	}
 	break;
+      case 'j':
+	{
+	  int arg;
+	  arg = atoi (optarg);
+	  if (arg <= 0)
+	    die ("Invalid jobs argument: `%s'\n", optarg);
+	  jobs = arg;
+	}
+	break;
+      case OPT_TREE:
+	if (optarg)
+	  {
+	    int arg;
+	    arg = atoi (optarg);
+	    if (arg <= 0)
+	      die ("Invalid tree chunk size: `%s'\n", optarg);
+	    mode.chunk_size = arg;
+	  }
+	else
+	  mode.chunk_size = TREE_CHUNK_SIZE;
+	break;
       case OPT_RAW:
-	raw = 1;
+	mode.raw = 1;
 	break;
       case OPT_LIST:
 	list_algorithms();
@@ -198,39 +633,70 @@ main (int argc, char **argv)
     die("Algorithm argument (-a option) is mandatory.\n"
 	"See nettle-hash --help for further information.\n");
       
-  alg = nettle_lookup_hash (alg_name);
-  if (!alg)
+  mode.alg = nettle_lookup_hash (alg_name);
+  if (!mode.alg)
     die("Hash algorithm `%s' not supported or .\n"
 	"Use nettle-hash --list to list available algorithms.\n",
 	alg_name);
 
   if (length == 0)
-    length = alg->digest_size;
-  else if (length > alg->digest_size)
+    length = mode.alg->digest_size;
+  else if (length > mode.alg->digest_size)
     die ("Length argument %d too large for selected algorithm.\n",
 	 length);
-    
+  mode.digest_length = length;
+
+  /* Tree digests differ from plain ones, and are labeled so. */
+  if (mode.chunk_size)
+    {
+      tree_name = xalloc (strlen (mode.alg->name) + sizeof("-tree"));
+      sprintf (tree_name, "%s-tree", mode.alg->name);
+      mode.name = tree_name;
+      mode.threads = jobs;
+    }
+  else
+    {
+      mode.name = mode.alg->name;
+      mode.threads = 1;
+    }
+
   argv += optind;
   argc -= optind;
 
   if (argc == 0)
-    digest_file (alg, length, raw, stdin);
+    {
+      uint8_t *digest = xalloc (length);
+      if (!digest_file (&mode, digest, stdin))
+	die("Reading input failed: %s\n", STRERROR(errno));
+      print_digest (&mode, digest);
+      free (digest);
+    }
   else
     {
+      struct hash_job *files = xalloc (argc * sizeof(*files));
       int i;
       for (i = 0; i < argc; i++)
 	{
-	  FILE *f = fopen (argv[i], "rb");
-	  if (!f)
-	    die ("Cannot open `%s': %s\n", argv[i], STRERROR(errno));
-	  printf("%s: ", argv[i]);
-	  if (!digest_file (alg, length, raw, f))
-	    die("Reading `%s' failed: %s\n", argv[i], STRERROR(errno));
-	  fclose(f);
+	  files[i].name = argv[i];
+	  files[i].done = 0;
+	  files[i].digest = NULL;
 	}
+#if USE_THREADS
+      /* With --tree, the threads are used within each file instead. */
+      if (!mode.chunk_size && jobs > 1 && argc > 1)
+	hash_parallel (&mode, jobs, argc, files);
+      else
+#endif
+	for (i = 0; i < argc; i++)
+	  {
+	    run_job (&mode, &files[i]);
+	    report_job (&mode, &files[i]);
+	  }
+      free (files);
     }
   if (fflush(stdout) != 0 )
     die("Write failed: %s\n", STRERROR(errno));
 
+  free (tree_name);
   return EXIT_SUCCESS;
 }
@@ -41,6 +41,8 @@
 
 #include "output.h"
 
+#include "base16.h"
+
 /* For TMP_ALLOC */ 
 #include "nettle-internal.h"
 
@@ -78,6 +80,17 @@ sexp_put_raw_char(struct sexp_output *output, uint8_t c)
   output->soft_newline = 0;
 }
 
+static void
+sexp_put_raw_data(struct sexp_output *output,
+		  size_t length, const uint8_t *data)
+{
+  if (fwrite(data, 1, length, output->f) < length)
+    die("Write failed: %s\n", strerror(errno));
+
+  output->pos += length;
+  output->soft_newline = 0;
+}
+
 void
 sexp_put_newline(struct sexp_output *output,
 		 unsigned indent)
@@ -108,6 +121,35 @@ sexp_put_soft_newline(struct sexp_output *output,
   output->soft_newline = 1;
 }
 
+/* Writes encoded data, breaking lines at the line width. */
+static void
+sexp_put_encoded(struct sexp_output *output,
+		 size_t length, const char *encoded)
+{
+  while (length > 0)
+    {
+      size_t run = length;
+
+      if (output->line_width)
+	{
+	  unsigned limit = output->coding_indent + 10;
+	  if (limit < output->line_width)
+	    limit = output->line_width;
+
+	  if (output->pos >= limit)
+	    {
+	      sexp_put_newline(output, output->coding_indent);
+	      continue;
+	    }
+	  if (run > limit - output->pos)
+	    run = limit - output->pos;
+	}
+      sexp_put_raw_data(output, run, (const uint8_t *) encoded);
+      encoded += run;
+      length -= run;
+    }
+}
+
 void
 sexp_put_char(struct sexp_output *output, uint8_t c)
 {
@@ -117,21 +159,11 @@ sexp_put_char(struct sexp_output *output, uint8_t c)
       char encoded[2];
       unsigned done;
 
-      unsigned i;
-
       done = output->coding->encode_update(&output->base64, encoded,
 					   1, &c);
       assert(done <= sizeof(encoded));
-      
-      for (i = 0; i<done; i++)
-	{
-	  if (output->line_width
-	      && output->pos >= output->line_width
-	      && output->pos >= (output->coding_indent + 10))
-	    sexp_put_newline(output, output->coding_indent);
-	  
-	  sexp_put_raw_char(output, encoded[i]);
-	}
+
+      sexp_put_encoded(output, done, encoded);
     }
   else if (output->hash)
     output->hash->update(output->ctx, 1, &c);
@@ -139,14 +171,37 @@ sexp_put_char(struct sexp_output *output, uint8_t c)
     sexp_put_raw_char(output, c);
 }
 
+/* Input octets encoded at a time */
+#define CODING_BLOCK_SIZE 0x300
+
 void
 sexp_put_data(struct sexp_output *output,
 	      unsigned length, const uint8_t *data)
 {
-  unsigned i;
+  if (output->coding)
+    {
+      /* Enough for both base16 and base64. */
+      char encoded[BASE16_ENCODE_LENGTH(CODING_BLOCK_SIZE)];
+
+      while (length > 0)
+	{
+	  unsigned block = length < CODING_BLOCK_SIZE
+	    ? length : CODING_BLOCK_SIZE;
+	  size_t done;
+
+	  done = output->coding->encode_update(&output->base64, encoded,
+					       block, data);
+	  assert(done <= sizeof(encoded));
 
-  for (i = 0; i<length; i++)
-    sexp_put_char(output, data[i]);
+	  sexp_put_encoded(output, done, encoded);
+	  data += block;
+	  length -= block;
+	}
+    }
+  else if (output->hash)
+    output->hash->update(output->ctx, length, data);
+  else
+    sexp_put_raw_data(output, length, data);
 }
 
 static void
@@ -98,14 +98,24 @@ read_line(struct nettle_buffer *buffer, FILE *f)
     return -1;
 }
 
+#define READ_BLOCK_SIZE 0x4000
+
 static int
 read_file(struct nettle_buffer *buffer, FILE *f)
 {
-  int c;
-  
-  while ((c = getc(f)) != EOF)
-    if (!NETTLE_BUFFER_PUTC(buffer, c))
-      return 0;
+  size_t done;
+
+  do
+    {
+      uint8_t *p = nettle_buffer_space(buffer, READ_BLOCK_SIZE);
+      if (!p)
+	return 0;
+
+      done = fread(p, 1, READ_BLOCK_SIZE, f);
+      /* Give back the unused space */
+      buffer->size -= READ_BLOCK_SIZE - done;
+    }
+  while (done == READ_BLOCK_SIZE);
 
   if (ferror(f))
     {
@@ -273,27 +283,59 @@ decode_base64(struct nettle_buffer *buffer,
     }
 }
 
+#define RSA_KEY_BATCH 64
+
+/* The input may be a bundle of several keys. They are loaded in
+   batches, with a single limb array for the whole input, and no
+   allocation per key. */
 static int
 convert_rsa_public_key(struct nettle_buffer *buffer, size_t length, const uint8_t *data)
 {
-  struct rsa_public_key pub;
-  int res;
-  
-  rsa_public_key_init(&pub);
+  struct rsa_public_key keys[RSA_KEY_BATCH];
+  struct nettle_buffer output;
+  mp_size_t limbs_size = RSA_PUBLIC_KEY_DER_LIMBS(length);
+  mp_limb_t *limbs = xalloc(limbs_size * sizeof(*limbs));
+  int res = 1;
 
-  if (rsa_keypair_from_der(&pub, NULL, 0,
-			   length, data))
+  nettle_buffer_init_realloc(&output, NULL, nettle_xrealloc);
+
+  do
     {
-      /* Reuses the buffer */
-      nettle_buffer_reset(buffer);
-      res = rsa_keypair_to_sexp(buffer, NULL, &pub, NULL);
+      size_t nkeys = RSA_KEY_BATCH;
+      mp_size_t used = limbs_size;
+      size_t done = length;
+      size_t k;
+
+      if (!rsa_public_keys_from_der(&nkeys, keys, &used, limbs, 0,
+				    &done, data)
+	  || !nkeys)
+	{
+	  werror("Invalid PKCS#1 public key.\n");
+	  res = 0;
+	  break;
+	}
+
+      for (k = 0; k < nkeys; k++)
+	if (!rsa_keypair_to_sexp(&output, NULL, &keys[k], NULL))
+	  {
+	    res = 0;
+	    break;
+	  }
+
+      data += done;
+      length -= done;
     }
-  else
+  while (res && length > 0);
+
+  if (res)
     {
-      werror("Invalid PKCS#1 public key.\n");
-      res = 0;
+      /* Reuses the buffer */
+      nettle_buffer_reset(buffer);
+      res = nettle_buffer_copy(buffer, &output);
     }
-  rsa_public_key_clear(&pub);
+
+  nettle_buffer_clear(&output);
+  free(limbs);
   return res;
 }
 
@@ -0,0 +1,143 @@
+/* tree-hash.c
+
+   Chunked tree hashing over any hash function.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+
+#include "tree-hash.h"
+
+#include "macros.h"
+#include "nettle-internal.h"
+
+#define TREE_HASH_LEAF 0
+#define TREE_HASH_ROOT 1
+
+size_t
+tree_hash_leaf_count(size_t chunk_size, uint64_t length)
+{
+  assert (chunk_size > 0);
+  return length / chunk_size + (length % chunk_size != 0);
+}
+
+static void
+leaf_digest(const struct nettle_hash *hash, void *state,
+	    size_t length, const uint8_t *data, uint8_t *digest)
+{
+  static const uint8_t prefix = TREE_HASH_LEAF;
+
+  hash->init(state);
+  hash->update(state, 1, &prefix);
+  hash->update(state, length, data);
+  hash->digest(state, hash->digest_size, digest);
+}
+
+static void
+root_init(const struct nettle_hash *hash, void *state,
+	  size_t chunk_size, uint64_t length)
+{
+  uint8_t prefix[17];
+
+  prefix[0] = TREE_HASH_ROOT;
+  WRITE_UINT64(prefix + 1, (uint64_t) chunk_size);
+  WRITE_UINT64(prefix + 9, length);
+
+  hash->init(state);
+  hash->update(state, sizeof(prefix), prefix);
+}
+
+void
+tree_hash_leaves(const struct nettle_hash *hash, size_t chunk_size,
+		 size_t length, const uint8_t *data,
+		 size_t first, size_t count, uint8_t *leaves)
+{
+  TMP_DECL_ALIGN(state, NETTLE_MAX_HASH_CONTEXT_SIZE);
+  TMP_ALLOC_ALIGN(state, hash->context_size);
+
+  assert (first + count <= tree_hash_leaf_count (chunk_size, length));
+
+  for (; count > 0; count--, first++, leaves += hash->digest_size)
+    {
+      size_t offset = first * chunk_size;
+      size_t size = length - offset;
+      if (size > chunk_size)
+	size = chunk_size;
+
+      leaf_digest (hash, state, size, data + offset, leaves);
+    }
+}
+
+void
+tree_hash_root(const struct nettle_hash *hash, size_t chunk_size,
+	       uint64_t length, const uint8_t *leaves,
+	       size_t digest_length, uint8_t *digest)
+{
+  TMP_DECL_ALIGN(state, NETTLE_MAX_HASH_CONTEXT_SIZE);
+  TMP_ALLOC_ALIGN(state, hash->context_size);
+
+  root_init (hash, state, chunk_size, length);
+  hash->update(state,
+	       tree_hash_leaf_count (chunk_size, length) * hash->digest_size,
+	       leaves);
+  hash->digest(state, digest_length, digest);
+}
+
+void
+tree_hash(const struct nettle_hash *hash, size_t chunk_size,
+	  size_t length, const uint8_t *data,
+	  size_t digest_length, uint8_t *digest)
+{
+  TMP_DECL_ALIGN(root, NETTLE_MAX_HASH_CONTEXT_SIZE);
+  TMP_DECL_ALIGN(state, NETTLE_MAX_HASH_CONTEXT_SIZE);
+  TMP_DECL(leaf, uint8_t, NETTLE_MAX_HASH_DIGEST_SIZE);
+
+  TMP_ALLOC_ALIGN(root, hash->context_size);
+  TMP_ALLOC_ALIGN(state, hash->context_size);
+  TMP_ALLOC(leaf, hash->digest_size);
+
+  root_init (hash, root, chunk_size, length);
+
+  /* Leaves are fed to the root as they are computed, so no leaf
+     array is needed. */
+  for (; length > 0; length -= chunk_size, data += chunk_size)
+    {
+      if (length < chunk_size)
+	chunk_size = length;
+
+      leaf_digest (hash, state, chunk_size, data, leaf);
+      hash->update(root, hash->digest_size, leaf);
+    }
+  hash->digest(root, digest_length, digest);
+}
@@ -0,0 +1,83 @@
+/* tree-hash.h
+
+   Chunked tree hashing over any hash function.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#ifndef NETTLE_TREE_HASH_H_INCLUDED
+#define NETTLE_TREE_HASH_H_INCLUDED
+
+#include "nettle-meta.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Namespace mangling */
+#define tree_hash_leaf_count nettle_tree_hash_leaf_count
+#define tree_hash_leaves nettle_tree_hash_leaves
+#define tree_hash_root nettle_tree_hash_root
+#define tree_hash nettle_tree_hash
+
+/* The message is split into chunks of chunk_size octets, the last
+   one possibly shorter. Each leaf digest is H(0x00 || chunk), and the
+   root is H(0x01 || chunk_size || length || leaf_0 || ... ), with
+   the sizes as 64-bit big-endian numbers. Leaves can be computed
+   independently, e.g., by several threads, before the root. */
+
+size_t
+tree_hash_leaf_count(size_t chunk_size, uint64_t length);
+
+/* Computes count leaf digests, starting with leaf number first, of
+   the length octets at data. Writes count * hash->digest_size
+   octets to leaves. */
+void
+tree_hash_leaves(const struct nettle_hash *hash, size_t chunk_size,
+		 size_t length, const uint8_t *data,
+		 size_t first, size_t count, uint8_t *leaves);
+
+/* The leaves array must hold all leaf digests for a message of the
+   given length. */
+void
+tree_hash_root(const struct nettle_hash *hash, size_t chunk_size,
+	       uint64_t length, const uint8_t *leaves,
+	       size_t digest_length, uint8_t *digest);
+
+/* Sequential tree hash of a complete message. */
+void
+tree_hash(const struct nettle_hash *hash, size_t chunk_size,
+	  size_t length, const uint8_t *data,
+	  size_t digest_length, uint8_t *digest);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* NETTLE_TREE_HASH_H_INCLUDED */
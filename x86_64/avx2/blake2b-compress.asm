@@ -0,0 +1,229 @@
+C x86_64/avx2/blake2b-compress.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+	.file "blake2b-compress.asm"
+
+define(<STATE>, <%rdi>)
+define(<BLOCK>, <%rsi>)
+define(<T_LOW>, <%rdx>)
+define(<T_HIGH>, <%rcx>)
+define(<F>, <%r8>)
+
+C Rows of the working state
+define(<XA>, <%ymm0>)
+define(<XB>, <%ymm1>)
+define(<XC>, <%ymm2>)
+define(<XD>, <%ymm3>)
+define(<M0>, <%ymm4>)
+define(<M1>, <%ymm5>)
+define(<M2>, <%ymm6>)
+define(<M3>, <%ymm7>)
+define(<T0>, <%ymm8>)
+define(<ROT16>, <%ymm9>)
+define(<ROT24>, <%ymm10>)
+define(<T1>, <%xmm11>)
+define(<T1Y>, <%ymm11>)
+C The same registers, for instructions using the low halves only
+define(<XDX>, <%xmm3>)
+define(<M0X>, <%xmm4>)
+define(<M1X>, <%xmm5>)
+define(<M2X>, <%xmm6>)
+define(<M3X>, <%xmm7>)
+
+C LOAD_MSG(M, MX, i0, i1, i2, i3)
+C Collects message words i0, ..., i3 into M, with low half MX.
+define(<LOAD_MSG>, <
+	vmovq	eval(8*$5)(BLOCK), T1
+	vpinsrq	<$>1, eval(8*$6)(BLOCK), T1, T1
+	vmovq	eval(8*$3)(BLOCK), $2
+	vpinsrq	<$>1, eval(8*$4)(BLOCK), $2, $2
+	vinserti128	<$>1, T1, $1, $1
+>)
+
+C G(X, Y), four G functions in parallel, one per column
+define(<G>, <
+	vpaddq	$1, XA, XA
+	vpaddq	XB, XA, XA
+	vpxor	XA, XD, XD
+	vpshufd	<$>0xb1, XD, XD
+	vpaddq	XD, XC, XC
+	vpxor	XC, XB, XB
+	vpshufb	ROT24, XB, XB
+	vpaddq	$2, XA, XA
+	vpaddq	XB, XA, XA
+	vpxor	XA, XD, XD
+	vpshufb	ROT16, XD, XD
+	vpaddq	XD, XC, XC
+	vpxor	XC, XB, XB
+	vpaddq	XB, XB, T0
+	vpsrlq	<$>63, XB, XB
+	vpor	T0, XB, XB
+>)
+
+C ROUND, with the message words in M0, ..., M3. Rotating the rows
+C moves the diagonals into columns, and back again.
+define(<ROUND>, <
+	G(M0, M1)
+	vpermq	<$>0x39, XB, XB
+	vpermq	<$>0x4e, XC, XC
+	vpermq	<$>0x93, XD, XD
+	G(M2, M3)
+	vpermq	<$>0x93, XB, XB
+	vpermq	<$>0x4e, XC, XC
+	vpermq	<$>0x39, XD, XD
+>)
+
+	C _blake2b_compress(uint64_t *state, const uint8_t *block,
+	C                   uint64_t t_low, uint64_t t_high, uint64_t f)
+
+	.text
+	ALIGN(32)
+.Liv:
+	.quad	0x6A09E667F3BCC908, 0xBB67AE8584CAA73B
+	.quad	0x3C6EF372FE94F82B, 0xA54FF53A5F1D36F1
+	.quad	0x510E527FADE682D1, 0x9B05688C2B3E6C1F
+	.quad	0x1F83D9ABFB41BD6B, 0x5BE0CD19137E2179
+C Byte shuffles rotating each 64-bit word right by 16 and 24 bits.
+.Lrot16:
+	.byte	2,3,4,5,6,7,0,1, 10,11,12,13,14,15,8,9
+	.byte	2,3,4,5,6,7,0,1, 10,11,12,13,14,15,8,9
+.Lrot24:
+	.byte	3,4,5,6,7,0,1,2, 11,12,13,14,15,8,9,10
+	.byte	3,4,5,6,7,0,1,2, 11,12,13,14,15,8,9,10
+PROLOGUE(_nettle_blake2b_compress)
+	W64_ENTRY(5, 12)
+	vmovdqu	(STATE), XA
+	vmovdqu	32(STATE), XB
+	vmovdqa	.Liv(%rip), XC
+	vmovdqa	.Lrot16(%rip), ROT16
+	vmovdqa	.Lrot24(%rip), ROT24
+	vmovq	T_LOW, T1
+	vpinsrq	$1, T_HIGH, T1, T1
+	vmovq	F, XDX
+	vinserti128	$1, XDX, T1Y, XD
+	vpxor	.Liv+32(%rip), XD, XD
+
+	C Round 0
+	LOAD_MSG(M0, M0X, 0, 2, 4, 6)
+	LOAD_MSG(M1, M1X, 1, 3, 5, 7)
+	LOAD_MSG(M2, M2X, 8, 10, 12, 14)
+	LOAD_MSG(M3, M3X, 9, 11, 13, 15)
+	ROUND
+
+	C Round 1
+	LOAD_MSG(M0, M0X, 14, 4, 9, 13)
+	LOAD_MSG(M1, M1X, 10, 8, 15, 6)
+	LOAD_MSG(M2, M2X, 1, 0, 11, 5)
+	LOAD_MSG(M3, M3X, 12, 2, 7, 3)
+	ROUND
+
+	C Round 2
+	LOAD_MSG(M0, M0X, 11, 12, 5, 15)
+	LOAD_MSG(M1, M1X, 8, 0, 2, 13)
+	LOAD_MSG(M2, M2X, 10, 3, 7, 9)
+	LOAD_MSG(M3, M3X, 14, 6, 1, 4)
+	ROUND
+
+	C Round 3
+	LOAD_MSG(M0, M0X, 7, 3, 13, 11)
+	LOAD_MSG(M1, M1X, 9, 1, 12, 14)
+	LOAD_MSG(M2, M2X, 2, 5, 4, 15)
+	LOAD_MSG(M3, M3X, 6, 10, 0, 8)
+	ROUND
+
+	C Round 4
+	LOAD_MSG(M0, M0X, 9, 5, 2, 10)
+	LOAD_MSG(M1, M1X, 0, 7, 4, 15)
+	LOAD_MSG(M2, M2X, 14, 11, 6, 3)
+	LOAD_MSG(M3, M3X, 1, 12, 8, 13)
+	ROUND
+
+	C Round 5
+	LOAD_MSG(M0, M0X, 2, 6, 0, 8)
+	LOAD_MSG(M1, M1X, 12, 10, 11, 3)
+	LOAD_MSG(M2, M2X, 4, 7, 15, 1)
+	LOAD_MSG(M3, M3X, 13, 5, 14, 9)
+	ROUND
+
+	C Round 6
+	LOAD_MSG(M0, M0X, 12, 1, 14, 4)
+	LOAD_MSG(M1, M1X, 5, 15, 13, 10)
+	LOAD_MSG(M2, M2X, 0, 6, 9, 8)
+	LOAD_MSG(M3, M3X, 7, 3, 2, 11)
+	ROUND
+
+	C Round 7
+	LOAD_MSG(M0, M0X, 13, 7, 12, 3)
+	LOAD_MSG(M1, M1X, 11, 14, 1, 9)
+	LOAD_MSG(M2, M2X, 5, 15, 8, 2)
+	LOAD_MSG(M3, M3X, 0, 4, 6, 10)
+	ROUND
+
+	C Round 8
+	LOAD_MSG(M0, M0X, 6, 14, 11, 0)
+	LOAD_MSG(M1, M1X, 15, 9, 3, 8)
+	LOAD_MSG(M2, M2X, 12, 13, 1, 10)
+	LOAD_MSG(M3, M3X, 2, 7, 4, 5)
+	ROUND
+
+	C Round 9
+	LOAD_MSG(M0, M0X, 10, 8, 7, 1)
+	LOAD_MSG(M1, M1X, 2, 4, 6, 5)
+	LOAD_MSG(M2, M2X, 15, 9, 3, 13)
+	LOAD_MSG(M3, M3X, 11, 14, 12, 0)
+	ROUND
+
+	C Round 10
+	LOAD_MSG(M0, M0X, 0, 2, 4, 6)
+	LOAD_MSG(M1, M1X, 1, 3, 5, 7)
+	LOAD_MSG(M2, M2X, 8, 10, 12, 14)
+	LOAD_MSG(M3, M3X, 9, 11, 13, 15)
+	ROUND
+
+	C Round 11
+	LOAD_MSG(M0, M0X, 14, 4, 9, 13)
+	LOAD_MSG(M1, M1X, 10, 8, 15, 6)
+	LOAD_MSG(M2, M2X, 1, 0, 11, 5)
+	LOAD_MSG(M3, M3X, 12, 2, 7, 3)
+	ROUND
+
+	vpxor	XC, XA, XA
+	vpxor	(STATE), XA, XA
+	vmovdqu	XA, (STATE)
+	vpxor	XD, XB, XB
+	vpxor	32(STATE), XB, XB
+	vmovdqu	XB, 32(STATE)
+
+	vzeroupper
+	W64_EXIT(5, 12)
+	ret
+EPILOGUE(_nettle_blake2b_compress)
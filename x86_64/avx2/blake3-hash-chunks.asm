@@ -0,0 +1,386 @@
+C x86_64/avx2/blake3-hash-chunks.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+	.file "blake3-hash-chunks.asm"
+
+C Hashes up to 8 chunks, one per 32-bit lane of the ymm registers.
+C Each message block is transposed into the stack frame, so that
+C vector i holds word i of the current block of all chunks.
+
+define(<CVS>, <%rdi>)
+define(<KEY>, <%rsi>)
+define(<FLAGS>, <%edx>)
+define(<COUNTER>, <%rcx>)
+define(<COUNT>, <%r8>)
+define(<DATA>, <%r9>)
+define(<BOFF>, <%r10>)	C Offset of the current block
+define(<BFLAGS>, <%r11d>)	C Flags for the current block
+
+define(<V0>, <%ymm0>)
+define(<V1>, <%ymm1>)
+define(<V2>, <%ymm2>)
+define(<V3>, <%ymm3>)
+define(<V4>, <%ymm4>)
+define(<V5>, <%ymm5>)
+define(<V6>, <%ymm6>)
+define(<V7>, <%ymm7>)
+define(<V8>, <%ymm8>)
+define(<V9>, <%ymm9>)
+define(<V10>, <%ymm10>)
+define(<V11>, <%ymm11>)
+define(<V12>, <%ymm12>)
+define(<V13>, <%ymm13>)
+define(<V14>, <%ymm14>)
+define(<V15>, <%ymm15>)
+define(<V15X>, <%xmm15>)
+
+C Stack frame, 32-byte aligned
+define(<MSG>, <eval(32*($1))>)	C 16 vectors, the transposed block
+define(<H>, <eval(512 + 32*($1))>)	C 8 vectors, chaining values
+define(<CTR>, <eval(768 + 32*($1))>)	C Counters, low and high halves
+define(<SPILL>, <832(%rsp)>)
+define(<PTRS>, <eval(864 + 8*($1))>)	C 8 pointers, one per lane
+define(<FRAME_SIZE>, <928>)
+
+C ADD4(X0, X1, X2, X3, Y0, Y1, Y2, Y3): Yi += Xi
+define(<ADD4>, <
+	vpaddd	$1, $5, $5
+	vpaddd	$2, $6, $6
+	vpaddd	$3, $7, $7
+	vpaddd	$4, $8, $8
+>)
+
+C XOR4(X0, X1, X2, X3, Y0, Y1, Y2, Y3): Yi ^= Xi
+define(<XOR4>, <
+	vpxor	$1, $5, $5
+	vpxor	$2, $6, $6
+	vpxor	$3, $7, $7
+	vpxor	$4, $8, $8
+>)
+
+C SHUF4(MASK, Y0, Y1, Y2, Y3), for rotations by multiples of 8
+define(<SHUF4>, <
+	vpshufb	$1, $2, $2
+	vpshufb	$1, $3, $3
+	vpshufb	$1, $4, $4
+	vpshufb	$1, $5, $5
+>)
+
+C ROTR4(COUNT, Y0, Y1, Y2, Y3), using V8 as temporary.
+define(<ROTR4>, <
+	vmovdqa	V8, SPILL
+	vpsrld	<$>$1, $2, V8
+	vpslld	<$>eval(32 - $1), $2, $2
+	vpor	V8, $2, $2
+	vpsrld	<$>$1, $3, V8
+	vpslld	<$>eval(32 - $1), $3, $3
+	vpor	V8, $3, $3
+	vpsrld	<$>$1, $4, V8
+	vpslld	<$>eval(32 - $1), $4, $4
+	vpor	V8, $4, $4
+	vpsrld	<$>$1, $5, V8
+	vpslld	<$>eval(32 - $1), $5, $5
+	vpor	V8, $5, $5
+	vmovdqa	SPILL, V8
+>)
+
+define(<M>, <MSG($1)(%rsp)>)
+
+C The a words are the same for the columns and the diagonals, while
+C COLUMNS and DIAGONALS select the b, c and d words for G4.
+define(<A0>, <V0>)
+define(<A1>, <V1>)
+define(<A2>, <V2>)
+define(<A3>, <V3>)
+
+define(<COLUMNS>, <
+	define(<B0>, <V4>)define(<B1>, <V5>)define(<B2>, <V6>)define(<B3>, <V7>)
+	define(<C0>, <V8>)define(<C1>, <V9>)define(<C2>, <V10>)define(<C3>, <V11>)
+	define(<D0>, <V12>)define(<D1>, <V13>)define(<D2>, <V14>)define(<D3>, <V15>)
+>)
+
+define(<DIAGONALS>, <
+	define(<B0>, <V5>)define(<B1>, <V6>)define(<B2>, <V7>)define(<B3>, <V4>)
+	define(<C0>, <V10>)define(<C1>, <V11>)define(<C2>, <V8>)define(<C3>, <V9>)
+	define(<D0>, <V15>)define(<D1>, <V12>)define(<D2>, <V13>)define(<D3>, <V14>)
+>)
+
+C G4(X0, Y0, X1, Y1, X2, Y2, X3, Y3), four G functions in parallel,
+C with message word indices Xi and Yi.
+define(<G4>, <
+	ADD4(M($1), M($3), M($5), M($7), A0, A1, A2, A3)
+	ADD4(B0, B1, B2, B3, A0, A1, A2, A3)
+	XOR4(A0, A1, A2, A3, D0, D1, D2, D3)
+	SHUF4(.Lrot16(%rip), D0, D1, D2, D3)
+	ADD4(D0, D1, D2, D3, C0, C1, C2, C3)
+	XOR4(C0, C1, C2, C3, B0, B1, B2, B3)
+	ROTR4(12, B0, B1, B2, B3)
+	ADD4(M($2), M($4), M($6), M($8), A0, A1, A2, A3)
+	ADD4(B0, B1, B2, B3, A0, A1, A2, A3)
+	XOR4(A0, A1, A2, A3, D0, D1, D2, D3)
+	SHUF4(.Lrot8(%rip), D0, D1, D2, D3)
+	ADD4(D0, D1, D2, D3, C0, C1, C2, C3)
+	XOR4(C0, C1, C2, C3, B0, B1, B2, B3)
+	ROTR4(7, B0, B1, B2, B3)
+>)
+
+C LOAD_ROWS(OFFSET): Reads 8 words at OFFSET in the current block of
+C each lane into V0, ..., V7.
+define(<LOAD_ROWS>, <
+	mov	PTRS(0)(%rsp), %rax
+	vmovdqu	$1(%rax, BOFF), V0
+	mov	PTRS(1)(%rsp), %rax
+	vmovdqu	$1(%rax, BOFF), V1
+	mov	PTRS(2)(%rsp), %rax
+	vmovdqu	$1(%rax, BOFF), V2
+	mov	PTRS(3)(%rsp), %rax
+	vmovdqu	$1(%rax, BOFF), V3
+	mov	PTRS(4)(%rsp), %rax
+	vmovdqu	$1(%rax, BOFF), V4
+	mov	PTRS(5)(%rsp), %rax
+	vmovdqu	$1(%rax, BOFF), V5
+	mov	PTRS(6)(%rsp), %rax
+	vmovdqu	$1(%rax, BOFF), V6
+	mov	PTRS(7)(%rsp), %rax
+	vmovdqu	$1(%rax, BOFF), V7
+>)
+
+C TRANSPOSE(OFFSET): Transposes the 8x8 matrix of words in V0, ...,
+C V7, and stores the rows at OFFSET in the stack frame. Clobbers all
+C ymm registers.
+define(<TRANSPOSE>, <
+	vpunpckldq	V1, V0, V8
+	vpunpckhdq	V1, V0, V9
+	vpunpckldq	V3, V2, V10
+	vpunpckhdq	V3, V2, V11
+	vpunpckldq	V5, V4, V12
+	vpunpckhdq	V5, V4, V13
+	vpunpckldq	V7, V6, V14
+	vpunpckhdq	V7, V6, V15
+	vpunpcklqdq	V10, V8, V0
+	vpunpckhqdq	V10, V8, V1
+	vpunpcklqdq	V11, V9, V2
+	vpunpckhqdq	V11, V9, V3
+	vpunpcklqdq	V14, V12, V4
+	vpunpckhqdq	V14, V12, V5
+	vpunpcklqdq	V15, V13, V6
+	vpunpckhqdq	V15, V13, V7
+	vperm2i128	<$>0x20, V4, V0, V8
+	vperm2i128	<$>0x20, V5, V1, V9
+	vperm2i128	<$>0x20, V6, V2, V10
+	vperm2i128	<$>0x20, V7, V3, V11
+	vperm2i128	<$>0x31, V4, V0, V12
+	vperm2i128	<$>0x31, V5, V1, V13
+	vperm2i128	<$>0x31, V6, V2, V14
+	vperm2i128	<$>0x31, V7, V3, V15
+	vmovdqa	V8, eval($1)(%rsp)
+	vmovdqa	V9, eval($1 + 32)(%rsp)
+	vmovdqa	V10, eval($1 + 64)(%rsp)
+	vmovdqa	V11, eval($1 + 96)(%rsp)
+	vmovdqa	V12, eval($1 + 128)(%rsp)
+	vmovdqa	V13, eval($1 + 160)(%rsp)
+	vmovdqa	V14, eval($1 + 192)(%rsp)
+	vmovdqa	V15, eval($1 + 224)(%rsp)
+>)
+
+	C _blake3_hash_chunks(uint32_t *cvs, const uint32_t *key,
+	C                     uint32_t flags, uint64_t counter,
+	C                     unsigned count, const uint8_t *data)
+
+	.text
+	ALIGN(32)
+C Byte shuffles rotating each 32-bit word right by 16 and 8 bits.
+.Lrot16:
+	.byte	2,3,0,1, 6,7,4,5, 10,11,8,9, 14,15,12,13
+	.byte	2,3,0,1, 6,7,4,5, 10,11,8,9, 14,15,12,13
+.Lrot8:
+	.byte	1,2,3,0, 5,6,7,4, 9,10,11,8, 13,14,15,12
+	.byte	1,2,3,0, 5,6,7,4, 9,10,11,8, 13,14,15,12
+.Liv:
+	.long	0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A
+.Lblock_size:
+	.long	64
+PROLOGUE(_nettle_blake3_hash_chunks)
+	W64_ENTRY(6, 16)
+	push	%rbp
+	mov	%rsp, %rbp
+	sub	$FRAME_SIZE, %rsp
+	and	$-32, %rsp
+
+	C Lane pointers and counters. Unused lanes repeat the first
+	C chunk, and are discarded.
+	mov	XREG(COUNT), XREG(COUNT)
+	xor	XREG(BOFF), XREG(BOFF)
+.Lsetup:
+	mov	BOFF, %rax
+	shl	$10, %rax
+	xor	XREG(%r11), XREG(%r11)
+	cmp	COUNT, BOFF
+	cmovnc	%r11, %rax
+	add	DATA, %rax
+	mov	%rax, PTRS(0)(%rsp, BOFF, 8)
+	lea	(COUNTER, BOFF), %rax
+	mov	XREG(%rax), CTR(0)(%rsp, BOFF, 4)
+	shr	$32, %rax
+	mov	XREG(%rax), CTR(1)(%rsp, BOFF, 4)
+	inc	BOFF
+	cmp	$8, BOFF
+	jne	.Lsetup
+
+	vpbroadcastd	(KEY), V0
+	vpbroadcastd	4(KEY), V1
+	vpbroadcastd	8(KEY), V2
+	vpbroadcastd	12(KEY), V3
+	vpbroadcastd	16(KEY), V4
+	vpbroadcastd	20(KEY), V5
+	vpbroadcastd	24(KEY), V6
+	vpbroadcastd	28(KEY), V7
+	xor	XREG(BOFF), XREG(BOFF)
+
+	ALIGN(16)
+.Loop:
+	vmovdqa	V0, H(0)(%rsp)
+	vmovdqa	V1, H(1)(%rsp)
+	vmovdqa	V2, H(2)(%rsp)
+	vmovdqa	V3, H(3)(%rsp)
+	vmovdqa	V4, H(4)(%rsp)
+	vmovdqa	V5, H(5)(%rsp)
+	vmovdqa	V6, H(6)(%rsp)
+	vmovdqa	V7, H(7)(%rsp)
+
+	LOAD_ROWS(0)
+	TRANSPOSE(MSG(0))
+	LOAD_ROWS(32)
+	TRANSPOSE(MSG(8))
+
+	C Flags, with CHUNK_START for the first block, and CHUNK_END
+	C for the last.
+	mov	FLAGS, BFLAGS
+	xor	%eax, %eax
+	test	BOFF, BOFF
+	sete	%al
+	or	%eax, BFLAGS
+	cmp	$960, BOFF
+	sete	%al
+	add	%eax, %eax
+	or	%eax, BFLAGS
+
+	vmovdqa	H(0)(%rsp), V0
+	vmovdqa	H(1)(%rsp), V1
+	vmovdqa	H(2)(%rsp), V2
+	vmovdqa	H(3)(%rsp), V3
+	vmovdqa	H(4)(%rsp), V4
+	vmovdqa	H(5)(%rsp), V5
+	vmovdqa	H(6)(%rsp), V6
+	vmovdqa	H(7)(%rsp), V7
+	vpbroadcastd	.Liv(%rip), V8
+	vpbroadcastd	.Liv+4(%rip), V9
+	vpbroadcastd	.Liv+8(%rip), V10
+	vpbroadcastd	.Liv+12(%rip), V11
+	vmovdqa	CTR(0)(%rsp), V12
+	vmovdqa	CTR(1)(%rsp), V13
+	vpbroadcastd	.Lblock_size(%rip), V14
+	vmovd	BFLAGS, V15X
+	vpbroadcastd	V15X, V15
+
+	C Round 0
+	COLUMNS
+	G4(0, 1, 2, 3, 4, 5, 6, 7)
+	DIAGONALS
+	G4(8, 9, 10, 11, 12, 13, 14, 15)
+
+	C Round 1
+	COLUMNS
+	G4(2, 6, 3, 10, 7, 0, 4, 13)
+	DIAGONALS
+	G4(1, 11, 12, 5, 9, 14, 15, 8)
+
+	C Round 2
+	COLUMNS
+	G4(3, 4, 10, 12, 13, 2, 7, 14)
+	DIAGONALS
+	G4(6, 5, 9, 0, 11, 15, 8, 1)
+
+	C Round 3
+	COLUMNS
+	G4(10, 7, 12, 9, 14, 3, 13, 15)
+	DIAGONALS
+	G4(4, 0, 11, 2, 5, 8, 1, 6)
+
+	C Round 4
+	COLUMNS
+	G4(12, 13, 9, 11, 15, 10, 14, 8)
+	DIAGONALS
+	G4(7, 2, 5, 3, 0, 1, 6, 4)
+
+	C Round 5
+	COLUMNS
+	G4(9, 14, 11, 5, 8, 12, 15, 1)
+	DIAGONALS
+	G4(13, 3, 0, 10, 2, 6, 4, 7)
+
+	C Round 6
+	COLUMNS
+	G4(11, 15, 5, 0, 1, 9, 8, 6)
+	DIAGONALS
+	G4(14, 10, 2, 12, 3, 4, 7, 13)
+
+	vpxor	V8, V0, V0
+	vpxor	V9, V1, V1
+	vpxor	V10, V2, V2
+	vpxor	V11, V3, V3
+	vpxor	V12, V4, V4
+	vpxor	V13, V5, V5
+	vpxor	V14, V6, V6
+	vpxor	V15, V7, V7
+
+	add	$64, BOFF
+	cmp	$1024, BOFF
+	jne	.Loop
+
+	C Transpose the chaining values back to one row per lane, and
+	C store the rows of the used lanes.
+	TRANSPOSE(MSG(0))
+	xor	%eax, %eax
+.Lstore:
+	vmovdqa	MSG(0)(%rsp, %rax), V0
+	vmovdqu	V0, (CVS, %rax)
+	add	$32, %rax
+	dec	XREG(COUNT)
+	jnz	.Lstore
+
+	mov	%rbp, %rsp
+	pop	%rbp
+	vzeroupper
+	W64_EXIT(6, 16)
+	ret
+EPILOGUE(_nettle_blake3_hash_chunks)
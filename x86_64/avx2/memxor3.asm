@@ -0,0 +1,209 @@
+C x86_64/avx2/memxor3.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+C Register usage:
+define(<DST>, <%rax>) C Originally in %rdi
+define(<AP>, <%rsi>)
+define(<BP>, <%rdx>)
+define(<N>, <%rcx>)
+define(<TMP>, <%r8>)
+
+C The same code is used for avx2 and avx512, depending on USE_AVX512.
+ifelse(USE_AVX512, yes, <
+define(<VSIZE>, <64>)
+define(<VXOR>, <vpxorq>)
+define(<VLOAD>, <vmovdqu64>)
+define(<VSTORE>, <vmovdqu64>)
+define(<V0>, <%zmm0>)
+define(<V1>, <%zmm1>)
+define(<V2>, <%zmm2>)
+define(<V3>, <%zmm3>)
+>, <
+define(<VSIZE>, <32>)
+define(<VXOR>, <vpxor>)
+define(<VLOAD>, <vmovdqu>)
+define(<VSTORE>, <vmovdqu>)
+define(<V0>, <%ymm0>)
+define(<V1>, <%ymm1>)
+define(<V2>, <%ymm2>)
+define(<V3>, <%ymm3>)
+>)
+define(<VMASK>, <eval(VSIZE - 1)>)
+
+C Destination areas of at least this size are written with
+C non-temporal stores, to not evict everything else from the cache.
+C It should be larger than the last level cache, but that is not
+C known here.
+define(<STREAM_THRESHOLD>, <0x1000000>)
+
+	.file "memxor3.asm"
+
+	.text
+
+	C memxor3(void *dst, const void *a, const void *b, size_t n)
+	C 	          %rdi              %rsi              %rdx      %rcx
+	C Processes data in descending order, like the generic code, to
+	C allow the overlap used by cbc_decrypt.
+	ALIGN(16)
+
+PROLOGUE(nettle_memxor3)
+	W64_ENTRY(4, 0)
+	mov	%rdi, DST
+	cmp	$VSIZE, N
+	jnc	.Lvec_case
+
+	C Short inputs, and what's left from the vector loops. Using
+	C only xmm registers needs no vzeroupper.
+.Lxmm_next:
+	sub	$16, N
+	jc	.Lxmm_done
+.Lxmm_loop:
+	vmovdqu	(AP, N), %xmm0
+	vpxor	(BP, N), %xmm0, %xmm0
+	vmovdqu	%xmm0, (DST, N)
+	sub	$16, N
+	jnc	.Lxmm_loop
+.Lxmm_done:
+	add	$16, N
+	jz	.Ldone
+
+	sub	$8, N
+	jc	.Lword_done
+.Lword_loop:
+	mov	(AP, N), TMP
+	xor	(BP, N), TMP
+	mov	TMP, (DST, N)
+	sub	$8, N
+	jnc	.Lword_loop
+.Lword_done:
+	add	$8, N
+	jz	.Ldone
+
+.Lbyte_loop:
+	movb	-1(AP, N), LREG(TMP)
+	xorb	-1(BP, N), LREG(TMP)
+	movb	LREG(TMP), -1(DST, N)
+	sub	$1, N
+	jnz	.Lbyte_loop
+
+.Ldone:
+	W64_EXIT(4, 0)
+	ret
+
+.Lvec_case:
+	cmp	$eval(4*VSIZE), N
+	jc	.Lvec_next
+
+	C Align the end of the destination area.
+.Lalign_bytes:
+	lea	(DST, N), TMP
+	test	$7, TMP
+	jz	.Lalign_words
+	sub	$1, N
+	movb	(AP, N), LREG(TMP)
+	xorb	(BP, N), LREG(TMP)
+	movb	LREG(TMP), (DST, N)
+	jmp	.Lalign_bytes
+
+.Lalign_words:
+	test	$VMASK, TMP
+	jz	.Laligned
+	sub	$8, N
+	mov	(AP, N), TMP
+	xor	(BP, N), TMP
+	mov	TMP, (DST, N)
+	lea	(DST, N), TMP
+	jmp	.Lalign_words
+
+.Laligned:
+	cmp	$STREAM_THRESHOLD, N
+	jnc	.Lstream
+	sub	$eval(4*VSIZE), N
+	jc	.Lvec4_done
+
+	ALIGN(16)
+.Lvec4_loop:
+	VLOAD	eval(3*VSIZE)(AP, N), V0
+	VLOAD	eval(2*VSIZE)(AP, N), V1
+	VLOAD	eval(1*VSIZE)(AP, N), V2
+	VLOAD	(AP, N), V3
+	VXOR	eval(3*VSIZE)(BP, N), V0, V0
+	VXOR	eval(2*VSIZE)(BP, N), V1, V1
+	VXOR	eval(1*VSIZE)(BP, N), V2, V2
+	VXOR	(BP, N), V3, V3
+	VSTORE	V0, eval(3*VSIZE)(DST, N)
+	VSTORE	V1, eval(2*VSIZE)(DST, N)
+	VSTORE	V2, eval(1*VSIZE)(DST, N)
+	VSTORE	V3, (DST, N)
+	sub	$eval(4*VSIZE), N
+	jnc	.Lvec4_loop
+
+.Lvec4_done:
+	add	$eval(4*VSIZE), N
+	jmp	.Lvec_next
+
+.Lvec_loop:
+	VLOAD	(AP, N), V0
+	VXOR	(BP, N), V0, V0
+	VSTORE	V0, (DST, N)
+.Lvec_next:
+	sub	$VSIZE, N
+	jnc	.Lvec_loop
+	add	$VSIZE, N
+	vzeroupper
+	jmp	.Lxmm_next
+
+.Lstream:
+	sub	$eval(4*VSIZE), N
+
+	ALIGN(16)
+.Lstream_loop:
+	VLOAD	eval(3*VSIZE)(AP, N), V0
+	VLOAD	eval(2*VSIZE)(AP, N), V1
+	VLOAD	eval(1*VSIZE)(AP, N), V2
+	VLOAD	(AP, N), V3
+	VXOR	eval(3*VSIZE)(BP, N), V0, V0
+	VXOR	eval(2*VSIZE)(BP, N), V1, V1
+	VXOR	eval(1*VSIZE)(BP, N), V2, V2
+	VXOR	(BP, N), V3, V3
+	vmovntdq V0, eval(3*VSIZE)(DST, N)
+	vmovntdq V1, eval(2*VSIZE)(DST, N)
+	vmovntdq V2, eval(1*VSIZE)(DST, N)
+	vmovntdq V3, (DST, N)
+	sub	$eval(4*VSIZE), N
+	jnc	.Lstream_loop
+
+	C Order the non-temporal stores before any later stores.
+	sfence
+	add	$eval(4*VSIZE), N
+	jmp	.Lvec_next
+EPILOGUE(nettle_memxor3)
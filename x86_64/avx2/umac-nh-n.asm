@@ -0,0 +1,139 @@
+C x86_64/avx2/umac-nh-n.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+
+define(<OUT>, <%rdi>)
+define(<ITERS>, <%rsi>)
+define(<KEY>, <%rdx>)
+define(<LENGTH>, <%rcx>)
+define(<MSG>, <%r8>)
+
+C Each 64-bit lane holds one 32-bit message or key word, zero
+C extended, so that one vpmuludq computes the four products of an
+C NH step for one iteration.
+define(<A>, <%ymm0>)
+define(<B>, <%ymm1>)
+define(<K0>, <%ymm2>)
+define(<K1>, <%ymm3>)
+define(<K2>, <%ymm4>)
+define(<K3>, <%ymm5>)
+define(<K4>, <%ymm6>)
+define(<T0>, <%ymm7>)
+define(<T1>, <%ymm8>)
+define(<Y0>, <%ymm9>)
+define(<Y1>, <%ymm10>)
+define(<Y2>, <%ymm11>)
+define(<Y3>, <%ymm12>)
+
+define(<XT0>, <%xmm7>)
+define(<XT1>, <%xmm8>)
+
+C NH_STEP(ka, kb, y)
+C Adds (a + ka) * (b + kb), lanewise, to y
+define(<NH_STEP>, <
+	vpaddd	A, $1, T0
+	vpaddd	B, $2, T1
+	vpmuludq T0, T1, T0
+	vpaddq	T0, $3, $3
+>)
+
+C NH_LOOP(label, n)
+C Iteration i uses key words 4i to 4i+7, so the n iterations share
+C n+1 key vectors.
+define(<NH_LOOP>, <
+$1:
+	vpmovzxdq (MSG), A
+	vpmovzxdq 16(MSG), B
+	vpmovzxdq (KEY), K0
+	vpmovzxdq 16(KEY), K1
+	vpmovzxdq 32(KEY), K2
+	NH_STEP(K0, K1, Y0)
+	NH_STEP(K1, K2, Y1)
+ifelse($2, 2, , <
+	vpmovzxdq 48(KEY), K3
+	NH_STEP(K2, K3, Y2)
+>)
+ifelse($2, 4, <
+	vpmovzxdq 64(KEY), K4
+	NH_STEP(K3, K4, Y3)
+>)
+	lea	32(MSG), MSG
+	lea	32(KEY), KEY
+	subl	<$>32, XREG(LENGTH)
+	ja	$1
+>)
+
+C HSUM2(ya, yb)
+C Sums the lanes of ya and yb, leaving [sum(ya), sum(yb)] in XT0
+define(<HSUM2>, <
+	vpunpcklqdq $2, $1, T0
+	vpunpckhqdq $2, $1, T1
+	vpaddq	T1, T0, T0
+	vextracti128 <$>1, T0, XT1
+	vpaddq	XT1, XT0, XT0
+>)
+
+	.file "umac-nh-n.asm"
+
+	C umac_nh_n(uint64_t *out, unsigned n, const uint32_t *key,
+	C	    unsigned length, const uint8_t *msg)
+	.text
+	ALIGN(16)
+PROLOGUE(_nettle_umac_nh_n)
+	W64_ENTRY(5, 13)
+	vpxor	Y0, Y0, Y0
+	vpxor	Y1, Y1, Y1
+	vpxor	Y2, Y2, Y2
+	vpxor	Y3, Y3, Y3
+	cmp	$3, ITERS
+	jc	.Loop2
+	je	.Loop3
+
+	NH_LOOP(.Loop4, 4)
+	HSUM2(Y2, Y3)
+	vmovdqu	XT0, 16(OUT)
+	jmp	.Lend
+
+	NH_LOOP(.Loop3, 3)
+	HSUM2(Y2, Y3)
+	vmovq	XT0, 16(OUT)
+	jmp	.Lend
+
+	NH_LOOP(.Loop2, 2)
+
+.Lend:
+	HSUM2(Y0, Y1)
+	vmovdqu	XT0, (OUT)
+	vzeroupper
+	W64_EXIT(5, 13)
+	ret
+EPILOGUE(_nettle_umac_nh_n)
@@ -0,0 +1,203 @@
+C x86_64/blake2s-compress.asm
+
+ifelse(<
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+>)
+
+	.file "blake2s-compress.asm"
+
+define(<STATE>, <%rdi>)
+define(<BLOCK>, <%rsi>)
+define(<T>, <%rdx>)
+define(<F>, <%ecx>)
+
+C Rows of the working state
+define(<XA>, <%xmm0>)
+define(<XB>, <%xmm1>)
+define(<XC>, <%xmm2>)
+define(<XD>, <%xmm3>)
+define(<M0>, <%xmm4>)
+define(<M1>, <%xmm5>)
+define(<M2>, <%xmm6>)
+define(<M3>, <%xmm7>)
+define(<T0>, <%xmm8>)
+define(<T1>, <%xmm9>)
+
+C LOAD_MSG(M, i0, i1, i2, i3)
+C Collects message words i0, ..., i3 into M.
+define(<LOAD_MSG>, <
+	movd	eval(4*$2)(BLOCK), $1
+	movd	eval(4*$3)(BLOCK), T0
+	punpckldq	T0, $1
+	movd	eval(4*$4)(BLOCK), T1
+	movd	eval(4*$5)(BLOCK), T0
+	punpckldq	T0, T1
+	punpcklqdq	T1, $1
+>)
+
+C ROTR(REG, COUNT)
+define(<ROTR>, <
+	movdqa	$1, T0
+	psrld	<$>$2, $1
+	pslld	<$>eval(32 - $2), T0
+	por	T0, $1
+>)
+
+C G(X, Y), four G functions in parallel, one per column
+define(<G>, <
+	paddd	$1, XA
+	paddd	XB, XA
+	pxor	XA, XD
+	pshuflw	<$>0xb1, XD, XD
+	pshufhw	<$>0xb1, XD, XD
+	paddd	XD, XC
+	pxor	XC, XB
+	ROTR(XB, 12)
+	paddd	$2, XA
+	paddd	XB, XA
+	pxor	XA, XD
+	ROTR(XD, 8)
+	paddd	XD, XC
+	pxor	XC, XB
+	ROTR(XB, 7)
+>)
+
+C ROUND, with the message words in M0, ..., M3. Rotating the rows
+C moves the diagonals into columns, and back again.
+define(<ROUND>, <
+	G(M0, M1)
+	pshufd	<$>0x39, XB, XB
+	pshufd	<$>0x4e, XC, XC
+	pshufd	<$>0x93, XD, XD
+	G(M2, M3)
+	pshufd	<$>0x93, XB, XB
+	pshufd	<$>0x4e, XC, XC
+	pshufd	<$>0x39, XD, XD
+>)
+
+	C _blake2s_compress(uint32_t *state, const uint8_t *block,
+	C                   uint64_t t, uint32_t f)
+
+	.text
+	ALIGN(16)
+.Liv:
+	.long	0x6A09E667, 0xBB67AE85, 0x3C6EF372, 0xA54FF53A
+	.long	0x510E527F, 0x9B05688C, 0x1F83D9AB, 0x5BE0CD19
+PROLOGUE(_nettle_blake2s_compress)
+	W64_ENTRY(4, 10)
+	movups	(STATE), XA
+	movups	16(STATE), XB
+	movdqa	.Liv(%rip), XC
+	movq	T, XD
+	movd	F, T0
+	punpcklqdq	T0, XD
+	pxor	.Liv+16(%rip), XD
+
+	C Round 0
+	LOAD_MSG(M0, 0, 2, 4, 6)
+	LOAD_MSG(M1, 1, 3, 5, 7)
+	LOAD_MSG(M2, 8, 10, 12, 14)
+	LOAD_MSG(M3, 9, 11, 13, 15)
+	ROUND
+
+	C Round 1
+	LOAD_MSG(M0, 14, 4, 9, 13)
+	LOAD_MSG(M1, 10, 8, 15, 6)
+	LOAD_MSG(M2, 1, 0, 11, 5)
+	LOAD_MSG(M3, 12, 2, 7, 3)
+	ROUND
+
+	C Round 2
+	LOAD_MSG(M0, 11, 12, 5, 15)
+	LOAD_MSG(M1, 8, 0, 2, 13)
+	LOAD_MSG(M2, 10, 3, 7, 9)
+	LOAD_MSG(M3, 14, 6, 1, 4)
+	ROUND
+
+	C Round 3
+	LOAD_MSG(M0, 7, 3, 13, 11)
+	LOAD_MSG(M1, 9, 1, 12, 14)
+	LOAD_MSG(M2, 2, 5, 4, 15)
+	LOAD_MSG(M3, 6, 10, 0, 8)
+	ROUND
+
+	C Round 4
+	LOAD_MSG(M0, 9, 5, 2, 10)
+	LOAD_MSG(M1, 0, 7, 4, 15)
+	LOAD_MSG(M2, 14, 11, 6, 3)
+	LOAD_MSG(M3, 1, 12, 8, 13)
+	ROUND
+
+	C Round 5
+	LOAD_MSG(M0, 2, 6, 0, 8)
+	LOAD_MSG(M1, 12, 10, 11, 3)
+	LOAD_MSG(M2, 4, 7, 15, 1)
+	LOAD_MSG(M3, 13, 5, 14, 9)
+	ROUND
+
+	C Round 6
+	LOAD_MSG(M0, 12, 1, 14, 4)
+	LOAD_MSG(M1, 5, 15, 13, 10)
+	LOAD_MSG(M2, 0, 6, 9, 8)
+	LOAD_MSG(M3, 7, 3, 2, 11)
+	ROUND
+
+	C Round 7
+	LOAD_MSG(M0, 13, 7, 12, 3)
+	LOAD_MSG(M1, 11, 14, 1, 9)
+	LOAD_MSG(M2, 5, 15, 8, 2)
+	LOAD_MSG(M3, 0, 4, 6, 10)
+	ROUND
+
+	C Round 8
+	LOAD_MSG(M0, 6, 14, 11, 0)
+	LOAD_MSG(M1, 15, 9, 3, 8)
+	LOAD_MSG(M2, 12, 13, 1, 10)
+	LOAD_MSG(M3, 2, 7, 4, 5)
+	ROUND
+
+	C Round 9
+	LOAD_MSG(M0, 10, 8, 7, 1)
+	LOAD_MSG(M1, 2, 4, 6, 5)
+	LOAD_MSG(M2, 15, 9, 3, 13)
+	LOAD_MSG(M3, 11, 14, 12, 0)
+	ROUND
+
+	movups	(STATE), T0
+	pxor	XC, XA
+	pxor	T0, XA
+	movups	XA, (STATE)
+	movups	16(STATE), T0
+	pxor	XD, XB
+	pxor	T0, XB
+	movups	XB, 16(STATE)
+
+	W64_EXIT(4, 10)
+	ret
+EPILOGUE(_nettle_blake2s_compress)
@@ -57,3 +57,17 @@ PROLOGUE(_nettle_cpuid)
 	ret
 EPILOGUE(_nettle_cpuid)
 
+
+	C uint64_t _nettle_xgetbv(uint32_t xcr)
+
+	ALIGN(16)
+PROLOGUE(_nettle_xgetbv)
+	W64_ENTRY(1)
+	movl	%edi, %ecx
+	xgetbv
+	shl	$32, %rdx
+	mov	%eax, %eax
+	or	%rdx, %rax
+	W64_EXIT(1)
+	ret
+EPILOGUE(_nettle_xgetbv)
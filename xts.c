@@ -0,0 +1,243 @@
+/* xts.c
+
+   XEX-based tweaked-codebook mode with ciphertext stealing,
+   IEEE P1619
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <string.h>
+
+#include "xts.h"
+
+#include "macros.h"
+#include "memxor.h"
+
+/* Number of blocks passed to the cipher in a single call. */
+#define XTS_BATCH 8
+
+#define MIN(x,y) ((x)<(y)?(x):(y))
+
+/* Multiplication by x in GF(2^128), with the same polynomial as
+   GCM, but using the little-endian bit order of IEEE P1619. */
+static void
+xts_shift (union nettle_block16 *dst, const union nettle_block16 *src)
+{
+#if WORDS_BIGENDIAN
+  uint64_t lo = LE_READ_UINT64 (src->b);
+  uint64_t hi = LE_READ_UINT64 (src->b + 8);
+  uint64_t carry = hi >> 63;
+  hi = (hi << 1) | (lo >> 63);
+  lo = (lo << 1) ^ (-carry & 0x87);
+  LE_WRITE_UINT64 (dst->b, lo);
+  LE_WRITE_UINT64 (dst->b + 8, hi);
+#else /* !WORDS_BIGENDIAN */
+  uint64_t carry = src->u64[1] >> 63;
+  dst->u64[1] = (src->u64[1] << 1) | (src->u64[0] >> 63);
+  dst->u64[0] = (src->u64[0] << 1) ^ (-carry & 0x87);
+#endif /* !WORDS_BIGENDIAN */
+}
+
+/* Processes n complete blocks, computing up to XTS_BATCH tweaks at a
+   time, so that the cipher sees several independent blocks per
+   call. On return, t holds the tweak for the next block. */
+static void
+xts_crypt_blocks (const void *ctx, nettle_cipher_func *f,
+		  union nettle_block16 *t,
+		  size_t n, uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 tweaks[XTS_BATCH];
+  union nettle_block16 buffer[XTS_BATCH];
+
+  while (n > 0)
+    {
+      size_t blocks = MIN (n, XTS_BATCH);
+      size_t size = blocks * XTS_BLOCK_SIZE;
+      size_t i;
+
+      tweaks[0] = *t;
+      for (i = 1; i < blocks; i++)
+	xts_shift (&tweaks[i], &tweaks[i-1]);
+      xts_shift (t, &tweaks[blocks-1]);
+
+      memxor3 (buffer[0].b, src, tweaks[0].b, size);
+      f (ctx, size, buffer[0].b, buffer[0].b);
+      memxor3 (dst, buffer[0].b, tweaks[0].b, size);
+
+      n -= blocks;
+      src += size;
+      dst += size;
+    }
+}
+
+static void
+xts_crypt_block (const void *ctx, nettle_cipher_func *f,
+		 const union nettle_block16 *tweak,
+		 uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 block;
+  memxor3 (block.b, src, tweak->b, XTS_BLOCK_SIZE);
+  f (ctx, XTS_BLOCK_SIZE, block.b, block.b);
+  memxor3 (dst, block.b, tweak->b, XTS_BLOCK_SIZE);
+}
+
+void
+xts_encrypt_message(const void *enc_ctx, const void *twk_ctx,
+		    nettle_cipher_func *encf,
+		    const uint8_t *tweak, size_t length,
+		    uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 t;
+  size_t blocks = length / XTS_BLOCK_SIZE;
+  size_t left = length % XTS_BLOCK_SIZE;
+
+  assert (length >= XTS_BLOCK_SIZE);
+
+  encf (twk_ctx, XTS_BLOCK_SIZE, t.b, tweak);
+
+  if (!left)
+    {
+      xts_crypt_blocks (enc_ctx, encf, &t, blocks, dst, src);
+      return;
+    }
+
+  xts_crypt_blocks (enc_ctx, encf, &t, blocks - 1, dst, src);
+  src += (blocks - 1) * XTS_BLOCK_SIZE;
+  dst += (blocks - 1) * XTS_BLOCK_SIZE;
+
+  /* Ciphertext stealing. The last complete block is encrypted with
+     the current tweak, and the final, partial, block is padded with
+     the tail of that ciphertext and encrypted with the next one. */
+  {
+    union nettle_block16 t1;
+    uint8_t cc[XTS_BLOCK_SIZE];
+    uint8_t pp[XTS_BLOCK_SIZE];
+
+    xts_shift (&t1, &t);
+
+    xts_crypt_block (enc_ctx, encf, &t, cc, src);
+    memcpy (pp, src + XTS_BLOCK_SIZE, left);
+    memcpy (pp + left, cc + left, XTS_BLOCK_SIZE - left);
+    memcpy (dst + XTS_BLOCK_SIZE, cc, left);
+    xts_crypt_block (enc_ctx, encf, &t1, dst, pp);
+  }
+}
+
+void
+xts_decrypt_message(const void *dec_ctx, const void *twk_ctx,
+		    nettle_cipher_func *decf, nettle_cipher_func *encf,
+		    const uint8_t *tweak, size_t length,
+		    uint8_t *dst, const uint8_t *src)
+{
+  union nettle_block16 t;
+  size_t blocks = length / XTS_BLOCK_SIZE;
+  size_t left = length % XTS_BLOCK_SIZE;
+
+  assert (length >= XTS_BLOCK_SIZE);
+
+  encf (twk_ctx, XTS_BLOCK_SIZE, t.b, tweak);
+
+  if (!left)
+    {
+      xts_crypt_blocks (dec_ctx, decf, &t, blocks, dst, src);
+      return;
+    }
+
+  xts_crypt_blocks (dec_ctx, decf, &t, blocks - 1, dst, src);
+  src += (blocks - 1) * XTS_BLOCK_SIZE;
+  dst += (blocks - 1) * XTS_BLOCK_SIZE;
+
+  /* Ciphertext stealing, with the two last tweaks used in the
+     opposite order. */
+  {
+    union nettle_block16 t1;
+    uint8_t cc[XTS_BLOCK_SIZE];
+    uint8_t pp[XTS_BLOCK_SIZE];
+
+    xts_shift (&t1, &t);
+
+    xts_crypt_block (dec_ctx, decf, &t1, pp, src);
+    memcpy (cc, src + XTS_BLOCK_SIZE, left);
+    memcpy (cc + left, pp + left, XTS_BLOCK_SIZE - left);
+    memcpy (dst + XTS_BLOCK_SIZE, pp, left);
+    xts_crypt_block (dec_ctx, decf, &t, dst, cc);
+  }
+}
+
+static void
+xts_sector_tweak (uint8_t *tweak, uint64_t sector)
+{
+  LE_WRITE_UINT64 (tweak, sector);
+  memset (tweak + 8, 0, XTS_BLOCK_SIZE - 8);
+}
+
+void
+xts_encrypt_sectors(const void *enc_ctx, const void *twk_ctx,
+		    nettle_cipher_func *encf,
+		    size_t sector_size, uint64_t sector, size_t length,
+		    uint8_t *dst, const uint8_t *src)
+{
+  uint8_t tweak[XTS_BLOCK_SIZE];
+
+  assert (sector_size >= XTS_BLOCK_SIZE);
+  assert (length % sector_size == 0);
+
+  for (; length > 0;
+       length -= sector_size, src += sector_size, dst += sector_size)
+    {
+      xts_sector_tweak (tweak, sector++);
+      xts_encrypt_message (enc_ctx, twk_ctx, encf,
+			   tweak, sector_size, dst, src);
+    }
+}
+
+void
+xts_decrypt_sectors(const void *dec_ctx, const void *twk_ctx,
+		    nettle_cipher_func *decf, nettle_cipher_func *encf,
+		    size_t sector_size, uint64_t sector, size_t length,
+		    uint8_t *dst, const uint8_t *src)
+{
+  uint8_t tweak[XTS_BLOCK_SIZE];
+
+  assert (sector_size >= XTS_BLOCK_SIZE);
+  assert (length % sector_size == 0);
+
+  for (; length > 0;
+       length -= sector_size, src += sector_size, dst += sector_size)
+    {
+      xts_sector_tweak (tweak, sector++);
+      xts_decrypt_message (dec_ctx, twk_ctx, decf, encf,
+			   tweak, sector_size, dst, src);
+    }
+}
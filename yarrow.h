@@ -50,6 +50,10 @@ extern "C" {
 #define yarrow256_needed_sources nettle_yarrow256_needed_sources
 #define yarrow256_fast_reseed nettle_yarrow256_fast_reseed
 #define yarrow256_slow_reseed nettle_yarrow256_slow_reseed
+#define yarrow256_local_init nettle_yarrow256_local_init
+#define yarrow256_local_seed nettle_yarrow256_local_seed
+#define yarrow256_local_random nettle_yarrow256_local_random
+#define yarrow256_local_clear nettle_yarrow256_local_clear
 #define yarrow_key_event_init nettle_yarrow_key_event_init
 #define yarrow_key_event_estimate nettle_yarrow_key_event_estimate
 
@@ -120,6 +124,42 @@ void
 yarrow256_slow_reseed(struct yarrow256_ctx *ctx);
 
 
+/* Per-thread generator, keyed from a shared yarrow256_ctx and fresh
+   entropy from the operating system. Output is AES-256 in counter
+   mode, generated a buffer at a time, and the key is replaced after
+   each refill. */
+#define YARROW256_LOCAL_BUFFER_SIZE (16 * AES_BLOCK_SIZE)
+
+struct yarrow256_local_ctx
+{
+  int seeded;
+  /* Process id at seeding, to detect use after fork. */
+  long pid;
+
+  struct aes256_ctx key;
+  uint8_t counter[AES_BLOCK_SIZE];
+
+  /* Unused output is buffer[index ... YARROW256_LOCAL_BUFFER_SIZE - 1] */
+  unsigned index;
+  uint8_t buffer[YARROW256_LOCAL_BUFFER_SIZE];
+};
+
+void
+yarrow256_local_init(struct yarrow256_local_ctx *ctx);
+
+int
+yarrow256_local_seed(struct yarrow256_local_ctx *ctx,
+		     struct yarrow256_ctx *shared,
+		     size_t length, const uint8_t *data);
+
+void
+yarrow256_local_random(struct yarrow256_local_ctx *ctx,
+		       size_t length, uint8_t *dst);
+
+void
+yarrow256_local_clear(struct yarrow256_local_ctx *ctx);
+
+
 /* Key event estimator */
 #define YARROW_KEY_EVENT_BUFFER 16
 
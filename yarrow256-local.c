@@ -0,0 +1,240 @@
+/* yarrow256-local.c
+
+   Per-thread generator keyed from a shared Yarrow-256 context.
+
+   Copyright (C) 2026 agent
+
+   This file is part of GNU Nettle.
+
+   GNU Nettle is free software: you can redistribute it and/or
+   modify it under the terms of either:
+
+     * the GNU Lesser General Public License as published by the Free
+       Software Foundation; either version 3 of the License, or (at your
+       option) any later version.
+
+   or
+
+     * the GNU General Public License as published by the Free
+       Software Foundation; either version 2 of the License, or (at your
+       option) any later version.
+
+   or both in parallel, as here.
+
+   GNU Nettle is distributed in the hope that it will be useful,
+   but WITHOUT ANY WARRANTY; without even the implied warranty of
+   MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+   General Public License for more details.
+
+   You should have received copies of the GNU General Public License and
+   the GNU Lesser General Public License along with this program.  If
+   not, see http://www.gnu.org/licenses/.
+*/
+
+
+#if HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <assert.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if HAVE_UNISTD_H
+# include <unistd.h>
+#endif
+#if HAVE_SYS_RANDOM_H
+# include <sys/random.h>
+#endif
+
+#include "yarrow.h"
+
+#include "macros.h"
+
+#if HAVE_UNISTD_H
+# define LOCAL_PID() ((long) getpid())
+#else
+# define LOCAL_PID() 0L
+#endif
+
+/* Reads fresh entropy from the operating system. Returns 1 on
+   success, 0 on failure. */
+static int
+local_os_entropy(size_t length, uint8_t *dst)
+{
+  int fd;
+
+#if HAVE_GETRANDOM
+  while (length > 0)
+    {
+      ssize_t res = getrandom(dst, length, 0);
+      if (res < 0)
+	{
+	  if (errno == EINTR)
+	    continue;
+	  if (errno == ENOSYS)
+	    break;
+	  return 0;
+	}
+      dst += res;
+      length -= res;
+    }
+  if (!length)
+    return 1;
+#endif
+
+  fd = open("/dev/urandom", O_RDONLY);
+  if (fd < 0)
+    return 0;
+
+  while (length > 0)
+    {
+      ssize_t res = read(fd, dst, length);
+      if (res <= 0)
+	{
+	  if (res < 0 && errno == EINTR)
+	    continue;
+	  close(fd);
+	  return 0;
+	}
+      dst += res;
+      length -= res;
+    }
+  close(fd);
+  return 1;
+}
+
+/* Generates n blocks of counter mode output with a single call to
+   aes256_encrypt. */
+static void
+local_generate_blocks(struct yarrow256_local_ctx *ctx,
+		      size_t n, uint8_t *dst)
+{
+  size_t i;
+
+  for (i = 0; i < n; i++)
+    {
+      memcpy (dst + i * AES_BLOCK_SIZE, ctx->counter, AES_BLOCK_SIZE);
+      INCREMENT (sizeof(ctx->counter), ctx->counter);
+    }
+  aes256_encrypt(&ctx->key, n * AES_BLOCK_SIZE, dst, dst);
+}
+
+/* Replaces the key with fresh output, so that earlier output can't be
+   recomputed from the state. */
+static void
+local_rekey(struct yarrow256_local_ctx *ctx)
+{
+  uint8_t key[AES256_KEY_SIZE];
+
+  local_generate_blocks(ctx, sizeof(key) / AES_BLOCK_SIZE, key);
+  aes256_set_encrypt_key(&ctx->key, key);
+  memset(key, 0, sizeof(key));
+}
+
+void
+yarrow256_local_init(struct yarrow256_local_ctx *ctx)
+{
+  memset(ctx, 0, sizeof(*ctx));
+  ctx->seeded = 0;
+  ctx->index = YARROW256_LOCAL_BUFFER_SIZE;
+}
+
+int
+yarrow256_local_seed(struct yarrow256_local_ctx *ctx,
+		     struct yarrow256_ctx *shared,
+		     size_t length, const uint8_t *data)
+{
+  struct sha256_ctx hash;
+  uint8_t key[AES256_KEY_SIZE];
+  uint8_t fresh[AES256_KEY_SIZE];
+
+  assert(AES256_KEY_SIZE == SHA256_DIGEST_SIZE);
+
+  /* Copies of the shared generator, e.g., in the two processes after
+     a fork, give the same output, so it is not enough on its own. */
+  if (!local_os_entropy(sizeof(fresh), fresh))
+    return 0;
+
+  /* The new key is the hash of fresh output from the shared
+     generator, the entropy, and the caller's data. */
+  yarrow256_random(shared, sizeof(key), key);
+
+  sha256_init(&hash);
+  sha256_update(&hash, sizeof(key), key);
+  sha256_update(&hash, sizeof(fresh), fresh);
+  sha256_update(&hash, length, data);
+  sha256_digest(&hash, sizeof(key), key);
+
+  aes256_set_encrypt_key(&ctx->key, key);
+  memset(ctx->counter, 0, sizeof(ctx->counter));
+
+  /* Discard any buffered output from the old key. */
+  memset(ctx->buffer, 0, sizeof(ctx->buffer));
+  ctx->index = YARROW256_LOCAL_BUFFER_SIZE;
+  ctx->seeded = 1;
+  ctx->pid = LOCAL_PID();
+
+  memset(key, 0, sizeof(key));
+  memset(fresh, 0, sizeof(fresh));
+  memset(&hash, 0, sizeof(hash));
+
+  return 1;
+}
+
+void
+yarrow256_local_random(struct yarrow256_local_ctx *ctx,
+		       size_t length, uint8_t *dst)
+{
+  assert(ctx->seeded);
+
+  /* After a fork, the child has the parent's state and would repeat
+     its output. Refuse until the child seeds the generator. */
+  if (ctx->pid != LOCAL_PID())
+    abort();
+
+  for (;;)
+    {
+      unsigned left = YARROW256_LOCAL_BUFFER_SIZE - ctx->index;
+      if (length <= left)
+	{
+	  memcpy(dst, ctx->buffer + ctx->index, length);
+	  memset(ctx->buffer + ctx->index, 0, length);
+	  ctx->index += length;
+	  return;
+	}
+      memcpy(dst, ctx->buffer + ctx->index, left);
+      memset(ctx->buffer + ctx->index, 0, left);
+      dst += left;
+      length -= left;
+
+      if (length >= YARROW256_LOCAL_BUFFER_SIZE)
+	{
+	  /* Large requests bypass the buffer. */
+	  size_t blocks = length / AES_BLOCK_SIZE;
+	  local_generate_blocks(ctx, blocks, dst);
+	  local_rekey(ctx);
+
+	  dst += blocks * AES_BLOCK_SIZE;
+	  length -= blocks * AES_BLOCK_SIZE;
+	  ctx->index = YARROW256_LOCAL_BUFFER_SIZE;
+	}
+      else
+	{
+	  local_generate_blocks(ctx,
+				YARROW256_LOCAL_BUFFER_SIZE / AES_BLOCK_SIZE,
+				ctx->buffer);
+	  local_rekey(ctx);
+	  ctx->index = 0;
+	}
+    }
+}
+
+void
+yarrow256_local_clear(struct yarrow256_local_ctx *ctx)
+{
+  /* Erases all key material and buffered output. */
+  yarrow256_local_init(ctx);
+}
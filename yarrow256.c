@@ -118,28 +118,24 @@ yarrow256_seed(struct yarrow256_ctx *ctx,
   yarrow256_fast_reseed(ctx);
 }
 
-/* FIXME: Generalize so that it generates a few more blocks at a
- * time. */
+/* Generates n blocks of output, using the key in counter mode. All
+ * counter values are written to the output area first, so that the
+ * blocks are encrypted with a single call to aes256_encrypt. */
 static void
-yarrow_generate_block(struct yarrow256_ctx *ctx,
-		      uint8_t *block)
+yarrow_generate_blocks(struct yarrow256_ctx *ctx,
+		       size_t n, uint8_t *dst)
 {
-  unsigned i;
-
-  aes256_encrypt(&ctx->key, sizeof(ctx->counter), block, ctx->counter);
+  size_t i;
 
-  /* Increment counter, treating it as a big-endian number. This is
-   * machine independent, and follows appendix B of the NIST
-   * specification of cipher modes of operation.
-   *
-   * We could keep a representation of the counter as 4 32-bit values,
-   * and write entire words (in big-endian byteorder) into the counter
-   * block, whenever they change. */
-  for (i = sizeof(ctx->counter); i--; )
+  for (i = 0; i < n; i++)
     {
-      if (++ctx->counter[i])
-	break;
+      memcpy (dst + i * AES_BLOCK_SIZE, ctx->counter, AES_BLOCK_SIZE);
+      /* Increment counter, treating it as a big-endian number. This
+       * is machine independent, and follows appendix B of the NIST
+       * specification of cipher modes of operation. */
+      INCREMENT (sizeof(ctx->counter), ctx->counter);
     }
+  aes256_encrypt(&ctx->key, n * AES_BLOCK_SIZE, dst, dst);
 }
 
 static void
@@ -188,8 +184,7 @@ yarrow256_fast_reseed(struct yarrow256_ctx *ctx)
     {
       uint8_t blocks[AES_BLOCK_SIZE * 2];
       
-      yarrow_generate_block(ctx, blocks);
-      yarrow_generate_block(ctx, blocks + AES_BLOCK_SIZE);
+      yarrow_generate_blocks(ctx, 2, blocks);
       sha256_update(&ctx->pools[YARROW_FAST], sizeof(blocks), blocks);
     }
   
@@ -314,10 +309,8 @@ static void
 yarrow_gate(struct yarrow256_ctx *ctx)
 {
   uint8_t key[AES256_KEY_SIZE];
-  unsigned i;
 
-  for (i = 0; i < sizeof(key); i+= AES_BLOCK_SIZE)
-    yarrow_generate_block(ctx, key + i);
+  yarrow_generate_blocks(ctx, sizeof(key) / AES_BLOCK_SIZE, key);
 
   aes256_set_encrypt_key(&ctx->key, key);
 }
@@ -327,18 +320,19 @@ yarrow256_random(struct yarrow256_ctx *ctx, size_t length, uint8_t *dst)
 {
   assert(ctx->seeded);
 
-  while (length >= AES_BLOCK_SIZE)
+  if (length >= AES_BLOCK_SIZE)
     {
-      yarrow_generate_block(ctx, dst);
-      dst += AES_BLOCK_SIZE;
-      length -= AES_BLOCK_SIZE;
+      size_t blocks = length / AES_BLOCK_SIZE;
+      yarrow_generate_blocks(ctx, blocks, dst);
+      dst += blocks * AES_BLOCK_SIZE;
+      length -= blocks * AES_BLOCK_SIZE;
     }
   if (length)
     {
       uint8_t buffer[AES_BLOCK_SIZE];
       
       assert(length < AES_BLOCK_SIZE);
-      yarrow_generate_block(ctx, buffer);
+      yarrow_generate_blocks(ctx, 1, buffer);
       memcpy(dst, buffer, length);
     }
   yarrow_gate(ctx);